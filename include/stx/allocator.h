@@ -6,6 +6,7 @@
 
 #include "stx/config.h"
 #include "stx/enum.h"
+#include "stx/relocate.h"
 
 STX_BEGIN_NAMESPACE
 
@@ -216,6 +217,8 @@ struct Allocator
   constexpr Allocator(Allocator const &)                 = default;
   constexpr Allocator &operator=(Allocator const &other) = default;
 
+  STX_MARK_TRIVIALLY_RELOCATABLE(Allocator)
+
   AllocatorHandle *handle;
 };
 
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "stx/config.h"
+#include "stx/span.h"
+
+#if STX_CFG(SIMD, SSE2)
+#  include <emmintrin.h>
+#elif STX_CFG(SIMD, NEON)
+#  include <arm_neon.h>
+#endif
+
+STX_BEGIN_NAMESPACE
+
+// ASCII case mapping and case-insensitive comparison.
+//
+// only the bytes 'A'-'Z' and 'a'-'z' are mapped, all other bytes (including
+// non-ASCII UTF-8 bytes) are left unchanged, independent of the C locale. the
+// bulk functions process 16 bytes at a time with SSE2 or NEON.
+namespace ascii
+{
+
+constexpr char to_lower(char c)
+{
+  return static_cast<unsigned char>(c - 'A') < 26 ? static_cast<char>(c | 0x20) : c;
+}
+
+constexpr char to_upper(char c)
+{
+  return static_cast<unsigned char>(c - 'a') < 26 ? static_cast<char>(c & ~0x20) : c;
+}
+
+namespace impl
+{
+
+#if STX_CFG(SIMD, SSE2)
+
+// flips the case bit of the bytes in [`first`, `first` + 26)
+inline __m128i flip_case_in_range(__m128i chars, char first)
+{
+  // shift the range to the bottom of the signed range so a single signed
+  // comparison tests both bounds
+  __m128i const shifted  = _mm_sub_epi8(chars, _mm_set1_epi8(static_cast<char>(first + 128)));
+  __m128i const in_range = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + 26)));
+
+  return _mm_xor_si128(chars, _mm_and_si128(in_range, _mm_set1_epi8(0x20)));
+}
+
+#elif STX_CFG(SIMD, NEON)
+
+inline uint8x16_t flip_case_in_range(uint8x16_t chars, char first)
+{
+  uint8x16_t const in_range = vcltq_u8(vsubq_u8(chars, vdupq_n_u8(static_cast<uint8_t>(first))), vdupq_n_u8(26));
+
+  return veorq_u8(chars, vandq_u8(in_range, vdupq_n_u8(0x20)));
+}
+
+#endif
+
+// maps the bytes of `src` with the case bit flipped for the bytes in
+// [`first`, `first` + 26) into `dst`
+inline void flip_case(char const *src, size_t size, char *dst, char first)
+{
+  size_t i = 0;
+
+#if STX_CFG(SIMD, SSE2)
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i const chars = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), flip_case_in_range(chars, first));
+  }
+#elif STX_CFG(SIMD, NEON)
+  for (; i + 16 <= size; i += 16)
+  {
+    uint8x16_t const chars = vld1q_u8(reinterpret_cast<uint8_t const *>(src + i));
+    vst1q_u8(reinterpret_cast<uint8_t *>(dst + i), flip_case_in_range(chars, first));
+  }
+#endif
+
+  for (; i < size; i++)
+  {
+    char const c = src[i];
+    dst[i]       = static_cast<unsigned char>(c - first) < 26 ? static_cast<char>(c ^ 0x20) : c;
+  }
+}
+
+}        // namespace impl
+
+// writes the lowercase of `src` into `dst`, which must be at least as large.
+// `dst` may be `src`.
+inline void to_lower(Span<char const> src, Span<char> dst)
+{
+  STX_SPAN_ENSURE(dst.size() >= src.size(), "destination span is too small");
+  impl::flip_case(src.data(), src.size(), dst.data(), 'A');
+}
+
+// writes the uppercase of `src` into `dst`, which must be at least as large.
+// `dst` may be `src`.
+inline void to_upper(Span<char const> src, Span<char> dst)
+{
+  STX_SPAN_ENSURE(dst.size() >= src.size(), "destination span is too small");
+  impl::flip_case(src.data(), src.size(), dst.data(), 'a');
+}
+
+inline bool equal_ignore_case(std::string_view a, std::string_view b)
+{
+  if (a.size() != b.size())
+  {
+    return false;
+  }
+
+  size_t const size = a.size();
+  size_t       i    = 0;
+
+#if STX_CFG(SIMD, SSE2)
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i const a_lower = impl::flip_case_in_range(_mm_loadu_si128(reinterpret_cast<__m128i const *>(a.data() + i)), 'A');
+    __m128i const b_lower = impl::flip_case_in_range(_mm_loadu_si128(reinterpret_cast<__m128i const *>(b.data() + i)), 'A');
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(a_lower, b_lower)) != 0xFFFF)
+    {
+      return false;
+    }
+  }
+#elif STX_CFG(SIMD, NEON)
+  for (; i + 16 <= size; i += 16)
+  {
+    uint8x16_t const a_lower = impl::flip_case_in_range(vld1q_u8(reinterpret_cast<uint8_t const *>(a.data() + i)), 'A');
+    uint8x16_t const b_lower = impl::flip_case_in_range(vld1q_u8(reinterpret_cast<uint8_t const *>(b.data() + i)), 'A');
+
+    uint64x2_t const equal = vreinterpretq_u64_u8(vceqq_u8(a_lower, b_lower));
+
+    if ((vgetq_lane_u64(equal, 0) & vgetq_lane_u64(equal, 1)) != ~uint64_t{0})
+    {
+      return false;
+    }
+  }
+#endif
+
+  for (; i < size; i++)
+  {
+    if (to_lower(a[i]) != to_lower(b[i]))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}        // namespace ascii
+
+STX_END_NAMESPACE
@@ -12,6 +12,7 @@
 #include "stx/limits.h"
 #include "stx/panic/report.h"
 #include "stx/rc.h"
+#include "stx/relocate.h"
 #include "stx/result.h"
 #include "stx/spinlock.h"
 #include "stx/struct.h"
@@ -733,6 +734,7 @@ template <typename T>
 struct FutureBase
 {
   STX_DISABLE_DEFAULT_CONSTRUCTOR(FutureBase)
+  STX_MARK_TRIVIALLY_RELOCATABLE(FutureBase)
 
   explicit FutureBase(Rc<FutureState<T> *> init_state) :
       state{std::move(init_state)}
@@ -786,6 +788,7 @@ struct Future : public FutureBase<T>
   using Base = FutureBase<T>;
 
   STX_DISABLE_DEFAULT_CONSTRUCTOR(Future)
+  STX_MARK_TRIVIALLY_RELOCATABLE(Future)
 
   explicit Future(Rc<FutureState<T> *> init_state) :
       Base{std::move(init_state)}
@@ -828,6 +831,7 @@ struct Future<void> : public FutureBase<void>
   using Base = FutureBase<void>;
 
   STX_DISABLE_DEFAULT_CONSTRUCTOR(Future)
+  STX_MARK_TRIVIALLY_RELOCATABLE(Future)
 
   explicit Future(Rc<FutureState<void> *> init_state) :
       Base{std::move(init_state)}
@@ -837,6 +841,7 @@ struct Future<void> : public FutureBase<void>
 struct FutureAny
 {
   STX_DISABLE_DEFAULT_CONSTRUCTOR(FutureAny)
+  STX_MARK_TRIVIALLY_RELOCATABLE(FutureAny)
 
   template <typename T>
   explicit FutureAny(Future<T> future) :
@@ -884,6 +889,7 @@ template <typename T>
 struct PromiseBase
 {
   STX_DISABLE_DEFAULT_CONSTRUCTOR(PromiseBase)
+  STX_MARK_TRIVIALLY_RELOCATABLE(PromiseBase)
 
   explicit PromiseBase(Rc<FutureState<T> *> init_state) :
       state{std::move(init_state)}
@@ -998,6 +1004,7 @@ struct Promise : public PromiseBase<T>
   using Base = PromiseBase<T>;
 
   STX_DISABLE_DEFAULT_CONSTRUCTOR(Promise)
+  STX_MARK_TRIVIALLY_RELOCATABLE(Promise)
 
   explicit Promise(Rc<FutureState<T> *> init_state) :
       Base{std::move(init_state)}
@@ -1020,6 +1027,7 @@ struct Promise<void> : public PromiseBase<void>
   using Base = PromiseBase<void>;
 
   STX_DISABLE_DEFAULT_CONSTRUCTOR(Promise)
+  STX_MARK_TRIVIALLY_RELOCATABLE(Promise)
 
   explicit Promise(Rc<FutureState<void> *> init_state) :
       Base{std::move(init_state)}
@@ -1039,6 +1047,7 @@ struct Promise<void> : public PromiseBase<void>
 struct PromiseAny
 {
   STX_DISABLE_DEFAULT_CONSTRUCTOR(PromiseAny)
+  STX_MARK_TRIVIALLY_RELOCATABLE(PromiseAny)
 
   template <typename T>
   explicit PromiseAny(Promise<T> promise) :
@@ -1160,6 +1169,7 @@ struct PromiseAny
 struct RequestProxy
 {
   STX_DISABLE_DEFAULT_CONSTRUCTOR(RequestProxy)
+  STX_MARK_TRIVIALLY_RELOCATABLE(RequestProxy)
 
   template <typename T>
   explicit RequestProxy(Promise<T> const &promise) :
@@ -0,0 +1,642 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/string.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+enum class [[nodiscard]] BinaryError : uint8_t
+{
+  // the input ends before the value does
+  UnexpectedEnd,
+  // the input is not an encoding of the value
+  InvalidData,
+  // the elements of a borrowed span are not aligned in the input
+  Misaligned,
+  // decoding an owned value ran out of memory
+  NoMemory
+};
+
+/// @file
+///
+/// compact binary serialization.
+///
+/// the values are encoded as:
+///
+/// - fixed-layout values (see `is_fixed_layout`): their bytes
+/// - `bool`: a byte, 0 or 1
+/// - strings: the size as a LEB128 varint, then the characters
+/// - `Span`s and `Vec`s: the size as a varint, then the elements.
+///   fixed-layout elements are padded to their alignment and copied in bulk,
+///   so they can be decoded as a `Span` into the input.
+/// - `Option` and `Result`: a tag byte, then the value
+/// - structs: a 32-bit size, then the fields, see `BinaryWriter::write_struct`
+///
+/// strings and spans of fixed-layout elements are decoded as views into the
+/// input without copying. `String`s and `Vec`s are decoded as copies using
+/// the reader's allocator.
+///
+/// the values are encoded in the target's byte order and layout, so the
+/// encodings must only be decoded by the same target.
+///
+/// types are made serializable by specializing `Binary`:
+///
+/// ```cpp
+/// template <>
+/// struct Binary<Request>
+/// {
+///   static Result<Void, AllocError> encode(BinaryWriter &writer, Request const &request)
+///   {
+///     return writer.write_struct(request.path, request.method, request.headers);
+///   }
+///
+///   static Result<Request, BinaryError> decode(BinaryReader &reader)
+///   {
+///     Request request;
+///     TRY_OK(ok, reader.read_struct(request.path, request.method, request.headers));
+///     (void) ok;
+///     return Ok(std::move(request));
+///   }
+/// };
+/// ```
+///
+/// trivially-copyable types can instead be marked fixed-layout by
+/// specializing `is_fixed_layout`.
+///
+template <typename T, typename = void>
+struct Binary;
+
+/// fixed-layout types are encoded as their bytes and copied in bulk.
+/// specialize for trivially-copyable types that don't contain pointers.
+template <typename T>
+struct is_fixed_layout : std::bool_constant<(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) || std::is_enum_v<T>>
+{};
+
+struct BinaryWriter
+{
+  explicit BinaryWriter(Allocator allocator) :
+      buffer_{allocator}
+  {}
+
+  Result<Void, AllocError> write_bytes(void const *data, size_t size)
+  {
+    if (size == 0)
+    {
+      return Ok(Void{});
+    }
+
+    return buffer_.extend(Span<uint8_t const>{static_cast<uint8_t const *>(data), size});
+  }
+
+  // pads the output with zeros to a multiple of `alignment`
+  Result<Void, AllocError> write_padding(size_t alignment)
+  {
+    size_t const padding = (alignment - buffer_.size() % alignment) % alignment;
+
+    if (padding == 0)
+    {
+      return Ok(Void{});
+    }
+
+    return buffer_.resize(buffer_.size() + padding, 0);
+  }
+
+  Result<Void, AllocError> write_varint(uint64_t value)
+  {
+    uint8_t bytes[10];
+    size_t  size = 0;
+
+    while (value >= 0x80)
+    {
+      bytes[size] = static_cast<uint8_t>(value | 0x80);
+      value >>= 7;
+      size++;
+    }
+
+    bytes[size] = static_cast<uint8_t>(value);
+    size++;
+
+    return write_bytes(bytes, size);
+  }
+
+  // encodes the values one after the other
+  template <typename... Args>
+  Result<Void, AllocError> write(Args const &...args)
+  {
+    bool const ok = (Binary<Args>::encode(*this, args).is_ok() && ...);
+
+    if (!ok)
+    {
+      return Err(AllocError::NoMemory);
+    }
+
+    return Ok(Void{});
+  }
+
+  // encodes the fields of a struct, prefixed with their encoded size so
+  // fields can be appended to the struct later. see `BinaryReader::read_struct`.
+  template <typename... Fields>
+  Result<Void, AllocError> write_struct(Fields const &...fields)
+  {
+    size_t const   size_offset = buffer_.size();
+    uint32_t const placeholder = 0;
+
+    TRY_OK(placeholder_ok, write_bytes(&placeholder, sizeof(placeholder)));
+    TRY_OK(fields_ok, write(fields...));
+
+    (void) placeholder_ok;
+    (void) fields_ok;
+
+    size_t const size = buffer_.size() - size_offset - sizeof(uint32_t);
+
+    if (size > UINT32_MAX)
+    {
+      return Err(AllocError::NoMemory);
+    }
+
+    uint32_t const size32 = static_cast<uint32_t>(size);
+    std::memcpy(buffer_.data() + size_offset, &size32, sizeof(size32));
+
+    return Ok(Void{});
+  }
+
+  Vec<uint8_t> buffer_;
+};
+
+struct BinaryReader
+{
+  BinaryReader(Span<uint8_t const> input, Allocator allocator) :
+      input_{input}, allocator_{allocator}, offset_{0}, end_{input.size()}
+  {}
+
+  size_t remaining() const
+  {
+    return end_ - offset_;
+  }
+
+  Result<Span<uint8_t const>, BinaryError> read_bytes(size_t size)
+  {
+    if (size > remaining())
+    {
+      return Err(BinaryError::UnexpectedEnd);
+    }
+
+    Span<uint8_t const> bytes = input_.slice(offset_, size);
+    offset_ += size;
+
+    return Ok(Span<uint8_t const>{bytes});
+  }
+
+  // skips the padding written by `BinaryWriter::write_padding`
+  Result<Void, BinaryError> read_padding(size_t alignment)
+  {
+    TRY_OK(padding, read_bytes((alignment - offset_ % alignment) % alignment));
+
+    (void) padding;
+
+    return Ok(Void{});
+  }
+
+  Result<uint64_t, BinaryError> read_varint()
+  {
+    uint64_t value = 0;
+
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      if (offset_ == end_)
+      {
+        return Err(BinaryError::UnexpectedEnd);
+      }
+
+      uint8_t const byte = input_.data()[offset_];
+      offset_++;
+
+      // the 10th byte only has 1 bit left
+      if (shift == 63 && byte > 1)
+      {
+        return Err(BinaryError::InvalidData);
+      }
+
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+      if ((byte & 0x80) == 0)
+      {
+        return Ok(uint64_t{value});
+      }
+    }
+
+    return Err(BinaryError::InvalidData);
+  }
+
+  // decodes the values one after the other into `args`
+  template <typename... Args>
+  Result<Void, BinaryError> read(Args &...args)
+  {
+    BinaryError error = BinaryError::InvalidData;
+    bool const  ok    = (read_into(args, error) && ...);
+
+    if (!ok)
+    {
+      return Err(BinaryError{error});
+    }
+
+    return Ok(Void{});
+  }
+
+  // decodes the fields written by `BinaryWriter::write_struct`.
+  //
+  // fields can be appended to a struct without breaking its existing
+  // encodings: the fields missing from older encodings keep their values, and
+  // the fields appended by newer encodings are skipped.
+  template <typename... Fields>
+  Result<Void, BinaryError> read_struct(Fields &...fields)
+  {
+    TRY_OK(size_bytes, read_bytes(sizeof(uint32_t)));
+
+    uint32_t size = 0;
+    std::memcpy(&size, size_bytes.data(), sizeof(size));
+
+    if (size > remaining())
+    {
+      return Err(BinaryError::UnexpectedEnd);
+    }
+
+    BinaryReader struct_reader{input_, allocator_};
+    struct_reader.offset_ = offset_;
+    struct_reader.end_    = offset_ + size;
+
+    offset_ += size;
+
+    BinaryError error = BinaryError::InvalidData;
+    bool const  ok    = ((struct_reader.remaining() == 0 || struct_reader.read_into(fields, error)) && ...);
+
+    if (!ok)
+    {
+      return Err(BinaryError{error});
+    }
+
+    return Ok(Void{});
+  }
+
+  template <typename T>
+  bool read_into(T &value, BinaryError &error)
+  {
+    Result<T, BinaryError> result = Binary<T>::decode(*this);
+
+    if (result.is_err())
+    {
+      error = result.err();
+      return false;
+    }
+
+    value = std::move(result).unwrap();
+
+    return true;
+  }
+
+  // offsets are relative to the start of `input_` so the padding is skipped
+  // the same way it was written
+  Span<uint8_t const> input_;
+  Allocator           allocator_;
+  size_t              offset_ = 0;
+  size_t              end_    = 0;
+};
+
+template <typename T>
+struct Binary<T, std::enable_if_t<is_fixed_layout<T>::value>>
+{
+  static_assert(std::is_trivially_copyable_v<T>, "fixed-layout types must be trivially-copyable");
+
+  static Result<Void, AllocError> encode(BinaryWriter &writer, T const &value)
+  {
+    return writer.write_bytes(&value, sizeof(T));
+  }
+
+  static Result<T, BinaryError> decode(BinaryReader &reader)
+  {
+    TRY_OK(bytes, reader.read_bytes(sizeof(T)));
+
+    T value;
+    std::memcpy(&value, bytes.data(), sizeof(T));
+
+    return Ok(std::move(value));
+  }
+};
+
+template <>
+struct Binary<bool, void>
+{
+  static Result<Void, AllocError> encode(BinaryWriter &writer, bool value)
+  {
+    uint8_t const byte = value ? 1 : 0;
+    return writer.write_bytes(&byte, 1);
+  }
+
+  static Result<bool, BinaryError> decode(BinaryReader &reader)
+  {
+    TRY_OK(bytes, reader.read_bytes(1));
+
+    if (bytes[0] > 1)
+    {
+      return Err(BinaryError::InvalidData);
+    }
+
+    return Ok(bytes[0] == 1);
+  }
+};
+
+// decoded as a view into the input
+template <>
+struct Binary<std::string_view, void>
+{
+  static Result<Void, AllocError> encode(BinaryWriter &writer, std::string_view value)
+  {
+    TRY_OK(size_ok, writer.write_varint(value.size()));
+
+    (void) size_ok;
+
+    return writer.write_bytes(value.data(), value.size());
+  }
+
+  static Result<std::string_view, BinaryError> decode(BinaryReader &reader)
+  {
+    TRY_OK(size, reader.read_varint());
+
+    if (size > reader.remaining())
+    {
+      return Err(BinaryError::UnexpectedEnd);
+    }
+
+    TRY_OK(bytes, reader.read_bytes(static_cast<size_t>(size)));
+
+    return Ok(std::string_view{reinterpret_cast<char const *>(bytes.data()), bytes.size()});
+  }
+};
+
+// encoded like `std::string_view`, decoded as a copy
+template <>
+struct Binary<String, void>
+{
+  static Result<Void, AllocError> encode(BinaryWriter &writer, String const &value)
+  {
+    return Binary<std::string_view>::encode(writer, value.view());
+  }
+
+  static Result<String, BinaryError> decode(BinaryReader &reader)
+  {
+    TRY_OK(view, Binary<std::string_view>::decode(reader));
+
+    Result<String, AllocError> str = string::make(reader.allocator_, view);
+
+    if (str.is_err())
+    {
+      return Err(BinaryError::NoMemory);
+    }
+
+    return Ok(std::move(str).unwrap());
+  }
+};
+
+// spans of fixed-layout elements are decoded as views into the input, which
+// must be aligned like the encoding was, i.e. by the allocator
+template <typename T>
+struct Binary<Span<T>, void>
+{
+  using Element = std::remove_cv_t<T>;
+
+  static Result<Void, AllocError> encode(BinaryWriter &writer, Span<T> value)
+  {
+    TRY_OK(size_ok, writer.write_varint(value.size()));
+
+    (void) size_ok;
+
+    if constexpr (is_fixed_layout<Element>::value)
+    {
+      TRY_OK(padding_ok, writer.write_padding(alignof(Element)));
+
+      (void) padding_ok;
+
+      return writer.write_bytes(value.data(), value.size_bytes());
+    }
+    else
+    {
+      for (T &element : value)
+      {
+        TRY_OK(element_ok, Binary<Element>::encode(writer, element));
+
+        (void) element_ok;
+      }
+
+      return Ok(Void{});
+    }
+  }
+
+  static Result<Span<T>, BinaryError> decode(BinaryReader &reader)
+  {
+    static_assert(std::is_const_v<T> && is_fixed_layout<Element>::value,
+                  "only spans of const fixed-layout elements can be decoded");
+
+    TRY_OK(size, reader.read_varint());
+    TRY_OK(padding_ok, reader.read_padding(alignof(Element)));
+
+    (void) padding_ok;
+
+    if (size > reader.remaining() / sizeof(Element))
+    {
+      return Err(BinaryError::UnexpectedEnd);
+    }
+
+    TRY_OK(bytes, reader.read_bytes(static_cast<size_t>(size) * sizeof(Element)));
+
+    if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(Element) != 0)
+    {
+      return Err(BinaryError::Misaligned);
+    }
+
+    return Ok(Span<T>{reinterpret_cast<T *>(bytes.data()), static_cast<size_t>(size)});
+  }
+};
+
+// encoded like a `Span`, decoded as a copy
+template <typename T>
+struct Binary<Vec<T>, void>
+{
+  static Result<Void, AllocError> encode(BinaryWriter &writer, Vec<T> const &value)
+  {
+    return Binary<Span<T const>>::encode(writer, value.span());
+  }
+
+  static Result<Vec<T>, BinaryError> decode(BinaryReader &reader)
+  {
+    Vec<T> vec{reader.allocator_};
+
+    if constexpr (is_fixed_layout<T>::value)
+    {
+      // the input doesn't need to be aligned since the elements are copied
+      TRY_OK(size, reader.read_varint());
+      TRY_OK(padding_ok, reader.read_padding(alignof(T)));
+
+      (void) padding_ok;
+
+      if (size > reader.remaining() / sizeof(T))
+      {
+        return Err(BinaryError::UnexpectedEnd);
+      }
+
+      TRY_OK(bytes, reader.read_bytes(static_cast<size_t>(size) * sizeof(T)));
+
+      if (size != 0)
+      {
+        Result<Span<T>, AllocError> elements = vec.unsafe_resize_uninitialized(static_cast<size_t>(size));
+
+        if (elements.is_err())
+        {
+          return Err(BinaryError::NoMemory);
+        }
+
+        std::memcpy(vec.data(), bytes.data(), bytes.size());
+      }
+    }
+    else
+    {
+      TRY_OK(size, reader.read_varint());
+
+      // every element takes at least a byte
+      if (size > reader.remaining())
+      {
+        return Err(BinaryError::UnexpectedEnd);
+      }
+
+      if (vec.reserve(static_cast<size_t>(size)).is_err())
+      {
+        return Err(BinaryError::NoMemory);
+      }
+
+      for (uint64_t i = 0; i < size; i++)
+      {
+        TRY_OK(element, Binary<T>::decode(reader));
+
+        vec.push(std::move(element)).unwrap();
+      }
+    }
+
+    return Ok(std::move(vec));
+  }
+};
+
+template <typename T>
+struct Binary<Option<T>, void>
+{
+  static Result<Void, AllocError> encode(BinaryWriter &writer, Option<T> const &value)
+  {
+    TRY_OK(tag_ok, Binary<bool>::encode(writer, value.is_some()));
+
+    (void) tag_ok;
+
+    if (value.is_some())
+    {
+      return Binary<T>::encode(writer, value.value());
+    }
+
+    return Ok(Void{});
+  }
+
+  static Result<Option<T>, BinaryError> decode(BinaryReader &reader)
+  {
+    TRY_OK(is_some, Binary<bool>::decode(reader));
+
+    if (!is_some)
+    {
+      return Ok(Option<T>{None});
+    }
+
+    TRY_OK(value, Binary<T>::decode(reader));
+
+    return Ok(Option<T>{Some(std::move(value))});
+  }
+};
+
+template <typename T, typename E>
+struct Binary<Result<T, E>, void>
+{
+  static Result<Void, AllocError> encode(BinaryWriter &writer, Result<T, E> const &value)
+  {
+    TRY_OK(tag_ok, Binary<bool>::encode(writer, value.is_err()));
+
+    (void) tag_ok;
+
+    if (value.is_ok())
+    {
+      return Binary<T>::encode(writer, value.value());
+    }
+
+    return Binary<E>::encode(writer, value.err());
+  }
+
+  static Result<Result<T, E>, BinaryError> decode(BinaryReader &reader)
+  {
+    TRY_OK(is_err, Binary<bool>::decode(reader));
+
+    if (!is_err)
+    {
+      TRY_OK(value, Binary<T>::decode(reader));
+
+      return Ok(Result<T, E>{Ok(std::move(value))});
+    }
+
+    TRY_OK(err, Binary<E>::decode(reader));
+
+    return Ok(Result<T, E>{Err(std::move(err))});
+  }
+};
+
+namespace binary
+{
+
+/// encodes the values one after the other into a buffer from `allocator`
+template <typename... Args>
+Result<Vec<uint8_t>, AllocError> encode(Allocator allocator, Args const &...args)
+{
+  BinaryWriter writer{allocator};
+
+  TRY_OK(ok, writer.write(args...));
+
+  (void) ok;
+
+  return Ok(std::move(writer.buffer_));
+}
+
+/// decodes a `T` that spans the whole input. the views it contains refer to
+/// `input`, and its owned values are allocated with `allocator`.
+template <typename T>
+Result<T, BinaryError> decode(Span<uint8_t const> input, Allocator allocator = noop_allocator)
+{
+  BinaryReader reader{input, allocator};
+
+  TRY_OK(value, Binary<T>::decode(reader));
+
+  if (reader.remaining() != 0)
+  {
+    return Err(BinaryError::InvalidData);
+  }
+
+  return Ok(std::move(value));
+}
+
+}        // namespace binary
+
+STX_END_NAMESPACE
@@ -0,0 +1,378 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <functional>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/relocate.h"
+#include "stx/result.h"
+#include "stx/slot_map.h"
+#include "stx/span.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+// handle to an element of a `BinaryHeap`. stays valid as the element moves
+// around the heap and is invalidated once the element is popped or erased.
+using HeapHandle = SlotKey;
+
+// BinaryHeap is an allocator-backed d-ary heap (priority queue).
+//
+// `Cmp(a, b)` returns true if `a` must be popped before `b`, so the default
+// `std::less` makes it a min-heap.
+//
+// the heap has `Arity` children per node (4 by default) so it is shallower
+// than a binary heap and the children of a node are compared within one or
+// two cache lines.
+//
+// every element is given a handle on insertion, through which the element can
+// be updated (decrease-key/increase-key) or erased in O(log n) without
+// searching the heap.
+//
+// the allocator must be alive for the lifetime of the BinaryHeap.
+//
+// ONLY NON-CONST METHODS INVALIDATE ITERATORS AND REFERENCES
+//
+template <typename T, typename Cmp = std::less<T>, size_t Arity = 4>
+struct BinaryHeap
+{
+  static_assert(!std::is_reference_v<T>);
+  static_assert(Arity >= 2);
+
+  using Size  = size_t;
+  using Index = size_t;
+
+  explicit BinaryHeap(Allocator allocator, Cmp cmp = {}) :
+      values_{allocator},
+      handles_{allocator},
+      slots_{allocator},
+      free_head_{impl::SLOT_MAP_NO_FREE_SLOT},
+      cmp_{std::move(cmp)}
+  {}
+
+  BinaryHeap(BinaryHeap &&other) :
+      values_{std::move(other.values_)},
+      handles_{std::move(other.handles_)},
+      slots_{std::move(other.slots_)},
+      free_head_{other.free_head_},
+      cmp_{std::move(other.cmp_)}
+  {
+    other.free_head_ = impl::SLOT_MAP_NO_FREE_SLOT;
+  }
+
+  BinaryHeap &operator=(BinaryHeap &&other)
+  {
+    std::swap(values_, other.values_);
+    std::swap(handles_, other.handles_);
+    std::swap(slots_, other.slots_);
+    std::swap(free_head_, other.free_head_);
+    std::swap(cmp_, other.cmp_);
+
+    return *this;
+  }
+
+  STX_DISABLE_COPY(BinaryHeap)
+  STX_DEFAULT_DESTRUCTOR(BinaryHeap)
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(BinaryHeap, is_trivially_relocatable<Cmp>)
+
+  Size size() const
+  {
+    return values_.size();
+  }
+
+  bool is_empty() const
+  {
+    return values_.is_empty();
+  }
+
+  // the elements in heap order, the first element is the top of the heap
+  Span<T const> span() const
+  {
+    return values_.span();
+  }
+
+  Option<Ref<T const>> top() const
+  {
+    if (is_empty())
+    {
+      return None;
+    }
+
+    return Some<Ref<T const>>(values_.data()[0]);
+  }
+
+  bool contains(HeapHandle handle) const
+  {
+    return find_position(handle).is_some();
+  }
+
+  Option<Ref<T const>> get(HeapHandle handle) const
+  {
+    Option<Index> position = find_position(handle);
+
+    if (position.is_none())
+    {
+      return None;
+    }
+
+    return Some<Ref<T const>>(values_.data()[position.value()]);
+  }
+
+  // reserve enough memory to contain at least `cap` elements
+  //
+  // invalidates references
+  //
+  Result<Void, AllocError> reserve(Size cap)
+  {
+    TRY_OK(values_ok, values_.reserve(cap));
+    TRY_OK(handles_ok, handles_.reserve(cap));
+    TRY_OK(slots_ok, slots_.reserve(cap));
+
+    (void) values_ok;
+    (void) handles_ok;
+    (void) slots_ok;
+
+    return Ok(Void{});
+  }
+
+  // invalidates references
+  //
+  // value is not moved if an allocation error occurs
+  Result<HeapHandle, AllocError> push(T &&value)
+  {
+    TRY_OK(ok, reserve(impl::grow_vec(values_.capacity(), values_.size() + 1)));
+
+    (void) ok;
+
+    uint32_t slot_index = free_head_;
+
+    if (slot_index == impl::SLOT_MAP_NO_FREE_SLOT)
+    {
+      slot_index = static_cast<uint32_t>(slots_.size());
+      slots_.push(impl::SlotMapSlot{}).unwrap();
+    }
+    else
+    {
+      free_head_ = slots_.data()[slot_index].dense_index_or_next_free;
+    }
+
+    impl::SlotMapSlot &slot = slots_.data()[slot_index];
+
+    slot.generation++;
+
+    HeapHandle const handle{slot_index, slot.generation};
+
+    values_.push(std::move(value)).unwrap();
+    handles_.push(uint32_t{slot_index}).unwrap();
+
+    sift_up(size() - 1);
+
+    return Ok(HeapHandle{handle});
+  }
+
+  // removes the top of the heap
+  //
+  // invalidates references
+  Option<T> pop()
+  {
+    if (is_empty())
+    {
+      return None;
+    }
+
+    return Some(remove_at(0));
+  }
+
+  // replaces the value of the element, and moves it up or down the heap
+  // accordingly (decrease-key/increase-key).
+  //
+  // returns false if the handle is no longer valid
+  //
+  // invalidates references
+  bool update(HeapHandle handle, T &&value)
+  {
+    Option<Index> position = find_position(handle);
+
+    if (position.is_none())
+    {
+      return false;
+    }
+
+    values_.data()[position.value()] = std::move(value);
+
+    restore(position.value());
+
+    return true;
+  }
+
+  // removes the element from the heap and returns it, if it is still in the
+  // heap
+  //
+  // invalidates references
+  Option<T> erase(HeapHandle handle)
+  {
+    Option<Index> position = find_position(handle);
+
+    if (position.is_none())
+    {
+      return None;
+    }
+
+    return Some(remove_at(position.value()));
+  }
+
+  // all handles are invalidated. capacity is unchanged
+  void clear()
+  {
+    while (!is_empty())
+    {
+      remove_at(size() - 1);
+    }
+  }
+
+  Vec<T>                 values_;
+  // the slot index of the handle of each element
+  Vec<uint32_t>          handles_;
+  Vec<impl::SlotMapSlot> slots_;
+  uint32_t               free_head_ = impl::SLOT_MAP_NO_FREE_SLOT;
+  Cmp                    cmp_;
+
+private:
+  Option<Index> find_position(HeapHandle handle) const
+  {
+    if (handle.index >= slots_.size())
+    {
+      return None;
+    }
+
+    impl::SlotMapSlot const &slot = slots_.data()[handle.index];
+
+    if (slot.generation != handle.generation || !slot.is_occupied())
+    {
+      return None;
+    }
+
+    return Some(Index{slot.dense_index_or_next_free});
+  }
+
+  void place(Index position, T &&value, uint32_t slot_index)
+  {
+    values_.data()[position]                           = std::move(value);
+    handles_.data()[position]                          = slot_index;
+    slots_.data()[slot_index].dense_index_or_next_free = static_cast<uint32_t>(position);
+  }
+
+  // moves the element at `position` up until its parent precedes it.
+  // the parents are shifted down into the hole instead of being swapped.
+  void sift_up(Index position)
+  {
+    T        value      = std::move(values_.data()[position]);
+    uint32_t slot_index = handles_.data()[position];
+
+    while (position > 0)
+    {
+      Index const parent = (position - 1) / Arity;
+
+      if (!cmp_(value, values_.data()[parent]))
+      {
+        break;
+      }
+
+      place(position, std::move(values_.data()[parent]), handles_.data()[parent]);
+      position = parent;
+    }
+
+    place(position, std::move(value), slot_index);
+  }
+
+  // moves the element at `position` down until it precedes all its children
+  void sift_down(Index position)
+  {
+    Size const num_values = size();
+    T          value      = std::move(values_.data()[position]);
+    uint32_t   slot_index = handles_.data()[position];
+
+    while (true)
+    {
+      Index const first_child = position * Arity + 1;
+
+      if (first_child >= num_values)
+      {
+        break;
+      }
+
+      Index const last_child = std::min(first_child + Arity, num_values);
+      Index       best_child = first_child;
+
+      for (Index child = first_child + 1; child < last_child; child++)
+      {
+        if (cmp_(values_.data()[child], values_.data()[best_child]))
+        {
+          best_child = child;
+        }
+      }
+
+      if (!cmp_(values_.data()[best_child], value))
+      {
+        break;
+      }
+
+      place(position, std::move(values_.data()[best_child]), handles_.data()[best_child]);
+      position = best_child;
+    }
+
+    place(position, std::move(value), slot_index);
+  }
+
+  void restore(Index position)
+  {
+    if (position > 0 && cmp_(values_.data()[position], values_.data()[(position - 1) / Arity]))
+    {
+      sift_up(position);
+    }
+    else
+    {
+      sift_down(position);
+    }
+  }
+
+  // removes the element at `position`, the last element is moved into its
+  // position and then moved up or down the heap
+  T remove_at(Index position)
+  {
+    Index const    last       = size() - 1;
+    uint32_t const slot_index = handles_.data()[position];
+
+    impl::SlotMapSlot &slot = slots_.data()[slot_index];
+
+    slot.dense_index_or_next_free = free_head_;
+    slot.generation++;
+    free_head_ = slot_index;
+
+    T value = std::move(values_.data()[position]);
+
+    if (position != last)
+    {
+      place(position, std::move(values_.data()[last]), handles_.data()[last]);
+    }
+
+    (void) values_.pop();
+    (void) handles_.pop();
+
+    if (position != last)
+    {
+      restore(position);
+    }
+
+    return value;
+  }
+};
+
+STX_END_NAMESPACE
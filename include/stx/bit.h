@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "stx/config.h"
+
+#if STX_CFG(COMPILER, MSVC)
+#  include <intrin.h>
+#endif
+
+STX_BEGIN_NAMESPACE
+
+/// bit manipulation utilities.
+///
+/// these map to single instructions on the supported compilers and
+/// architectures (i.e. `tzcnt`, `lzcnt`, `popcnt`), with portable fallbacks.
+///
+
+/// number of trailing zero bits. `value` must not be 0.
+inline uint32_t count_trailing_zeros(uint64_t value)
+{
+#if STX_HAS_BUILTIN(ctzll)
+  return static_cast<uint32_t>(__builtin_ctzll(value));
+#elif STX_CFG(COMPILER, MSVC) && (STX_CFG(ARCH, X86_64) || STX_CFG(ARCH, ARM64))
+  unsigned long index = 0;
+  _BitScanForward64(&index, value);
+  return static_cast<uint32_t>(index);
+#else
+  uint32_t count = 0;
+  while ((value & 1) == 0)
+  {
+    value >>= 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+/// number of leading zero bits. `value` must not be 0.
+inline uint32_t count_leading_zeros(uint64_t value)
+{
+#if STX_HAS_BUILTIN(clzll)
+  return static_cast<uint32_t>(__builtin_clzll(value));
+#elif STX_CFG(COMPILER, MSVC) && (STX_CFG(ARCH, X86_64) || STX_CFG(ARCH, ARM64))
+  unsigned long index = 0;
+  _BitScanReverse64(&index, value);
+  return static_cast<uint32_t>(63 - index);
+#else
+  uint32_t count = 0;
+  while ((value & (static_cast<uint64_t>(1) << 63)) == 0)
+  {
+    value <<= 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+/// number of set bits
+inline uint32_t popcount(uint64_t value)
+{
+#if STX_HAS_BUILTIN(popcountll)
+  return static_cast<uint32_t>(__builtin_popcountll(value));
+#else
+  // SWAR bit-counting
+  value = value - ((value >> 1) & 0x5555555555555555ULL);
+  value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+  value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<uint32_t>((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/// smallest power of two that is greater than or equal to `value`
+constexpr size_t bit_ceil(size_t value)
+{
+  size_t result = 1;
+
+  while (result < value)
+  {
+    result <<= 1;
+  }
+
+  return result;
+}
+
+/// largest power of two that is less than or equal to `value`, 0 if `value`
+/// is 0
+constexpr size_t bit_floor(size_t value)
+{
+  size_t result = value == 0 ? 0 : 1;
+
+  while (result <= value / 2)
+  {
+    result <<= 1;
+  }
+
+  return result;
+}
+
+STX_END_NAMESPACE
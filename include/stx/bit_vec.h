@@ -0,0 +1,506 @@
+#pragma once
+
+#include <cinttypes>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/bit.h"
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/relocate.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+namespace impl
+{
+
+constexpr size_t BITS_PER_WORD = 64;
+
+constexpr size_t num_bit_words(size_t num_bits)
+{
+  return (num_bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+}
+
+// mask of the valid bits in the last word of a bit sequence
+constexpr uint64_t last_bit_word_mask(size_t num_bits)
+{
+  return num_bits % BITS_PER_WORD == 0 ? ~uint64_t{0} : (uint64_t{1} << (num_bits % BITS_PER_WORD)) - 1;
+}
+
+}        // namespace impl
+
+// iterates over the indices of the set bits of a bit sequence, in ascending
+// order. each step clears the lowest set bit of the current word and skips
+// empty words entirely.
+struct SetBitIterator
+{
+  size_t operator*() const
+  {
+    return word_index_ * impl::BITS_PER_WORD + count_trailing_zeros(word_);
+  }
+
+  SetBitIterator &operator++()
+  {
+    word_ &= word_ - 1;
+    skip_empty_words();
+    return *this;
+  }
+
+  bool operator==(SetBitIterator const &other) const
+  {
+    return word_index_ == other.word_index_ && word_ == other.word_;
+  }
+
+  bool operator!=(SetBitIterator const &other) const
+  {
+    return !(*this == other);
+  }
+
+  void skip_empty_words()
+  {
+    while (word_ == 0 && word_index_ + 1 < num_words_)
+    {
+      word_index_++;
+      word_ = words_[word_index_];
+    }
+
+    if (word_ == 0)
+    {
+      word_index_ = num_words_;
+    }
+  }
+
+  uint64_t const *words_      = nullptr;
+  size_t          num_words_  = 0;
+  size_t          word_index_ = 0;
+  uint64_t        word_       = 0;
+};
+
+struct SetBits
+{
+  SetBitIterator begin() const
+  {
+    return begin_;
+  }
+
+  SetBitIterator end() const
+  {
+    return SetBitIterator{begin_.words_, begin_.num_words_, begin_.num_words_, 0};
+  }
+
+  SetBitIterator begin_;
+};
+
+// BitSpan is a view of a sequence of bits packed into 64-bit words.
+//
+// all the operations are word-at-a-time (count, find, set-bit iteration,
+// union, intersection, difference) so answering i.e. "which slots are free"
+// touches 64 slots per instruction.
+//
+// the bits past `size` in the last word must always be zero.
+//
+// like `Span`, a BitSpan does not own its words and mutation through a const
+// BitSpan is allowed.
+//
+struct BitSpan
+{
+  using Size  = size_t;
+  using Index = size_t;
+
+  constexpr BitSpan() = default;
+
+  constexpr BitSpan(uint64_t *words, Size num_bits) :
+      words_{words}, num_bits_{num_bits}
+  {}
+
+  constexpr Size size() const
+  {
+    return num_bits_;
+  }
+
+  constexpr bool is_empty() const
+  {
+    return num_bits_ == 0;
+  }
+
+  constexpr Size num_words() const
+  {
+    return impl::num_bit_words(num_bits_);
+  }
+
+  constexpr Span<uint64_t> words() const
+  {
+    return Span<uint64_t>{words_, num_words()};
+  }
+
+  bool get(Index index) const
+  {
+    STX_SPAN_ENSURE(index < num_bits_, "index out of bounds");
+    return (words_[index / impl::BITS_PER_WORD] >> (index % impl::BITS_PER_WORD)) & 1;
+  }
+
+  void set(Index index) const
+  {
+    STX_SPAN_ENSURE(index < num_bits_, "index out of bounds");
+    words_[index / impl::BITS_PER_WORD] |= uint64_t{1} << (index % impl::BITS_PER_WORD);
+  }
+
+  void unset(Index index) const
+  {
+    STX_SPAN_ENSURE(index < num_bits_, "index out of bounds");
+    words_[index / impl::BITS_PER_WORD] &= ~(uint64_t{1} << (index % impl::BITS_PER_WORD));
+  }
+
+  void assign(Index index, bool value) const
+  {
+    if (value)
+    {
+      set(index);
+    }
+    else
+    {
+      unset(index);
+    }
+  }
+
+  void set_all() const
+  {
+    Size const n = num_words();
+
+    if (n == 0)
+    {
+      return;
+    }
+
+    for (Index i = 0; i < n; i++)
+    {
+      words_[i] = ~uint64_t{0};
+    }
+
+    words_[n - 1] = impl::last_bit_word_mask(num_bits_);
+  }
+
+  void unset_all() const
+  {
+    Size const n = num_words();
+
+    for (Index i = 0; i < n; i++)
+    {
+      words_[i] = 0;
+    }
+  }
+
+  // number of set bits
+  Size count_ones() const
+  {
+    Size const n     = num_words();
+    Size       count = 0;
+
+    for (Index i = 0; i < n; i++)
+    {
+      count += popcount(words_[i]);
+    }
+
+    return count;
+  }
+
+  bool any() const
+  {
+    Size const n = num_words();
+
+    for (Index i = 0; i < n; i++)
+    {
+      if (words_[i] != 0)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool all() const
+  {
+    return count_ones() == num_bits_;
+  }
+
+  // index of the first set bit at or after `from`
+  Option<Index> find_first_set(Index from = 0) const
+  {
+    return find_first(from, 0);
+  }
+
+  // index of the first unset bit at or after `from`
+  Option<Index> find_first_unset(Index from = 0) const
+  {
+    return find_first(from, ~uint64_t{0});
+  }
+
+  // indices of the set bits, in ascending order
+  SetBits ones() const
+  {
+    Size const     n = num_words();
+    SetBitIterator iter{words_, n, 0, n == 0 ? 0 : words_[0]};
+    iter.skip_empty_words();
+    return SetBits{iter};
+  }
+
+  // `this |= other`. both must have the same size
+  void union_with(BitSpan other) const
+  {
+    STX_SPAN_ENSURE(num_bits_ == other.num_bits_, "bit spans have different sizes");
+
+    Size const n = num_words();
+
+    for (Index i = 0; i < n; i++)
+    {
+      words_[i] |= other.words_[i];
+    }
+  }
+
+  // `this &= other`. both must have the same size
+  void intersect_with(BitSpan other) const
+  {
+    STX_SPAN_ENSURE(num_bits_ == other.num_bits_, "bit spans have different sizes");
+
+    Size const n = num_words();
+
+    for (Index i = 0; i < n; i++)
+    {
+      words_[i] &= other.words_[i];
+    }
+  }
+
+  // `this &= ~other`. both must have the same size
+  void difference_with(BitSpan other) const
+  {
+    STX_SPAN_ENSURE(num_bits_ == other.num_bits_, "bit spans have different sizes");
+
+    Size const n = num_words();
+
+    for (Index i = 0; i < n; i++)
+    {
+      words_[i] &= ~other.words_[i];
+    }
+  }
+
+  uint64_t *words_    = nullptr;
+  Size      num_bits_ = 0;
+
+private:
+  // finds the first bit that differs from the bits of `skip`
+  Option<Index> find_first(Index from, uint64_t skip) const
+  {
+    if (from >= num_bits_)
+    {
+      return None;
+    }
+
+    Size const n          = num_words();
+    Index      word_index = from / impl::BITS_PER_WORD;
+    uint64_t   word       = (words_[word_index] ^ skip) & (~uint64_t{0} << (from % impl::BITS_PER_WORD));
+
+    while (true)
+    {
+      if (word != 0)
+      {
+        Index index = word_index * impl::BITS_PER_WORD + count_trailing_zeros(word);
+
+        if (index >= num_bits_)
+        {
+          return None;
+        }
+
+        return Some(Index{index});
+      }
+
+      word_index++;
+
+      if (word_index >= n)
+      {
+        return None;
+      }
+
+      word = words_[word_index] ^ skip;
+    }
+  }
+};
+
+// BitVec is a growable, allocator-backed sequence of bits.
+//
+// see `BitSpan` for the operations on the bits.
+//
+// the allocator must be alive for the lifetime of the BitVec.
+//
+struct BitVec
+{
+  using Size  = size_t;
+  using Index = size_t;
+
+  BitVec() :
+      words_{os_allocator}, num_bits_{0}
+  {}
+
+  explicit BitVec(Allocator allocator) :
+      words_{allocator}, num_bits_{0}
+  {}
+
+  BitVec(BitVec &&other) :
+      words_{std::move(other.words_)}, num_bits_{other.num_bits_}
+  {
+    other.num_bits_ = 0;
+  }
+
+  BitVec &operator=(BitVec &&other)
+  {
+    std::swap(words_, other.words_);
+    std::swap(num_bits_, other.num_bits_);
+
+    return *this;
+  }
+
+  STX_DISABLE_COPY(BitVec)
+  STX_DEFAULT_DESTRUCTOR(BitVec)
+  STX_MARK_TRIVIALLY_RELOCATABLE(BitVec)
+
+  Size size() const
+  {
+    return num_bits_;
+  }
+
+  bool is_empty() const
+  {
+    return num_bits_ == 0;
+  }
+
+  BitSpan span() const
+  {
+    return BitSpan{words_.data(), num_bits_};
+  }
+
+  bool get(Index index) const
+  {
+    return span().get(index);
+  }
+
+  void set(Index index) const
+  {
+    span().set(index);
+  }
+
+  void unset(Index index) const
+  {
+    span().unset(index);
+  }
+
+  // reserve enough memory to contain at least `cap` bits
+  Result<Void, AllocError> reserve(Size cap)
+  {
+    return words_.reserve(impl::num_bit_words(cap));
+  }
+
+  // new bits are initialized to `value`
+  Result<Void, AllocError> resize(Size target_size, bool value = false)
+  {
+    Size const old_size = num_bits_;
+
+    TRY_OK(ok, words_.resize(impl::num_bit_words(target_size), uint64_t{0}));
+
+    (void) ok;
+
+    num_bits_ = target_size;
+
+    if (target_size > old_size)
+    {
+      if (value)
+      {
+        BitSpan bits = span();
+
+        for (Index i = old_size; i < target_size; i++)
+        {
+          bits.set(i);
+        }
+      }
+    }
+    else if (target_size != 0)
+    {
+      // keep the bits past the end zeroed
+      words_.data()[words_.size() - 1] &= impl::last_bit_word_mask(target_size);
+    }
+
+    return Ok(Void{});
+  }
+
+  Result<Void, AllocError> push(bool value)
+  {
+    if (num_bits_ % impl::BITS_PER_WORD == 0)
+    {
+      TRY_OK(ok, words_.push(uint64_t{0}));
+      (void) ok;
+    }
+
+    num_bits_++;
+    span().assign(num_bits_ - 1, value);
+
+    return Ok(Void{});
+  }
+
+  // capacity is unchanged
+  void clear()
+  {
+    words_.clear();
+    num_bits_ = 0;
+  }
+
+  Vec<uint64_t> words_;
+  Size          num_bits_ = 0;
+};
+
+// FixedBitSet is a fixed-size sequence of `N` bits stored inline.
+//
+// see `BitSpan` for the operations on the bits.
+//
+template <size_t N>
+struct FixedBitSet
+{
+  using Size  = size_t;
+  using Index = size_t;
+
+  static constexpr Size NUM_WORDS = impl::num_bit_words(N);
+
+  constexpr Size size() const
+  {
+    return N;
+  }
+
+  BitSpan span()
+  {
+    return BitSpan{words_, N};
+  }
+
+  bool get(Index index) const
+  {
+    STX_SPAN_ENSURE(index < N, "index out of bounds");
+    return (words_[index / impl::BITS_PER_WORD] >> (index % impl::BITS_PER_WORD)) & 1;
+  }
+
+  void set(Index index)
+  {
+    span().set(index);
+  }
+
+  void unset(Index index)
+  {
+    span().unset(index);
+  }
+
+  uint64_t words_[NUM_WORDS == 0 ? 1 : NUM_WORDS] = {};
+};
+
+STX_END_NAMESPACE
@@ -6,6 +6,7 @@
 #include <string_view>
 
 #include "stx/config.h"
+#include "stx/hash.h"
 #include "stx/option.h"
 #include "stx/span.h"
 
@@ -146,4 +147,14 @@ struct CStringView
   Size        size_ = 0;
 };
 
+// hashes the contents, equal to the hash of the equivalent `std::string_view`
+template <>
+struct Hash<CStringView, void>
+{
+  constexpr HashValue operator()(CStringView value) const
+  {
+    return hash::string(value);
+  }
+};
+
 STX_END_NAMESPACE
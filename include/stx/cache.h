@@ -0,0 +1,346 @@
+#pragma once
+
+#include <cinttypes>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/async.h"
+#include "stx/config.h"
+#include "stx/hash.h"
+#include "stx/hash_map.h"
+#include "stx/option.h"
+#include "stx/rc.h"
+#include "stx/result.h"
+#include "stx/spinlock.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+struct CacheStats
+{
+  uint64_t hits      = 0;
+  uint64_t misses    = 0;
+  uint64_t evictions = 0;
+  size_t   entries   = 0;
+  size_t   bytes     = 0;
+};
+
+namespace impl
+{
+
+template <typename K, typename V>
+struct ClockCacheEntry
+{
+  K       key;
+  Rc<V *> value;
+  size_t  bytes      = 0;
+  bool    referenced = false;
+};
+
+// a CLOCK cache over a slot array.
+//
+// the entries sit in `slots` and `index` maps their keys to their slots. a hit
+// only sets the entry's reference bit. to evict, the clock hand sweeps the
+// slots, clearing the reference bits it passes until it finds an entry whose
+// bit is already clear, which is evicted. each sweep step clears a bit that
+// was set by a hit, so eviction is amortized O(1).
+//
+// `free_slots` always has enough capacity to hold all the slots, so evicting
+// never allocates.
+template <typename K, typename V, typename Hasher>
+struct STX_CACHELINE_ALIGNED ClockCacheShard
+{
+  using Entry = ClockCacheEntry<K, V>;
+
+  SpinLock                   lock;
+  HashMap<K, size_t, Hasher> index;
+  Vec<Option<Entry>>         slots;
+  Vec<size_t>                free_slots;
+  size_t                     hand       = 0;
+  size_t                     bytes      = 0;
+  size_t                     byte_limit = 0;
+  uint64_t                   hits       = 0;
+  uint64_t                   misses     = 0;
+  uint64_t                   evictions  = 0;
+
+  Option<Rc<V *>> get(K const &key)
+  {
+    Option<Ref<size_t>> slot = index.get(key);
+
+    if (slot.is_none())
+    {
+      misses++;
+      return None;
+    }
+
+    hits++;
+
+    Entry &entry     = slots.data()[slot.value().get()].value();
+    entry.referenced = true;
+
+    return Some(entry.value.share());
+  }
+
+  void remove_slot(size_t slot)
+  {
+    Entry &entry = slots.data()[slot].value();
+
+    (void) index.remove(entry.key);
+    bytes -= entry.bytes;
+    slots.data()[slot] = None;
+    free_slots.push(size_t{slot}).unwrap();
+  }
+
+  bool erase(K const &key)
+  {
+    Option<Ref<size_t>> slot = index.get(key);
+
+    if (slot.is_none())
+    {
+      return false;
+    }
+
+    remove_slot(slot.value().get());
+
+    return true;
+  }
+
+  // evicts entries other than the one in `keep` until `value_bytes` more
+  // bytes fit in the budget
+  void evict_until_fits(size_t value_bytes, size_t keep)
+  {
+    while (bytes + value_bytes > byte_limit)
+    {
+      if (hand >= slots.size())
+      {
+        hand = 0;
+      }
+
+      Option<Entry> &slot = slots.data()[hand];
+
+      if (slot.is_some() && hand != keep)
+      {
+        if (!slot.value().referenced)
+        {
+          remove_slot(hand);
+          evictions++;
+        }
+        else
+        {
+          slot.value().referenced = false;
+        }
+      }
+
+      hand++;
+    }
+  }
+
+  // nothing is modified if an allocation fails, so the previous value of
+  // `key` stays cached
+  Result<Void, AllocError> insert(K &&key, Rc<V *> &&value, size_t value_bytes)
+  {
+    if (value_bytes > byte_limit)
+    {
+      // the previous value is outdated even though the new one isn't cached
+      (void) erase(key);
+      return Ok(Void{});
+    }
+
+    Option<Ref<size_t>> existing = index.get(key);
+
+    if (existing.is_some())
+    {
+      // replaced in place, which doesn't allocate
+      size_t const slot = existing.value().get();
+
+      bytes -= slots.data()[slot].value().bytes;
+      slots.data()[slot].value().bytes = 0;
+
+      evict_until_fits(value_bytes, slot);
+
+      slots.data()[slot] = Some(Entry{std::move(key), std::move(value), value_bytes, false});
+      bytes += value_bytes;
+
+      return Ok(Void{});
+    }
+
+    TRY_OK(slots_ok, slots.reserve(slots.size() + 1));
+    TRY_OK(free_slots_ok, free_slots.reserve(slots.capacity()));
+
+    (void) slots_ok;
+    (void) free_slots_ok;
+
+    size_t const slot = free_slots.is_empty() ? slots.size() : free_slots.data()[free_slots.size() - 1];
+
+    TRY_OK(index_ok, index.insert(K{key}, size_t{slot}));
+
+    (void) index_ok;
+
+    if (free_slots.is_empty())
+    {
+      slots.push(Option<Entry>{None}).unwrap();
+    }
+    else
+    {
+      (void) free_slots.pop();
+    }
+
+    // the claimed slot is still empty so it's skipped
+    evict_until_fits(value_bytes, slot);
+
+    slots.data()[slot] = Some(Entry{std::move(key), std::move(value), value_bytes, false});
+    bytes += value_bytes;
+
+    return Ok(Void{});
+  }
+
+  void clear()
+  {
+    index.clear();
+    slots.clear();
+    free_slots.clear();
+    hand  = 0;
+    bytes = 0;
+  }
+};
+
+}        // namespace impl
+
+// ClockCache is a concurrent, sharded cache of `Rc`-shared values with a byte
+// budget.
+//
+// each entry is charged the number of bytes given when it's inserted. when an
+// insertion would exceed the budget, entries are evicted from the entry's
+// shard using the CLOCK policy (an approximation of LRU in which a hit only
+// sets a bit instead of reordering a list). each of the `NumShards` shards has
+// `1/NumShards` of the budget, its own lock and its own counters so concurrent
+// operations on different shards don't contend.
+//
+// `get` shares the cached `Rc`, so an evicted value stays alive until its
+// users release it.
+//
+// the keys must be copy-constructible. the allocator must be alive for the
+// lifetime of the ClockCache.
+//
+template <typename K, typename V, typename Hasher = Hash<K>, size_t NumShards = 16>
+struct ClockCache
+{
+  static_assert(!std::is_reference_v<K>);
+  static_assert(std::is_copy_constructible_v<K>);
+  static_assert(NumShards > 0 && (NumShards & (NumShards - 1)) == 0, "number of shards must be a power of two");
+
+  using Size  = size_t;
+  using Shard = impl::ClockCacheShard<K, V, Hasher>;
+
+  // log2(NumShards)
+  static constexpr uint32_t SHARD_BITS = [] {
+    uint32_t bits = 0;
+    while ((Size{1} << bits) < NumShards)
+    {
+      bits++;
+    }
+    return bits;
+  }();
+
+  STX_MAKE_PINNED(ClockCache)
+
+  ClockCache(Allocator allocator, Size byte_budget)
+  {
+    for (Shard &shard : shards_)
+    {
+      shard.index      = HashMap<K, size_t, Hasher>{allocator};
+      shard.slots      = Vec<Option<typename Shard::Entry>>{allocator};
+      shard.free_slots = Vec<size_t>{allocator};
+      shard.byte_limit = byte_budget / NumShards;
+    }
+  }
+
+  // the cached value of `key`, if any
+  Option<Rc<V *>> get(K const &key)
+  {
+    Shard          &shard = shard_for(key);
+    Option<Rc<V *>> value;
+
+    STX_WITH_LOCK(shard.lock, { value = shard.get(key); });
+
+    return value;
+  }
+
+  // caches `value`, charging it `bytes` of the budget, and replaces any value
+  // cached with `key`. evicts entries from the shard until the value fits.
+  //
+  // values larger than a shard's share of the budget are not cached, and the
+  // value previously cached with `key` is removed since it's outdated.
+  //
+  // the key and value are not moved and the previously cached value is kept
+  // if an allocation error occurs. replacing a cached value never allocates.
+  Result<Void, AllocError> insert(K &&key, Rc<V *> &&value, Size bytes)
+  {
+    Shard                   &shard  = shard_for(key);
+    Result<Void, AllocError> result = Ok(Void{});
+
+    STX_WITH_LOCK(shard.lock, { result = shard.insert(std::move(key), std::move(value), bytes); });
+
+    return result;
+  }
+
+  // removes the value cached with `key`, returns true if there was one
+  bool erase(K const &key)
+  {
+    Shard &shard  = shard_for(key);
+    bool   erased = false;
+
+    STX_WITH_LOCK(shard.lock, { erased = shard.erase(key); });
+
+    return erased;
+  }
+
+  // removes all the cached values. the counters are not reset.
+  void clear()
+  {
+    for (Shard &shard : shards_)
+    {
+      STX_WITH_LOCK(shard.lock, { shard.clear(); });
+    }
+  }
+
+  // the counters summed across the shards
+  CacheStats stats()
+  {
+    CacheStats stats;
+
+    for (Shard &shard : shards_)
+    {
+      STX_WITH_LOCK(shard.lock, {
+        stats.hits += shard.hits;
+        stats.misses += shard.misses;
+        stats.evictions += shard.evictions;
+        stats.entries += shard.index.size();
+        stats.bytes += shard.bytes;
+      });
+    }
+
+    return stats;
+  }
+
+  Shard &shard_for(K const &key)
+  {
+    if constexpr (SHARD_BITS == 0)
+    {
+      (void) key;
+      return shards_[0];
+    }
+    else
+    {
+      // the HashMaps index their slots with the low bits of the hash
+      return shards_[Hasher{}(key) >> (64 - SHARD_BITS)];
+    }
+  }
+
+  Shard shards_[NumShards];
+};
+
+STX_END_NAMESPACE
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cinttypes>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/async.h"
+#include "stx/config.h"
+#include "stx/hash.h"
+#include "stx/hash_map.h"
+#include "stx/option.h"
+#include "stx/result.h"
+#include "stx/spinlock.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+namespace impl
+{
+
+// each shard is on its own cache line(s) so that threads operating on
+// different shards don't contend on the same cache line
+template <typename K, typename V, typename Hasher>
+struct STX_CACHELINE_ALIGNED ConcurrentHashMapShard
+{
+  SpinLock              lock;
+  HashMap<K, V, Hasher> map;
+};
+
+}        // namespace impl
+
+// ConcurrentHashMap is a hash map that can be accessed from multiple threads.
+//
+// the entries are partitioned by the high bits of their hashes into
+// `NumShards` independent `HashMap`s, each guarded by its own `SpinLock`, so
+// threads only contend when they access keys of the same shard at the same
+// time.
+//
+// the values are never referenced outside of the shard's lock: `get` returns a
+// copy and `compute` updates the value in place while holding the lock. the
+// hasher, key comparisons and the callbacks passed to `compute` run inside the
+// shard's critical section and must be short.
+//
+// the allocator must be alive for the lifetime of the ConcurrentHashMap.
+//
+template <typename K, typename V, typename Hasher = Hash<K>, size_t NumShards = 64>
+struct ConcurrentHashMap
+{
+  static_assert(!std::is_reference_v<K> && !std::is_reference_v<V>);
+  static_assert(NumShards > 0 && (NumShards & (NumShards - 1)) == 0, "number of shards must be a power of two");
+
+  using Size  = size_t;
+  using Shard = impl::ConcurrentHashMapShard<K, V, Hasher>;
+
+  // log2(NumShards)
+  static constexpr uint32_t SHARD_BITS = [] {
+    uint32_t bits = 0;
+    while ((Size{1} << bits) < NumShards)
+    {
+      bits++;
+    }
+    return bits;
+  }();
+
+  STX_MAKE_PINNED(ConcurrentHashMap)
+
+  explicit ConcurrentHashMap(Allocator allocator)
+  {
+    for (Shard &shard : shards_)
+    {
+      shard.map = HashMap<K, V, Hasher>{allocator};
+    }
+  }
+
+  // number of entries. only a snapshot if other threads are modifying the
+  // map.
+  Size size()
+  {
+    Size size = 0;
+
+    for (Shard &shard : shards_)
+    {
+      STX_WITH_LOCK(shard.lock, { size += shard.map.size(); });
+    }
+
+    return size;
+  }
+
+  bool contains(K const &key)
+  {
+    Shard &shard = shard_for(key);
+    bool   found = false;
+
+    STX_WITH_LOCK(shard.lock, { found = shard.map.contains(key); });
+
+    return found;
+  }
+
+  // a copy of the value of the entry with `key`, if any
+  Option<V> get(K const &key)
+  {
+    static_assert(std::is_copy_constructible_v<V>);
+
+    Shard    &shard = shard_for(key);
+    Option<V> value;
+
+    STX_WITH_LOCK(shard.lock, {
+      Option<Ref<V>> entry = shard.map.get(key);
+
+      if (entry.is_some())
+      {
+        value = Some(V{entry.value().get()});
+      }
+    });
+
+    return value;
+  }
+
+  // inserts the entry or replaces the value of an existing entry with `key`.
+  //
+  // the key and value are not moved if an allocation error occurs
+  Result<Void, AllocError> insert_or_assign(K &&key, V &&value)
+  {
+    Shard                   &shard  = shard_for(key);
+    Result<Void, AllocError> result = Ok(Void{});
+
+    STX_WITH_LOCK(shard.lock, { result = shard.map.insert(std::move(key), std::move(value)); });
+
+    return result;
+  }
+
+  // atomically updates the entry with `key`.
+  //
+  // `func` is called with the current value of the entry (moved out of the
+  // map), or None if there's no entry, and returns the new value, or None to
+  // remove the entry. `func` runs while the shard is locked.
+  //
+  // returns the error if memory allocation fails while inserting a new entry,
+  // the key and the value returned by `func` are then discarded.
+  template <typename Func>
+  Result<Void, AllocError> compute(K &&key, Func &&func)
+  {
+    static_assert(std::is_invocable_r_v<Option<V>, Func &, Option<V>>);
+
+    Shard                   &shard  = shard_for(key);
+    Result<Void, AllocError> result = Ok(Void{});
+
+    STX_WITH_LOCK(shard.lock, {
+      Option<Ref<V>> entry = shard.map.get(key);
+
+      if (entry.is_some())
+      {
+        Option<V> new_value = func(Some(std::move(entry.value().get())));
+
+        if (new_value.is_some())
+        {
+          entry.value().get() = std::move(new_value).unwrap();
+        }
+        else
+        {
+          (void) shard.map.remove(key);
+        }
+      }
+      else
+      {
+        Option<V> new_value = func(Option<V>{None});
+
+        if (new_value.is_some())
+        {
+          result = shard.map.insert(std::move(key), std::move(new_value).unwrap());
+        }
+      }
+    });
+
+    return result;
+  }
+
+  // removes the entry with `key` and returns its value, if any
+  Option<V> erase(K const &key)
+  {
+    Shard    &shard = shard_for(key);
+    Option<V> value;
+
+    STX_WITH_LOCK(shard.lock, { value = shard.map.remove(key); });
+
+    return value;
+  }
+
+  // capacity is unchanged
+  void clear()
+  {
+    for (Shard &shard : shards_)
+    {
+      STX_WITH_LOCK(shard.lock, { shard.map.clear(); });
+    }
+  }
+
+  Shard &shard_for(K const &key)
+  {
+    if constexpr (SHARD_BITS == 0)
+    {
+      (void) key;
+      return shards_[0];
+    }
+    else
+    {
+      // the HashMaps index their slots with the low bits of the hash
+      return shards_[Hasher{}(key) >> (64 - SHARD_BITS)];
+    }
+  }
+
+  Shard shards_[NumShards];
+};
+
+STX_END_NAMESPACE
@@ -188,6 +188,21 @@
 #  define STX_ARCH_RISCV 0
 #endif
 
+/*********************** SIMD EXTENSIONS ***********************/
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)        // SSE2
+#  define STX_SIMD_SSE2 1
+#else
+#  define STX_SIMD_SSE2 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)        // ARM NEON
+#  define STX_SIMD_NEON 1
+#else
+#  define STX_SIMD_NEON 0
+#endif
+
 /************ FEATURE AND LIBRARY REQUIREMENTS ************/
 
 #if defined __has_builtin
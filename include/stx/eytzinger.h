@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/bit.h"
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+
+#if STX_CFG(COMPILER, MSVC) && STX_CFG(SIMD, SSE2)
+#  include <xmmintrin.h>
+#endif
+
+STX_BEGIN_NAMESPACE
+
+namespace impl
+{
+
+inline void prefetch(void const *address)
+{
+#if STX_HAS_BUILTIN(prefetch)
+  __builtin_prefetch(address);
+#elif STX_CFG(COMPILER, MSVC) && STX_CFG(SIMD, SSE2)
+  _mm_prefetch(static_cast<char const *>(address), _MM_HINT_T0);
+#else
+  (void) address;
+#endif
+}
+
+}        // namespace impl
+
+// EytzingerVec holds a sorted sequence in Eytzinger (breadth-first) order:
+// the root of the implicit search tree is the first element and the children
+// of the `k`th node (1-based) are the `2k`th and `2k+1`th nodes.
+//
+// the first levels of the tree are packed together at the start of the array
+// so they stay in cache, and the nodes visited `log2(64 / sizeof(T))` levels
+// down are contiguous so they are prefetched while the current levels are
+// being compared. the allocators don't align the array to a cache line, so
+// they span one or two cache lines. this beats binary search over a sorted
+// `Span` once the sequence no longer fits in cache.
+//
+// the layout is immutable, rebuild it to modify the sequence.
+//
+template <typename T, typename Cmp = std::less<>>
+struct EytzingerVec
+{
+  using Size  = size_t;
+  using Index = size_t;
+
+  // number of nodes of the tree that fit in a cache line, rounded down to a
+  // power of two so they are whole levels of the subtree
+  static constexpr Size NODES_PER_CACHE_LINE = sizeof(T) >= 64 ? 1 : bit_floor(64 / sizeof(T));
+
+  explicit EytzingerVec(Vec<T> nodes, Cmp cmp = {}) :
+      nodes_{std::move(nodes)}, cmp_{std::move(cmp)}
+  {}
+
+  STX_DEFAULT_MOVE(EytzingerVec)
+  STX_DISABLE_COPY(EytzingerVec)
+  STX_DEFAULT_DESTRUCTOR(EytzingerVec)
+
+  Size size() const
+  {
+    return nodes_.size();
+  }
+
+  bool is_empty() const
+  {
+    return nodes_.is_empty();
+  }
+
+  // the elements in Eytzinger order
+  Span<T const> span() const
+  {
+    return nodes_.span();
+  }
+
+  // the first element that is not ordered before `object`
+  Option<Ref<T const>> lower_bound(T const &object) const
+  {
+    T const   *nodes = nodes_.data();
+    Size const n     = nodes_.size();
+    Index      k     = 1;
+
+    while (k <= n)
+    {
+      // the descendants of `k`, `log2(NODES_PER_CACHE_LINE)` levels down, are
+      // contiguous and start at the `k * NODES_PER_CACHE_LINE`th (1-based)
+      // node. the address is only used as a hint and is never dereferenced.
+      impl::prefetch(reinterpret_cast<void const *>(reinterpret_cast<uintptr_t>(nodes) + (k * NODES_PER_CACHE_LINE - 1) * sizeof(T)));
+      k = 2 * k + static_cast<Index>(cmp_(nodes[k - 1], object));
+    }
+
+    // `k` went right past the lower bound (a 0 bit) and then left at every
+    // subsequent level (1 bits). undo those moves to get back to the lower
+    // bound, if any.
+    k >>= count_trailing_zeros(~static_cast<uint64_t>(k)) + 1;
+
+    if (k == 0)
+    {
+      return None;
+    }
+
+    return Some<Ref<T const>>(nodes[k - 1]);
+  }
+
+  // the element equivalent to `object`, if any
+  Option<Ref<T const>> find(T const &object) const
+  {
+    Option<Ref<T const>> bound = lower_bound(object);
+
+    if (bound.is_none() || cmp_(object, bound.value().get()))
+    {
+      return None;
+    }
+
+    return bound;
+  }
+
+  bool contains(T const &object) const
+  {
+    return find(object).is_some();
+  }
+
+  Vec<T> nodes_;
+  Cmp    cmp_;
+};
+
+namespace impl
+{
+
+// fills the subtree rooted at the `k`th (1-based) node with the sorted
+// elements starting at `next`, in-order. returns the index of the next
+// unused element.
+template <typename T>
+size_t eytzinger_fill(Span<T const> sorted, T *nodes, size_t next, size_t k)
+{
+  if (k <= sorted.size())
+  {
+    next = eytzinger_fill(sorted, nodes, next, 2 * k);
+    new (nodes + k - 1) T{sorted.data()[next]};
+    next++;
+    next = eytzinger_fill(sorted, nodes, next, 2 * k + 1);
+  }
+
+  return next;
+}
+
+}        // namespace impl
+
+namespace eytzinger
+{
+
+// builds an Eytzinger layout of a span that is sorted by `cmp`
+template <typename T, typename Cmp = std::less<>>
+Result<EytzingerVec<T, Cmp>, AllocError> make(Allocator allocator, Span<T const> sorted, Cmp cmp = {})
+{
+  static_assert(std::is_copy_constructible_v<T>);
+
+  Vec<T> nodes{allocator};
+
+  TRY_OK(uninitialized, nodes.unsafe_resize_uninitialized(sorted.size()));
+
+  impl::eytzinger_fill(sorted, uninitialized.data(), 0, 1);
+
+  return Ok(EytzingerVec<T, Cmp>{std::move(nodes), std::move(cmp)});
+}
+
+}        // namespace eytzinger
+
+STX_END_NAMESPACE
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/relocate.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+// FlatMap is an ordered map stored as two sorted parallel `Vec`s: one of the
+// keys and one of the values.
+//
+// lookups are branchless binary searches over the densely packed keys, so they
+// touch far fewer cache lines than a node-based tree. insertions and removals
+// shift the elements after the position, so it is best suited for maps that
+// are mostly read, or built once.
+//
+// the allocator must be alive for the lifetime of the FlatMap.
+//
+// ONLY NON-CONST METHODS INVALIDATE ITERATORS AND REFERENCES
+//
+template <typename K, typename V, typename Cmp = std::less<>>
+struct FlatMap
+{
+  static_assert(!std::is_reference_v<K> && !std::is_reference_v<V>);
+
+  using Size  = size_t;
+  using Index = size_t;
+
+  explicit FlatMap(Allocator allocator, Cmp cmp = {}) :
+      keys_{allocator}, values_{allocator}, cmp_{std::move(cmp)}
+  {}
+
+  STX_DEFAULT_MOVE(FlatMap)
+  STX_DISABLE_COPY(FlatMap)
+  STX_DEFAULT_DESTRUCTOR(FlatMap)
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(FlatMap, is_trivially_relocatable<Cmp>)
+
+  Size size() const
+  {
+    return keys_.size();
+  }
+
+  bool is_empty() const
+  {
+    return keys_.is_empty();
+  }
+
+  // the keys, in ascending order
+  Span<K const> keys() const
+  {
+    return keys_.span();
+  }
+
+  // the value of each key in `keys`
+  Span<V> values() const
+  {
+    return values_.span();
+  }
+
+  bool contains(K const &key) const
+  {
+    return find(key).is_some();
+  }
+
+  Option<Ref<V>> get(K const &key) const
+  {
+    Option<Index> index = find(key);
+
+    if (index.is_none())
+    {
+      return None;
+    }
+
+    return Some<Ref<V>>(values_.data()[index.value()]);
+  }
+
+  // index of the entry with `key` in `keys` and `values`
+  Option<Index> find(K const &key) const
+  {
+    Index const index = keys_.span().lower_bound(key, cmp_);
+
+    if (index < keys_.size() && !cmp_(key, keys_.data()[index]))
+    {
+      return Some(Index{index});
+    }
+
+    return None;
+  }
+
+  Result<Void, AllocError> reserve(Size cap)
+  {
+    TRY_OK(keys_ok, keys_.reserve(cap));
+    TRY_OK(values_ok, values_.reserve(cap));
+
+    (void) keys_ok;
+    (void) values_ok;
+
+    return Ok(Void{});
+  }
+
+  // inserts the entry or replaces the value of an existing entry with `key`.
+  //
+  // invalidates references
+  //
+  // the key and value are not moved if an allocation error occurs
+  Result<Void, AllocError> insert(K &&key, V &&value)
+  {
+    Index const index = keys_.span().lower_bound(key, cmp_);
+
+    if (index < keys_.size() && !cmp_(key, keys_.data()[index]))
+    {
+      values_.data()[index] = std::move(value);
+      return Ok(Void{});
+    }
+
+    TRY_OK(ok, reserve(impl::grow_vec(keys_.capacity(), keys_.size() + 1)));
+
+    (void) ok;
+
+    keys_.push(std::move(key)).unwrap();
+    values_.push(std::move(value)).unwrap();
+
+    std::rotate(keys_.begin() + index, keys_.end() - 1, keys_.end());
+    std::rotate(values_.begin() + index, values_.end() - 1, values_.end());
+
+    return Ok(Void{});
+  }
+
+  // removes the entry with `key` and returns its value, if any
+  //
+  // invalidates references
+  Option<V> remove(K const &key)
+  {
+    Option<Index> index = find(key);
+
+    if (index.is_none())
+    {
+      return None;
+    }
+
+    Option<V> value = Some(std::move(values_.data()[index.value()]));
+
+    keys_.erase(keys_.span().slice(index.value(), 1));
+    values_.erase(values_.span().slice(index.value(), 1));
+
+    return value;
+  }
+
+  // capacity is unchanged
+  void clear()
+  {
+    keys_.clear();
+    values_.clear();
+  }
+
+  Vec<K> keys_;
+  Vec<V> values_;
+  Cmp    cmp_;
+};
+
+STX_END_NAMESPACE
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+#include "stx/config.h"
+#include "stx/fmt/core.h"
+#include "stx/span.h"
+
+STX_BEGIN_NAMESPACE
+
+namespace fmt
+{
+
+/// writes the formatted arguments to `out`, returns the number of characters
+/// written. the output is truncated if it doesn't fit and is not
+/// null-terminated.
+///
+/// ```cpp
+/// char buffer[64];
+///
+/// size_t size = fmt::format_to(buffer, "task ", task_id, " took ", ms, "ms at ", fmt::hex(address));
+///
+/// std::string_view message{buffer, size};
+/// ```
+///
+/// see "stx/fmt/core.h" for the formats of the argument types.
+///
+template <typename... Args>
+size_t format_to(Span<char> out, Args const &...args)
+{
+  return format_to_n(out.data(), out.size(), args...);
+}
+
+}        // namespace fmt
+
+STX_END_NAMESPACE
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <charconv>
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "stx/config.h"
+
+STX_BEGIN_NAMESPACE
+
+/// @file
+///
+/// allocation-free formatting into caller-provided buffers.
+///
+/// the arguments are written one after the other, their types select their
+/// formats:
+///
+/// - strings (anything convertible to `std::string_view`): as-is
+/// - `char`: the character
+/// - `bool`: `true` or `false`
+/// - integers: decimal
+/// - floating-point numbers: the shortest decimal form that parses back to
+///   the same value
+/// - pointers: `0x` followed by lowercase hexadecimal
+/// - `fmt::hex(value)`: lowercase hexadecimal, without a prefix
+///
+/// unsupported argument types are rejected at compile time.
+///
+/// this header doesn't depend on `Span` so it can be used by the panic
+/// handlers, see "stx/fmt.h" for the `Span` interface.
+///
+namespace fmt
+{
+
+template <typename T>
+struct Hex
+{
+  static_assert(std::is_unsigned_v<T>);
+
+  T value = 0;
+};
+
+/// formats an integer or a pointer as lowercase hexadecimal, without a prefix.
+/// signed integers are formatted as their two's complement bit pattern.
+template <typename T>
+constexpr auto hex(T value)
+{
+  if constexpr (std::is_pointer_v<T>)
+  {
+    return Hex<uintptr_t>{reinterpret_cast<uintptr_t>(value)};
+  }
+  else
+  {
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>);
+    return Hex<std::make_unsigned_t<T>>{static_cast<std::make_unsigned_t<T>>(value)};
+  }
+}
+
+namespace impl
+{
+
+template <typename T>
+struct is_hex : std::false_type
+{};
+
+template <typename T>
+struct is_hex<Hex<T>> : std::true_type
+{};
+
+}        // namespace impl
+
+template <typename T>
+constexpr bool is_formattable = impl::is_hex<T>::value || std::is_arithmetic_v<T> || std::is_convertible_v<T const &, std::string_view> || std::is_pointer_v<T>;
+
+namespace impl
+{
+
+// longest formatted integer: the digits of a 64-bit value and a sign
+constexpr size_t MAX_INTEGER_SIZE = 21;
+
+// longest shortest-form double: sign, 17 significant digits, point and a
+// 4-character exponent, with room to spare
+constexpr size_t MAX_FLOAT_SIZE = 32;
+
+constexpr char const DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+constexpr char const HEX_DIGITS[] = "0123456789abcdef";
+
+// writes the decimal digits of `value` backwards from `end`, two at a time,
+// returns the first digit
+template <typename U>
+char *write_decimal_backwards(char *end, U value)
+{
+  static_assert(std::is_unsigned_v<U>);
+
+  while (value >= 100)
+  {
+    U const pair = value % 100;
+    value /= 100;
+    end -= 2;
+    std::memcpy(end, DIGIT_PAIRS + pair * 2, 2);
+  }
+
+  if (value >= 10)
+  {
+    end -= 2;
+    std::memcpy(end, DIGIT_PAIRS + value * 2, 2);
+  }
+  else
+  {
+    end--;
+    *end = static_cast<char>('0' + value);
+  }
+
+  return end;
+}
+
+template <typename U>
+char *write_hex_backwards(char *end, U value)
+{
+  static_assert(std::is_unsigned_v<U>);
+
+  do
+  {
+    end--;
+    *end = HEX_DIGITS[value & 0xF];
+    value >>= 4;
+  } while (value != 0);
+
+  return end;
+}
+
+// writes to a fixed buffer, dropping what doesn't fit
+struct Sink
+{
+  char  *data     = nullptr;
+  size_t capacity = 0;
+  size_t size     = 0;
+
+  void write(char const *str, size_t str_size)
+  {
+    size_t const available = capacity - size;
+    size_t const to_write  = str_size < available ? str_size : available;
+
+    if (to_write != 0)
+    {
+      std::memcpy(data + size, str, to_write);
+      size += to_write;
+    }
+  }
+
+  template <typename T>
+  void put(T const &value)
+  {
+    static_assert(is_formattable<T>, "type is not formattable");
+
+    if constexpr (is_hex<T>::value)
+    {
+      char        digits[sizeof(value.value) * 2];
+      char *const end   = digits + sizeof(digits);
+      char const *first = write_hex_backwards(end, value.value);
+      write(first, static_cast<size_t>(end - first));
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+      std::string_view const str = value ? "true" : "false";
+      write(str.data(), str.size());
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+      write(&value, 1);
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+      static_assert(sizeof(T) <= 8);
+
+      using U = std::make_unsigned_t<T>;
+
+      char        digits[MAX_INTEGER_SIZE];
+      char *const end   = digits + sizeof(digits);
+      bool const  neg   = value < 0;
+      U const     abs   = neg ? static_cast<U>(U{0} - static_cast<U>(value)) : static_cast<U>(value);
+      char       *first = write_decimal_backwards(end, abs);
+
+      if (neg)
+      {
+        first--;
+        *first = '-';
+      }
+
+      write(first, static_cast<size_t>(end - first));
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+      char                 digits[MAX_FLOAT_SIZE];
+      std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+      write(digits, static_cast<size_t>(result.ptr - digits));
+    }
+    else if constexpr (std::is_convertible_v<T const &, std::string_view>)
+    {
+      std::string_view const str{value};
+      write(str.data(), str.size());
+    }
+    else
+    {
+      write("0x", 2);
+      put(hex(value));
+    }
+  }
+};
+
+template <typename T>
+size_t formatted_size(T const &value)
+{
+  if constexpr (std::is_convertible_v<T const &, std::string_view>)
+  {
+    return std::string_view{value}.size();
+  }
+  else
+  {
+    char buffer[MAX_FLOAT_SIZE + 2];
+    Sink sink{buffer, sizeof(buffer), 0};
+    sink.put(value);
+    return sink.size;
+  }
+}
+
+}        // namespace impl
+
+/// number of characters the arguments format to
+template <typename... Args>
+size_t formatted_size(Args const &...args)
+{
+  static_assert((is_formattable<Args> && ...), "type is not formattable");
+
+  return (impl::formatted_size(args) + ... + 0);
+}
+
+/// writes the formatted arguments to the `size` characters at `out`, returns
+/// the number of characters written. the output is truncated if it doesn't
+/// fit and is not null-terminated.
+template <typename... Args>
+size_t format_to_n(char *out, size_t size, Args const &...args)
+{
+  static_assert((is_formattable<Args> && ...), "type is not formattable");
+
+  impl::Sink sink{out, size, 0};
+
+  (sink.put(args), ...);
+
+  return sink.size;
+}
+
+}        // namespace fmt
+
+STX_END_NAMESPACE
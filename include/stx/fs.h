@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include "stx/c_string_view.h"
+#include "stx/config.h"
+#include "stx/memory.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/string.h"
+#include "stx/struct.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+enum class [[nodiscard]] IoError : uint8_t
+{
+  // the file or one of its parent directories doesn't exist
+  NotFound,
+  // the process doesn't have the required permissions
+  PermissionDenied,
+  // the path refers to a directory, device or other non-regular file
+  NotRegularFile,
+  // the process ran out of memory, address space or file descriptors
+  NoMemory,
+  // the device or the user's disk quota is full
+  NoSpace,
+  // the file's contents are not in the expected format
+  InvalidFormat,
+  // the operation is not supported on this platform
+  Unsupported,
+  Other
+};
+
+// how the contents of a mapping are expected to be accessed. the operating
+// system uses it to tune read-ahead and page eviction.
+enum class MemoryAdvice : uint8_t
+{
+  Normal,
+  // read front to back, i.e. parsing. pages are read-ahead aggressively and
+  // can be evicted soon after they are read.
+  Sequential,
+  // read in no particular order, i.e. lookups. read-ahead is disabled.
+  Random,
+  // the whole mapping will be read soon, start reading it in
+  WillNeed,
+  // the mapping will not be read soon, its pages can be evicted
+  DontNeed
+};
+
+// a read-only memory mapping of a file's contents. the contents are read
+// lazily from the page cache, without copies.
+//
+// the mapping is released with `memory_`, which can be moved into other
+// read-only containers. it's also null-terminated, so it can be moved into a
+// `String` without copying.
+//
+// the contents are undefined if the file is modified while it's mapped.
+//
+struct MappedFile
+{
+  using Size = size_t;
+
+  STX_DEFAULT_MOVE(MappedFile)
+  STX_DISABLE_COPY(MappedFile)
+  STX_DEFAULT_DESTRUCTOR(MappedFile)
+  STX_MARK_TRIVIALLY_RELOCATABLE(MappedFile)
+
+  MappedFile(ReadOnlyMemory &&memory, Size size) :
+      memory_{std::move(memory)}, size_{size}
+  {}
+
+  uint8_t const *data() const
+  {
+    return static_cast<uint8_t const *>(memory_.handle);
+  }
+
+  Size size() const
+  {
+    return size_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  Span<uint8_t const> span() const
+  {
+    return Span<uint8_t const>{data(), size_};
+  }
+
+  std::string_view view() const
+  {
+    return std::string_view{static_cast<char const *>(memory_.handle), size_};
+  }
+
+  // the contents as a string that owns the mapping. short contents are copied
+  // into the string and the mapping is released.
+  String to_string() &&
+  {
+    return String{std::move(memory_), size_};
+  }
+
+  // hints how the contents will be accessed, see `MemoryAdvice`
+  Result<Void, IoError> advise(MemoryAdvice advice) const;
+
+  ReadOnlyMemory memory_;
+  Size           size_ = 0;
+};
+
+namespace impl
+{
+
+// a read-write mapping of a whole file. the mapping is shared with the file,
+// so writes to it are written back to the file.
+struct SharedFileMapping
+{
+  using Size = size_t;
+
+  STX_DISABLE_COPY(SharedFileMapping)
+  STX_MARK_TRIVIALLY_RELOCATABLE(SharedFileMapping)
+
+  SharedFileMapping() = default;
+
+  SharedFileMapping(SharedFileMapping &&other) :
+      fd_{other.fd_}, data_{other.data_}, size_{other.size_}
+  {
+    other.fd_   = -1;
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  SharedFileMapping &operator=(SharedFileMapping &&other)
+  {
+    std::swap(fd_, other.fd_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  ~SharedFileMapping();
+
+  // resizes the file and remaps it, the mapping can move. on failure the
+  // mapping is unchanged but the file can have been resized.
+  Result<Void, IoError> resize(Size size);
+
+  // writes the modified pages back to the file and waits for them to be
+  // written
+  Result<Void, IoError> sync() const;
+
+  int   fd_   = -1;
+  void *data_ = nullptr;
+  Size  size_ = 0;
+};
+
+// opens the file at `path`, creating it if it doesn't exist, and maps it
+Result<SharedFileMapping, IoError> map_shared(CStringView path);
+
+// the size mappings are rounded to
+size_t page_size();
+
+}        // namespace impl
+
+namespace fs
+{
+
+// maps the contents of the regular file at `path` into memory, read-only.
+//
+// `advice` is applied to the mapping before it's returned, failing to apply it
+// is not an error. only supported on POSIX platforms, returns
+// `IoError::Unsupported` otherwise.
+//
+Result<MappedFile, IoError> map_readonly(CStringView path, MemoryAdvice advice = MemoryAdvice::Normal);
+
+}        // namespace fs
+
+STX_END_NAMESPACE
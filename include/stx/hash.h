@@ -0,0 +1,361 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "stx/config.h"
+#include "stx/span.h"
+
+#if STX_CFG(COMPILER, MSVC) && STX_CFG(ARCH, X86_64)
+#  include <intrin.h>
+#endif
+
+STX_BEGIN_NAMESPACE
+
+/// fast non-cryptographic hashing.
+///
+/// NOTE: the hashes are not stable across versions and must not be persisted
+/// or sent across processes.
+///
+using HashValue = uint64_t;
+
+namespace impl
+{
+
+constexpr uint64_t WYHASH_SECRET[] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                                      0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+constexpr void wyhash_mum_portable(uint64_t &a, uint64_t &b)
+{
+  uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+  uint64_t c  = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  a           = lo;
+  b           = hi;
+}
+
+/// 64x64 -> 128-bit multiply, returns the low and high halves in `a` and `b`
+constexpr void wyhash_mum(uint64_t &a, uint64_t &b)
+{
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = static_cast<__uint128_t>(a) * b;
+  a             = static_cast<uint64_t>(r);
+  b             = static_cast<uint64_t>(r >> 64);
+#elif STX_CFG(COMPILER, MSVC) && STX_CFG(ARCH, X86_64)
+  if (__builtin_is_constant_evaluated())
+  {
+    wyhash_mum_portable(a, b);
+  }
+  else
+  {
+    a = _umul128(a, b, &b);
+  }
+#else
+  wyhash_mum_portable(a, b);
+#endif
+}
+
+constexpr uint64_t wyhash_mix(uint64_t a, uint64_t b)
+{
+  wyhash_mum(a, b);
+  return a ^ b;
+}
+
+// the reads are little-endian on all targets so the hashes are the same at
+// compile time and at runtime. they compile to single loads on little-endian
+// targets.
+template <typename Byte>
+constexpr uint64_t wyhash_read(Byte const *p, size_t count)
+{
+  uint64_t v = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    v |= static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (i * 8);
+  }
+  return v;
+}
+
+template <typename Byte>
+constexpr uint64_t wyhash_read8(Byte const *p)
+{
+  return wyhash_read(p, 8);
+}
+
+template <typename Byte>
+constexpr uint64_t wyhash_read4(Byte const *p)
+{
+  return wyhash_read(p, 4);
+}
+
+template <typename Byte>
+constexpr uint64_t wyhash_read3(Byte const *p, size_t k)
+{
+  return (static_cast<uint64_t>(static_cast<uint8_t>(p[0])) << 16) | (static_cast<uint64_t>(static_cast<uint8_t>(p[k >> 1])) << 8) | static_cast<uint8_t>(p[k - 1]);
+}
+
+template <typename Byte>
+constexpr HashValue wyhash(Byte const *p, size_t size, uint64_t seed)
+{
+  seed ^= wyhash_mix(seed ^ WYHASH_SECRET[0], WYHASH_SECRET[1]);
+
+  uint64_t a = 0;
+  uint64_t b = 0;
+
+  if (size <= 16)
+  {
+    if (size >= 4)
+    {
+      a = (wyhash_read4(p) << 32) | wyhash_read4(p + ((size >> 3) << 2));
+      b = (wyhash_read4(p + size - 4) << 32) | wyhash_read4(p + size - 4 - ((size >> 3) << 2));
+    }
+    else if (size > 0)
+    {
+      a = wyhash_read3(p, size);
+      b = 0;
+    }
+  }
+  else
+  {
+    size_t i = size;
+
+    if (i > 48)
+    {
+      // three independent lanes keep the multipliers busy
+      uint64_t see1 = seed;
+      uint64_t see2 = seed;
+
+      do
+      {
+        seed = wyhash_mix(wyhash_read8(p) ^ WYHASH_SECRET[1], wyhash_read8(p + 8) ^ seed);
+        see1 = wyhash_mix(wyhash_read8(p + 16) ^ WYHASH_SECRET[2], wyhash_read8(p + 24) ^ see1);
+        see2 = wyhash_mix(wyhash_read8(p + 32) ^ WYHASH_SECRET[3], wyhash_read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+
+      seed ^= see1 ^ see2;
+    }
+
+    while (i > 16)
+    {
+      seed = wyhash_mix(wyhash_read8(p) ^ WYHASH_SECRET[1], wyhash_read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+
+    a = wyhash_read8(p + i - 16);
+    b = wyhash_read8(p + i - 8);
+  }
+
+  a ^= WYHASH_SECRET[1];
+  b ^= seed;
+
+  wyhash_mum(a, b);
+
+  return wyhash_mix(a ^ WYHASH_SECRET[0] ^ size, b ^ WYHASH_SECRET[1]);
+}
+
+}        // namespace impl
+
+namespace hash
+{
+
+/// hashes a sequence of bytes (wyhash)
+inline HashValue bytes(void const *data, size_t size, uint64_t seed = 0)
+{
+  return impl::wyhash(static_cast<uint8_t const *>(data), size, seed);
+}
+
+/// hashes the characters of `str`, equal to `bytes(str.data(), str.size())`.
+/// usable at compile time, i.e. to precompute the hashes of known keys.
+constexpr HashValue string(std::string_view str, uint64_t seed = 0)
+{
+  return impl::wyhash(str.data(), str.size(), seed);
+}
+
+/// mixes the bits of an integer so every bit of the input affects every bit
+/// of the output (murmur3's finalizer)
+constexpr HashValue integer(uint64_t value)
+{
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  value ^= value >> 33;
+  return value;
+}
+
+/// combines the hash of a value into the hash of the values before it. the
+/// result depends on the order of the values.
+constexpr HashValue combine(HashValue seed, HashValue value)
+{
+  return impl::wyhash_mix(seed ^ impl::WYHASH_SECRET[0], value ^ impl::WYHASH_SECRET[2]);
+}
+
+}        // namespace hash
+
+/// bytewise-hashable types are hashed as their bytes, and spans of them are
+/// hashed in bulk. specialize for structs whose bytes are their value: no
+/// padding, no floating-point values and no pointers or views to compare by
+/// what they refer to, i.e. composite keys such as
+/// `struct { uint32_t x; uint32_t y; }`.
+template <typename T>
+struct is_bytewise_hashable : std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>
+{};
+
+/// the default hash functor used by the hash containers.
+///
+/// specialize for custom key types.
+template <typename T, typename = void>
+struct Hash;
+
+template <typename T>
+struct Hash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+{
+  constexpr HashValue operator()(T value) const
+  {
+    return hash::integer(static_cast<uint64_t>(value));
+  }
+};
+
+template <typename T>
+struct Hash<T, std::enable_if_t<std::is_same_v<T, float> || std::is_same_v<T, double>>>
+{
+  HashValue operator()(T value) const
+  {
+    // +0.0 and -0.0 compare equal so they must hash equal
+    if (value == 0)
+    {
+      value = 0;
+    }
+
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+
+    return hash::integer(bits);
+  }
+};
+
+template <typename T>
+struct Hash<T *, void>
+{
+  HashValue operator()(T *value) const
+  {
+    return hash::integer(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+  }
+};
+
+template <>
+struct Hash<std::string_view, void>
+{
+  constexpr HashValue operator()(std::string_view value) const
+  {
+    return hash::string(value);
+  }
+};
+
+/// hashes the contents of the span. the elements are hashed as bytes if they
+/// are bytewise-hashable (see `is_bytewise_hashable`), and with their `Hash`
+/// otherwise.
+template <typename T>
+struct Hash<Span<T>, void>
+{
+  HashValue operator()(Span<T> span) const
+  {
+    using Element = std::remove_cv_t<T>;
+
+    if constexpr (is_bytewise_hashable<Element>::value)
+    {
+      static_assert(std::has_unique_object_representations_v<Element>, "bytewise-hashable types must not have padding");
+
+      return hash::bytes(span.data(), span.size_bytes());
+    }
+    else
+    {
+      HashValue value = hash::integer(span.size());
+
+      for (T &element : span)
+      {
+        value = hash::combine(value, Hash<Element>{}(element));
+      }
+
+      return value;
+    }
+  }
+};
+
+/// hashes the bytes of the structs marked bytewise-hashable, see
+/// `is_bytewise_hashable`.
+template <typename T>
+struct Hash<T, std::enable_if_t<std::is_class_v<T> && is_bytewise_hashable<T>::value>>
+{
+  static_assert(std::has_unique_object_representations_v<T>, "bytewise-hashable types must not have padding");
+
+  HashValue operator()(T const &value) const
+  {
+    return hash::bytes(&value, sizeof(T));
+  }
+};
+
+/// Hasher hashes a sequence of values incrementally, i.e. the fields of a
+/// struct.
+///
+/// ```cpp
+/// HashValue operator()(Request const &request) const
+/// {
+///   return Hasher{}.write_str(request.path).write_integer(request.method).finish();
+/// }
+/// ```
+///
+/// the hash depends on the values and the order they are written in, not on
+/// how they are split: writing "ab" then "c" differs from writing "abc".
+///
+struct Hasher
+{
+  constexpr Hasher() = default;
+
+  explicit constexpr Hasher(uint64_t seed) :
+      state_{seed}
+  {}
+
+  Hasher &write_bytes(void const *data, size_t size)
+  {
+    state_ = hash::combine(state_, hash::bytes(data, size));
+    return *this;
+  }
+
+  constexpr Hasher &write_str(std::string_view str)
+  {
+    state_ = hash::combine(state_, hash::string(str));
+    return *this;
+  }
+
+  constexpr Hasher &write_integer(uint64_t value)
+  {
+    state_ = hash::combine(state_, value);
+    return *this;
+  }
+
+  /// writes the hash of `value`, using its `Hash` specialization
+  template <typename T>
+  Hasher &write(T const &value)
+  {
+    state_ = hash::combine(state_, Hash<T>{}(value));
+    return *this;
+  }
+
+  constexpr HashValue finish() const
+  {
+    return hash::integer(state_);
+  }
+
+  uint64_t state_ = 0;
+};
+
+STX_END_NAMESPACE
@@ -0,0 +1,733 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstring>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/bit.h"
+#include "stx/config.h"
+#include "stx/hash.h"
+#include "stx/memory.h"
+#include "stx/option.h"
+#include "stx/relocate.h"
+#include "stx/result.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+#if STX_CFG(SIMD, SSE2)
+#  include <emmintrin.h>
+#endif
+
+STX_BEGIN_NAMESPACE
+
+namespace impl
+{
+
+// control bytes of the hash table's slots.
+//
+// a full slot's control byte holds the 7 low bits of its key's hash (h2), so
+// the high bit is never set for full slots.
+using HashCtrl = int8_t;
+
+constexpr HashCtrl HASH_CTRL_EMPTY   = -128;
+constexpr HashCtrl HASH_CTRL_DELETED = -2;
+
+// number of control bytes matched at once
+constexpr size_t HASH_GROUP_WIDTH = 16;
+
+// minimum capacity of a non-empty table
+constexpr size_t HASH_MIN_CAPACITY = HASH_GROUP_WIDTH;
+
+// a group of control bytes. the matchers return a bitmask in which bit `i` is
+// set if the `i`th control byte of the group matched.
+struct HashGroup
+{
+#if STX_CFG(SIMD, SSE2)
+  explicit HashGroup(HashCtrl const *ctrl) :
+      ctrl_{_mm_loadu_si128(reinterpret_cast<__m128i const *>(ctrl))}
+  {}
+
+  uint32_t match(HashCtrl h2) const
+  {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+  }
+
+  uint32_t match_empty() const
+  {
+    return match(HASH_CTRL_EMPTY);
+  }
+
+  // empty and deleted slots are the only ones with the high bit set
+  uint32_t match_empty_or_deleted() const
+  {
+    return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_));
+  }
+
+  __m128i ctrl_;
+#else
+  explicit HashGroup(HashCtrl const *ctrl)
+  {
+    std::memcpy(ctrl_, ctrl, HASH_GROUP_WIDTH);
+  }
+
+  uint32_t match(HashCtrl h2) const
+  {
+    uint32_t mask = 0;
+
+    for (uint32_t i = 0; i < HASH_GROUP_WIDTH; i++)
+    {
+      mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+    }
+
+    return mask;
+  }
+
+  uint32_t match_empty() const
+  {
+    return match(HASH_CTRL_EMPTY);
+  }
+
+  uint32_t match_empty_or_deleted() const
+  {
+    uint32_t mask = 0;
+
+    for (uint32_t i = 0; i < HASH_GROUP_WIDTH; i++)
+    {
+      mask |= static_cast<uint32_t>(ctrl_[i] < 0) << i;
+    }
+
+    return mask;
+  }
+
+  HashCtrl ctrl_[HASH_GROUP_WIDTH];
+#endif
+};
+
+// maximum number of elements the table can hold before growing (7/8 load
+// factor)
+constexpr size_t hash_table_max_load(size_t capacity)
+{
+  return capacity - capacity / 8;
+}
+
+// smallest valid capacity that can hold `size` elements
+constexpr size_t hash_table_capacity_for(size_t size)
+{
+  size_t capacity = HASH_MIN_CAPACITY;
+
+  while (hash_table_max_load(capacity) < size)
+  {
+    capacity <<= 1;
+  }
+
+  return capacity;
+}
+
+// open-addressing hash table with SIMD-probed control bytes (swiss table).
+//
+// the slots and their control bytes are stored in a single allocation:
+// `[entries: capacity][control bytes: capacity + HASH_GROUP_WIDTH]`. the
+// trailing control bytes mirror the first `HASH_GROUP_WIDTH` control bytes so
+// a group can be loaded at any slot position without wrapping around.
+//
+// the table is probed in groups using triangular probing over the
+// power-of-two capacity which visits every group.
+//
+template <typename Entry, typename Key, typename KeyOf, typename Hasher>
+struct HashTable
+{
+  using Size  = size_t;
+  using Index = size_t;
+
+  explicit HashTable(Allocator allocator) :
+      memory_{Memory{allocator, nullptr}}, size_{0}, capacity_{0}, growth_left_{0}, hasher_{}
+  {}
+
+  HashTable(HashTable &&other) :
+      memory_{std::move(other.memory_)},
+      size_{other.size_},
+      capacity_{other.capacity_},
+      growth_left_{other.growth_left_},
+      hasher_{std::move(other.hasher_)}
+  {
+    other.memory_.allocator = memory_.allocator;
+    other.memory_.handle    = nullptr;
+    other.size_             = 0;
+    other.capacity_         = 0;
+    other.growth_left_      = 0;
+  }
+
+  HashTable &operator=(HashTable &&other)
+  {
+    std::swap(memory_, other.memory_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hasher_, other.hasher_);
+
+    return *this;
+  }
+
+  STX_DISABLE_COPY(HashTable)
+
+  ~HashTable()
+  {
+    destruct_entries();
+  }
+
+  Entry *entries() const
+  {
+    return static_cast<Entry *>(memory_.handle);
+  }
+
+  HashCtrl *ctrl() const
+  {
+    return reinterpret_cast<HashCtrl *>(static_cast<uint8_t *>(memory_.handle) + capacity_ * sizeof(Entry));
+  }
+
+  bool is_full(Index index) const
+  {
+    return ctrl()[index] >= 0;
+  }
+
+  Option<Index> find(Key const &key) const
+  {
+    if (capacity_ == 0)
+    {
+      return None;
+    }
+
+    HashValue const hash  = hasher_(key);
+    HashCtrl const  h2    = static_cast<HashCtrl>(hash & 0x7F);
+    Size const      mask  = capacity_ - 1;
+    Index           pos   = static_cast<Index>(hash >> 7) & mask;
+    Size            probe = 0;
+
+    while (true)
+    {
+      HashGroup group{ctrl() + pos};
+
+      for (uint32_t matches = group.match(h2); matches != 0; matches &= matches - 1)
+      {
+        Index index = (pos + count_trailing_zeros(matches)) & mask;
+
+        if (KeyOf{}(entries()[index]) == key)
+        {
+          return Some(Index{index});
+        }
+      }
+
+      if (group.match_empty() != 0)
+      {
+        return None;
+      }
+
+      probe += HASH_GROUP_WIDTH;
+      pos = (pos + probe) & mask;
+    }
+  }
+
+  // first empty or deleted slot on the probe sequence of `hash`. there is
+  // always at least one empty slot since the load factor is below 1.
+  Index find_insert_slot(HashValue hash) const
+  {
+    Size const mask  = capacity_ - 1;
+    Index      pos   = static_cast<Index>(hash >> 7) & mask;
+    Size       probe = 0;
+
+    while (true)
+    {
+      uint32_t matches = HashGroup{ctrl() + pos}.match_empty_or_deleted();
+
+      if (matches != 0)
+      {
+        return (pos + count_trailing_zeros(matches)) & mask;
+      }
+
+      probe += HASH_GROUP_WIDTH;
+      pos = (pos + probe) & mask;
+    }
+  }
+
+  void set_ctrl(Index index, HashCtrl value)
+  {
+    HashCtrl *control = ctrl();
+
+    control[index] = value;
+
+    if (index < HASH_GROUP_WIDTH)
+    {
+      control[capacity_ + index] = value;
+    }
+  }
+
+  // reserves an uninitialized slot for an element with `key` which must not
+  // already be in the table. the caller must construct the entry in the
+  // slot.
+  //
+  // returns the error if memory allocation fails
+  //
+  Result<Index, AllocError> prepare_insert(Key const &key)
+  {
+    if (capacity_ == 0)
+    {
+      TRY_OK(ok, rehash(HASH_MIN_CAPACITY));
+      (void) ok;
+    }
+
+    HashValue const hash  = hasher_(key);
+    Index           index = find_insert_slot(hash);
+
+    if (growth_left_ == 0 && ctrl()[index] == HASH_CTRL_EMPTY)
+    {
+      // grow if the table is more than half full, otherwise just purge the
+      // deleted slots
+      Size new_capacity = size_ + 1 > hash_table_max_load(capacity_) / 2 ? capacity_ * 2 : capacity_;
+
+      TRY_OK(ok, rehash(new_capacity));
+      (void) ok;
+
+      index = find_insert_slot(hash);
+    }
+
+    if (ctrl()[index] == HASH_CTRL_EMPTY)
+    {
+      growth_left_--;
+    }
+
+    set_ctrl(index, static_cast<HashCtrl>(hash & 0x7F));
+    size_++;
+
+    return Ok(Index{index});
+  }
+
+  void erase_at(Index index)
+  {
+    impl::destruct_range(entries() + index, 1);
+    set_ctrl(index, HASH_CTRL_DELETED);
+    size_--;
+  }
+
+  Result<Void, AllocError> reserve(Size size)
+  {
+    Size new_capacity = hash_table_capacity_for(size);
+
+    if (new_capacity <= capacity_)
+    {
+      return Ok(Void{});
+    }
+
+    return rehash(new_capacity);
+  }
+
+  // moves all the entries into a new table of `new_capacity` slots
+  Result<Void, AllocError> rehash(Size new_capacity)
+  {
+    Size const alloc_size = new_capacity * sizeof(Entry) + new_capacity + HASH_GROUP_WIDTH;
+
+    TRY_OK(new_memory, mem::allocate(memory_.allocator, alloc_size));
+
+    HashTable new_table{memory_.allocator};
+
+    new_table.memory_      = std::move(new_memory);
+    new_table.capacity_    = new_capacity;
+    new_table.growth_left_ = hash_table_max_load(new_capacity);
+
+    std::memset(new_table.ctrl(), static_cast<uint8_t>(HASH_CTRL_EMPTY), new_capacity + HASH_GROUP_WIDTH);
+
+    for (Index index = 0; index < capacity_; index++)
+    {
+      if (is_full(index))
+      {
+        Entry          *entry     = entries() + index;
+        HashValue const hash      = hasher_(KeyOf{}(*entry));
+        Index const     new_index = new_table.find_insert_slot(hash);
+
+        new_table.set_ctrl(new_index, static_cast<HashCtrl>(hash & 0x7F));
+        impl::relocate_range(entry, 1, new_table.entries() + new_index);
+      }
+    }
+
+    new_table.size_         = size_;
+    new_table.growth_left_ -= size_;
+
+    // the entries have been relocated, the old table must not destroy them
+    size_     = 0;
+    capacity_ = 0;
+
+    *this = std::move(new_table);
+
+    return Ok(Void{});
+  }
+
+  void destruct_entries()
+  {
+    if constexpr (!std::is_trivially_destructible_v<Entry>)
+    {
+      for (Index index = 0; index < capacity_; index++)
+      {
+        if (is_full(index))
+        {
+          (entries() + index)->~Entry();
+        }
+      }
+    }
+  }
+
+  // capacity is unchanged
+  void clear()
+  {
+    destruct_entries();
+
+    if (capacity_ != 0)
+    {
+      std::memset(ctrl(), static_cast<uint8_t>(HASH_CTRL_EMPTY), capacity_ + HASH_GROUP_WIDTH);
+    }
+
+    size_        = 0;
+    growth_left_ = hash_table_max_load(capacity_);
+  }
+
+  Memory memory_;
+  Size   size_        = 0;
+  Size   capacity_    = 0;
+  Size   growth_left_ = 0;
+  Hasher hasher_;
+};
+
+// iterates over the full slots of a hash table
+template <typename Entry>
+struct HashTableIterator
+{
+  Entry &operator*() const
+  {
+    return *entry_;
+  }
+
+  Entry *operator->() const
+  {
+    return entry_;
+  }
+
+  HashTableIterator &operator++()
+  {
+    ctrl_++;
+    entry_++;
+    skip_empty();
+    return *this;
+  }
+
+  bool operator==(HashTableIterator const &other) const
+  {
+    return entry_ == other.entry_;
+  }
+
+  bool operator!=(HashTableIterator const &other) const
+  {
+    return entry_ != other.entry_;
+  }
+
+  void skip_empty()
+  {
+    while (entry_ < end_ && *ctrl_ < 0)
+    {
+      ctrl_++;
+      entry_++;
+    }
+  }
+
+  HashCtrl const *ctrl_  = nullptr;
+  Entry          *entry_ = nullptr;
+  Entry          *end_   = nullptr;
+};
+
+template <typename Entry, typename Table>
+HashTableIterator<Entry> hash_table_begin(Table const &table)
+{
+  HashTableIterator<Entry> iter{table.ctrl(), table.entries(), table.entries() + table.capacity_};
+  iter.skip_empty();
+  return iter;
+}
+
+template <typename Entry, typename Table>
+HashTableIterator<Entry> hash_table_end(Table const &table)
+{
+  Entry *end = table.entries() + table.capacity_;
+  return HashTableIterator<Entry>{nullptr, end, end};
+}
+
+template <typename K, typename V>
+struct HashMapKeyOf;
+
+template <typename K>
+struct HashSetKeyOf
+{
+  constexpr K const &operator()(K const &key) const
+  {
+    return key;
+  }
+};
+
+}        // namespace impl
+
+template <typename K, typename V>
+struct HashMapEntry
+{
+  K key;
+  V value;
+
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(HashMapEntry, is_trivially_relocatable<K> && is_trivially_relocatable<V>)
+};
+
+namespace impl
+{
+
+template <typename K, typename V>
+struct HashMapKeyOf
+{
+  constexpr K const &operator()(HashMapEntry<K, V> const &entry) const
+  {
+    return entry.key;
+  }
+};
+
+}        // namespace impl
+
+// HashMap is an open-addressing (swiss-table) hash map.
+//
+// the entries are stored inline in a single allocation along with one control
+// byte per slot. lookups compare 16 control bytes at once (using SIMD where
+// available) and only touch the entries whose control bytes match the key's
+// hash.
+//
+// the allocator must be alive for the lifetime of the HashMap.
+//
+// ONLY NON-CONST METHODS INVALIDATE ITERATORS AND REFERENCES
+//
+template <typename K, typename V, typename Hasher = Hash<K>>
+struct HashMap
+{
+  static_assert(!std::is_reference_v<K> && !std::is_reference_v<V>);
+
+  using Size     = size_t;
+  using Entry    = HashMapEntry<K, V>;
+  using Iterator = impl::HashTableIterator<Entry>;
+
+  HashMap() :
+      table_{os_allocator}
+  {}
+
+  explicit HashMap(Allocator allocator) :
+      table_{allocator}
+  {}
+
+  STX_DEFAULT_MOVE(HashMap)
+  STX_DISABLE_COPY(HashMap)
+  STX_DEFAULT_DESTRUCTOR(HashMap)
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(HashMap, is_trivially_relocatable<Hasher>)
+
+  Size size() const
+  {
+    return table_.size_;
+  }
+
+  Size capacity() const
+  {
+    return table_.capacity_;
+  }
+
+  bool is_empty() const
+  {
+    return table_.size_ == 0;
+  }
+
+  bool contains(K const &key) const
+  {
+    return table_.find(key).is_some();
+  }
+
+  Option<Ref<V>> get(K const &key) const
+  {
+    Option<size_t> index = table_.find(key);
+
+    if (index.is_none())
+    {
+      return None;
+    }
+
+    return Some<Ref<V>>(table_.entries()[index.value()].value);
+  }
+
+  // inserts the value or replaces the value of an existing entry with `key`.
+  //
+  // invalidates references
+  //
+  // the key and value are not moved if an allocation error occurs
+  Result<Void, AllocError> insert(K &&key, V &&value)
+  {
+    Option<size_t> index = table_.find(key);
+
+    if (index.is_some())
+    {
+      table_.entries()[index.value()].value = std::move(value);
+      return Ok(Void{});
+    }
+
+    TRY_OK(new_index, table_.prepare_insert(key));
+
+    new (table_.entries() + new_index) Entry{std::move(key), std::move(value)};
+
+    return Ok(Void{});
+  }
+
+  // removes the entry with `key` and returns its value, if any
+  Option<V> remove(K const &key)
+  {
+    Option<size_t> index = table_.find(key);
+
+    if (index.is_none())
+    {
+      return None;
+    }
+
+    Option<V> value = Some(std::move(table_.entries()[index.value()].value));
+
+    table_.erase_at(index.value());
+
+    return value;
+  }
+
+  // reserve enough memory to contain at least `size` entries without
+  // rehashing
+  Result<Void, AllocError> reserve(Size size)
+  {
+    return table_.reserve(size);
+  }
+
+  // capacity is unchanged
+  void clear()
+  {
+    table_.clear();
+  }
+
+  Iterator begin() const
+  {
+    return impl::hash_table_begin<Entry>(table_);
+  }
+
+  Iterator end() const
+  {
+    return impl::hash_table_end<Entry>(table_);
+  }
+
+  impl::HashTable<Entry, K, impl::HashMapKeyOf<K, V>, Hasher> table_;
+};
+
+// HashSet is an open-addressing (swiss-table) hash set. see `HashMap`.
+//
+// the keys must not be modified through the iterators.
+//
+template <typename K, typename Hasher = Hash<K>>
+struct HashSet
+{
+  static_assert(!std::is_reference_v<K>);
+
+  using Size     = size_t;
+  using Iterator = impl::HashTableIterator<K const>;
+
+  HashSet() :
+      table_{os_allocator}
+  {}
+
+  explicit HashSet(Allocator allocator) :
+      table_{allocator}
+  {}
+
+  STX_DEFAULT_MOVE(HashSet)
+  STX_DISABLE_COPY(HashSet)
+  STX_DEFAULT_DESTRUCTOR(HashSet)
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(HashSet, is_trivially_relocatable<Hasher>)
+
+  Size size() const
+  {
+    return table_.size_;
+  }
+
+  Size capacity() const
+  {
+    return table_.capacity_;
+  }
+
+  bool is_empty() const
+  {
+    return table_.size_ == 0;
+  }
+
+  bool contains(K const &key) const
+  {
+    return table_.find(key).is_some();
+  }
+
+  // inserts the key if it is not already in the set
+  //
+  // invalidates references
+  //
+  // the key is not moved if an allocation error occurs
+  Result<Void, AllocError> insert(K &&key)
+  {
+    if (contains(key))
+    {
+      return Ok(Void{});
+    }
+
+    TRY_OK(index, table_.prepare_insert(key));
+
+    new (table_.entries() + index) K{std::move(key)};
+
+    return Ok(Void{});
+  }
+
+  // returns true if the key was in the set
+  bool remove(K const &key)
+  {
+    Option<size_t> index = table_.find(key);
+
+    if (index.is_none())
+    {
+      return false;
+    }
+
+    table_.erase_at(index.value());
+
+    return true;
+  }
+
+  // reserve enough memory to contain at least `size` keys without rehashing
+  Result<Void, AllocError> reserve(Size size)
+  {
+    return table_.reserve(size);
+  }
+
+  // capacity is unchanged
+  void clear()
+  {
+    table_.clear();
+  }
+
+  Iterator begin() const
+  {
+    return impl::hash_table_begin<K const>(table_);
+  }
+
+  Iterator end() const
+  {
+    return impl::hash_table_end<K const>(table_);
+  }
+
+  impl::HashTable<K, K, impl::HashSetKeyOf<K>, Hasher> table_;
+};
+
+STX_END_NAMESPACE
@@ -0,0 +1,551 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/struct.h"
+
+STX_BEGIN_NAMESPACE
+
+// Intrusive linked lists.
+//
+// the links are stored in a hook embedded in the element type, so linking an
+// element never allocates. the lists don't own their elements: the elements
+// must outlive their membership and be unlinked before they are destroyed. an
+// element can only be in one list per hook at a time.
+//
+// ```cpp
+// struct Task
+// {
+//   SListHook<Task> hook;
+//   ...
+// };
+//
+// IntrusiveSList<Task, &Task::hook> tasks;
+// ```
+
+template <typename T>
+struct SListHook
+{
+  T *next = nullptr;
+};
+
+template <typename T>
+struct ListHook
+{
+  T *prev = nullptr;
+  T *next = nullptr;
+};
+
+template <typename T, SListHook<T> T::*Hook>
+struct IntrusiveSListIterator
+{
+  using iterator_category = std::forward_iterator_tag;
+  using value_type        = T;
+  using difference_type   = ptrdiff_t;
+  using pointer           = T *;
+  using reference         = T &;
+
+  T &operator*() const
+  {
+    return *node;
+  }
+
+  T *operator->() const
+  {
+    return node;
+  }
+
+  IntrusiveSListIterator &operator++()
+  {
+    node = (node->*Hook).next;
+    return *this;
+  }
+
+  bool operator==(IntrusiveSListIterator const &other) const
+  {
+    return node == other.node;
+  }
+
+  bool operator!=(IntrusiveSListIterator const &other) const
+  {
+    return node != other.node;
+  }
+
+  T *node = nullptr;
+};
+
+template <typename T, ListHook<T> T::*Hook>
+struct IntrusiveListIterator
+{
+  using iterator_category = std::forward_iterator_tag;
+  using value_type        = T;
+  using difference_type   = ptrdiff_t;
+  using pointer           = T *;
+  using reference         = T &;
+
+  T &operator*() const
+  {
+    return *node;
+  }
+
+  T *operator->() const
+  {
+    return node;
+  }
+
+  IntrusiveListIterator &operator++()
+  {
+    node = (node->*Hook).next;
+    return *this;
+  }
+
+  bool operator==(IntrusiveListIterator const &other) const
+  {
+    return node == other.node;
+  }
+
+  bool operator!=(IntrusiveListIterator const &other) const
+  {
+    return node != other.node;
+  }
+
+  T *node = nullptr;
+};
+
+// IntrusiveSList is a singly-linked list with O(1) insertion at both ends and
+// removal at the front. i.e. a FIFO queue.
+template <typename T, SListHook<T> T::*Hook>
+struct IntrusiveSList
+{
+  using Iterator = IntrusiveSListIterator<T, Hook>;
+
+  IntrusiveSList() = default;
+
+  IntrusiveSList(IntrusiveSList &&other) :
+      head_{other.head_}, tail_{other.tail_}
+  {
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+  }
+
+  IntrusiveSList &operator=(IntrusiveSList &&other)
+  {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    return *this;
+  }
+
+  STX_DISABLE_COPY(IntrusiveSList)
+  STX_DEFAULT_DESTRUCTOR(IntrusiveSList)
+
+  bool is_empty() const
+  {
+    return head_ == nullptr;
+  }
+
+  Option<Ref<T>> front() const
+  {
+    if (head_ == nullptr)
+    {
+      return None;
+    }
+
+    return Some<Ref<T>>(*head_);
+  }
+
+  Option<Ref<T>> back() const
+  {
+    if (tail_ == nullptr)
+    {
+      return None;
+    }
+
+    return Some<Ref<T>>(*tail_);
+  }
+
+  void push_front(T &node)
+  {
+    (node.*Hook).next = head_;
+    head_             = &node;
+
+    if (tail_ == nullptr)
+    {
+      tail_ = &node;
+    }
+  }
+
+  void push_back(T &node)
+  {
+    (node.*Hook).next = nullptr;
+
+    if (tail_ == nullptr)
+    {
+      head_ = &node;
+    }
+    else
+    {
+      (tail_->*Hook).next = &node;
+    }
+
+    tail_ = &node;
+  }
+
+  Option<Ref<T>> pop_front()
+  {
+    if (head_ == nullptr)
+    {
+      return None;
+    }
+
+    T *node = head_;
+    head_   = (node->*Hook).next;
+
+    if (head_ == nullptr)
+    {
+      tail_ = nullptr;
+    }
+
+    (node->*Hook).next = nullptr;
+
+    return Some<Ref<T>>(*node);
+  }
+
+  // moves all the elements of `other` to the back of this list
+  void append(IntrusiveSList &&other)
+  {
+    if (other.head_ == nullptr)
+    {
+      return;
+    }
+
+    if (tail_ == nullptr)
+    {
+      head_ = other.head_;
+    }
+    else
+    {
+      (tail_->*Hook).next = other.head_;
+    }
+
+    tail_       = other.tail_;
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+  }
+
+  // unlinks all the elements, O(1). the elements' hooks are left dangling.
+  void clear()
+  {
+    head_ = nullptr;
+    tail_ = nullptr;
+  }
+
+  Iterator begin() const
+  {
+    return Iterator{head_};
+  }
+
+  Iterator end() const
+  {
+    return Iterator{nullptr};
+  }
+
+  T *head_ = nullptr;
+  T *tail_ = nullptr;
+};
+
+// IntrusiveList is a doubly-linked list with O(1) insertion and removal at
+// both ends and O(1) removal of any element.
+template <typename T, ListHook<T> T::*Hook>
+struct IntrusiveList
+{
+  using Iterator = IntrusiveListIterator<T, Hook>;
+
+  IntrusiveList() = default;
+
+  IntrusiveList(IntrusiveList &&other) :
+      head_{other.head_}, tail_{other.tail_}
+  {
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+  }
+
+  IntrusiveList &operator=(IntrusiveList &&other)
+  {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    return *this;
+  }
+
+  STX_DISABLE_COPY(IntrusiveList)
+  STX_DEFAULT_DESTRUCTOR(IntrusiveList)
+
+  bool is_empty() const
+  {
+    return head_ == nullptr;
+  }
+
+  Option<Ref<T>> front() const
+  {
+    if (head_ == nullptr)
+    {
+      return None;
+    }
+
+    return Some<Ref<T>>(*head_);
+  }
+
+  Option<Ref<T>> back() const
+  {
+    if (tail_ == nullptr)
+    {
+      return None;
+    }
+
+    return Some<Ref<T>>(*tail_);
+  }
+
+  void push_front(T &node)
+  {
+    (node.*Hook).prev = nullptr;
+    (node.*Hook).next = head_;
+
+    if (head_ == nullptr)
+    {
+      tail_ = &node;
+    }
+    else
+    {
+      (head_->*Hook).prev = &node;
+    }
+
+    head_ = &node;
+  }
+
+  void push_back(T &node)
+  {
+    (node.*Hook).prev = tail_;
+    (node.*Hook).next = nullptr;
+
+    if (tail_ == nullptr)
+    {
+      head_ = &node;
+    }
+    else
+    {
+      (tail_->*Hook).next = &node;
+    }
+
+    tail_ = &node;
+  }
+
+  // inserts `node` before `position`, which must be in this list
+  void insert_before(T &position, T &node)
+  {
+    T *prev = (position.*Hook).prev;
+
+    (node.*Hook).prev     = prev;
+    (node.*Hook).next     = &position;
+    (position.*Hook).prev = &node;
+
+    if (prev == nullptr)
+    {
+      head_ = &node;
+    }
+    else
+    {
+      (prev->*Hook).next = &node;
+    }
+  }
+
+  // unlinks `node`, which must be in this list
+  void remove(T &node)
+  {
+    T *prev = (node.*Hook).prev;
+    T *next = (node.*Hook).next;
+
+    if (prev == nullptr)
+    {
+      head_ = next;
+    }
+    else
+    {
+      (prev->*Hook).next = next;
+    }
+
+    if (next == nullptr)
+    {
+      tail_ = prev;
+    }
+    else
+    {
+      (next->*Hook).prev = prev;
+    }
+
+    (node.*Hook).prev = nullptr;
+    (node.*Hook).next = nullptr;
+  }
+
+  Option<Ref<T>> pop_front()
+  {
+    if (head_ == nullptr)
+    {
+      return None;
+    }
+
+    T *node = head_;
+    remove(*node);
+
+    return Some<Ref<T>>(*node);
+  }
+
+  Option<Ref<T>> pop_back()
+  {
+    if (tail_ == nullptr)
+    {
+      return None;
+    }
+
+    T *node = tail_;
+    remove(*node);
+
+    return Some<Ref<T>>(*node);
+  }
+
+  // unlinks all the elements, O(1). the elements' hooks are left dangling.
+  void clear()
+  {
+    head_ = nullptr;
+    tail_ = nullptr;
+  }
+
+  Iterator begin() const
+  {
+    return Iterator{head_};
+  }
+
+  Iterator end() const
+  {
+    return Iterator{nullptr};
+  }
+
+  T *head_ = nullptr;
+  T *tail_ = nullptr;
+};
+
+// TreiberStack is a lock-free intrusive LIFO stack.
+//
+// any thread can `push`. `pop` and `pop_all` must only be called by one
+// consumer at a time: a node taken by another consumer's `pop` or `pop_all`
+// could be pushed back while `pop` is reading it, and `pop` would then replace
+// the head with a stale next pointer (the ABA problem). the consumer doesn't
+// have to be the same thread throughout, i.e. consumers serialized by a lock.
+//
+template <typename T, SListHook<T> T::*Hook>
+struct TreiberStack
+{
+  STX_MAKE_PINNED(TreiberStack)
+
+  TreiberStack() = default;
+
+  bool is_empty() const
+  {
+    return head_.load(std::memory_order_relaxed) == nullptr;
+  }
+
+  void push(T &node)
+  {
+    T *head = head_.load(std::memory_order_relaxed);
+
+    do
+    {
+      (node.*Hook).next = head;
+    } while (!head_.compare_exchange_weak(head, &node, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  // the most recently pushed node. single consumer only.
+  Option<Ref<T>> pop()
+  {
+    T *head = head_.load(std::memory_order_acquire);
+
+    while (head != nullptr && !head_.compare_exchange_weak(head, (head->*Hook).next, std::memory_order_acquire, std::memory_order_acquire))
+    {
+    }
+
+    if (head == nullptr)
+    {
+      return None;
+    }
+
+    (head->*Hook).next = nullptr;
+
+    return Some<Ref<T>>(*head);
+  }
+
+  // takes all the nodes, in the order they were pushed. single consumer only.
+  IntrusiveSList<T, Hook> pop_all()
+  {
+    T *node = head_.exchange(nullptr, std::memory_order_acquire);
+
+    IntrusiveSList<T, Hook> list;
+
+    while (node != nullptr)
+    {
+      T *next = (node->*Hook).next;
+      list.push_front(*node);
+      node = next;
+    }
+
+    return list;
+  }
+
+  std::atomic<T *> head_{nullptr};
+};
+
+// MpscQueue is a lock-free intrusive multi-producer single-consumer FIFO
+// queue.
+//
+// producers push onto a `TreiberStack`. the consumer takes the whole stack at
+// once when its private list runs out and reverses it into push order, so
+// both ends are O(1) amortized and the consumer never contends with the
+// producers for individual nodes.
+//
+template <typename T, SListHook<T> T::*Hook>
+struct MpscQueue
+{
+  STX_MAKE_PINNED(MpscQueue)
+
+  MpscQueue() = default;
+
+  // any thread
+  void push(T &node)
+  {
+    incoming_.push(node);
+  }
+
+  // consumer thread only
+  Option<Ref<T>> pop()
+  {
+    if (pending_.is_empty())
+    {
+      pending_ = incoming_.pop_all();
+    }
+
+    return pending_.pop_front();
+  }
+
+  // consumer thread only
+  bool is_empty() const
+  {
+    return pending_.is_empty() && incoming_.is_empty();
+  }
+
+  TreiberStack<T, Hook>   incoming_;
+  IntrusiveSList<T, Hook> pending_;
+};
+
+STX_END_NAMESPACE
@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+// Lazy, fused iterator adapters.
+//
+// ```cpp
+// Result<Vec<int>, AllocError> squares =
+//     span.iter()
+//         .filter([](int x) { return x % 2 == 0; })
+//         .map([](int x) { return x * x; })
+//         .take(16)
+//         .collect(allocator);
+// ```
+//
+// each adapter wraps its source and pushes the items into the next stage
+// through a sink callable. since the whole pipeline is a nest of inlined
+// lambdas, the compiler fuses it into a single loop over the span with no
+// intermediate buffers. a sink returns false to stop the iteration early
+// (i.e. `take`).
+//
+// the callables are stored by value in the adapters.
+//
+namespace impl
+{
+
+// the item type stored when an item must outlive the sink call. references to
+// elements are kept as references, temporaries are stored by value.
+template <typename Item>
+using IterStoredItem = std::conditional_t<std::is_lvalue_reference_v<Item>, Item, std::remove_cv_t<std::remove_reference_t<Item>>>;
+
+template <typename T>
+struct SpanSource
+{
+  using Item = T &;
+
+  template <typename Sink>
+  constexpr bool run(Sink &&sink) const
+  {
+    for (size_t i = 0; i < span.size(); i++)
+    {
+      if (!sink(span.data()[i]))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  Span<T> span;
+};
+
+template <typename T>
+struct ChunksSource
+{
+  using Item = Span<T>;
+
+  template <typename Sink>
+  constexpr bool run(Sink &&sink) const
+  {
+    for (size_t offset = 0; offset < span.size(); offset += chunk_size)
+    {
+      if (!sink(Span<T>{span.data() + offset, std::min(chunk_size, span.size() - offset)}))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  Span<T> span;
+  size_t  chunk_size = 1;
+};
+
+template <typename T>
+struct WindowsSource
+{
+  using Item = Span<T>;
+
+  template <typename Sink>
+  constexpr bool run(Sink &&sink) const
+  {
+    if (window_size > span.size())
+    {
+      return true;
+    }
+
+    for (size_t offset = 0; offset + window_size <= span.size(); offset++)
+    {
+      if (!sink(Span<T>{span.data() + offset, window_size}))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  Span<T> span;
+  size_t  window_size = 1;
+};
+
+template <typename Source, typename Predicate>
+struct FilterSource
+{
+  using Item = typename Source::Item;
+
+  template <typename Sink>
+  constexpr bool run(Sink &&sink) const
+  {
+    return source.run([this, &sink](auto &&item) {
+      if (predicate(item))
+      {
+        return static_cast<bool>(sink(std::forward<decltype(item)>(item)));
+      }
+
+      return true;
+    });
+  }
+
+  Source    source;
+  Predicate predicate;
+};
+
+template <typename Source, typename Func>
+struct MapSource
+{
+  using Item = std::invoke_result_t<Func const &, typename Source::Item>;
+
+  template <typename Sink>
+  constexpr bool run(Sink &&sink) const
+  {
+    return source.run([this, &sink](auto &&item) { return static_cast<bool>(sink(func(std::forward<decltype(item)>(item)))); });
+  }
+
+  Source source;
+  Func   func;
+};
+
+template <typename Source>
+struct TakeSource
+{
+  using Item = typename Source::Item;
+
+  template <typename Sink>
+  constexpr bool run(Sink &&sink) const
+  {
+    if (count == 0)
+    {
+      return true;
+    }
+
+    size_t taken = 0;
+
+    return source.run([this, &sink, &taken](auto &&item) {
+      taken++;
+      return static_cast<bool>(sink(std::forward<decltype(item)>(item))) && taken < count;
+    });
+  }
+
+  Source source;
+  size_t count = 0;
+};
+
+template <typename Source>
+struct EnumerateSource
+{
+  using Item = std::pair<size_t, IterStoredItem<typename Source::Item>>;
+
+  template <typename Sink>
+  constexpr bool run(Sink &&sink) const
+  {
+    size_t index = 0;
+
+    return source.run([&sink, &index](auto &&item) { return static_cast<bool>(sink(Item{index++, std::forward<decltype(item)>(item)})); });
+  }
+
+  Source source;
+};
+
+template <typename Source, typename U>
+struct ZipSource
+{
+  using Item = std::pair<IterStoredItem<typename Source::Item>, U &>;
+
+  template <typename Sink>
+  constexpr bool run(Sink &&sink) const
+  {
+    size_t index = 0;
+
+    return source.run([this, &sink, &index](auto &&item) {
+      if (index >= other.size())
+      {
+        return false;
+      }
+
+      U &other_item = other.data()[index];
+      index++;
+
+      return static_cast<bool>(sink(Item{std::forward<decltype(item)>(item), other_item}));
+    });
+  }
+
+  Source  source;
+  Span<U> other;
+};
+
+}        // namespace impl
+
+template <typename Source>
+struct Iter
+{
+  // the type of the items passed down the pipeline
+  using Item = typename Source::Item;
+
+  // keeps the items that satisfy the predicate
+  template <typename Predicate>
+  constexpr Iter<impl::FilterSource<Source, Predicate>> filter(Predicate predicate) const
+  {
+    return Iter<impl::FilterSource<Source, Predicate>>{{source_, std::move(predicate)}};
+  }
+
+  // transforms each item
+  template <typename Func>
+  constexpr Iter<impl::MapSource<Source, Func>> map(Func func) const
+  {
+    return Iter<impl::MapSource<Source, Func>>{{source_, std::move(func)}};
+  }
+
+  // stops after `count` items
+  constexpr Iter<impl::TakeSource<Source>> take(size_t count) const
+  {
+    return Iter<impl::TakeSource<Source>>{{source_, count}};
+  }
+
+  // pairs each item with its index, as `std::pair<size_t, Item>`
+  constexpr Iter<impl::EnumerateSource<Source>> enumerate() const
+  {
+    return Iter<impl::EnumerateSource<Source>>{{source_}};
+  }
+
+  // pairs each item with the element of `other` at the same position, as
+  // `std::pair<Item, U &>`. stops at the end of the shorter sequence.
+  template <typename U>
+  constexpr Iter<impl::ZipSource<Source, U>> zip(Span<U> other) const
+  {
+    return Iter<impl::ZipSource<Source, U>>{{source_, other}};
+  }
+
+  template <typename Func>
+  constexpr void for_each(Func &&func) const
+  {
+    source_.run([&func](auto &&item) {
+      func(std::forward<decltype(item)>(item));
+      return true;
+    });
+  }
+
+  template <typename Init, typename Func>
+  constexpr Init fold(Init init, Func &&func) const
+  {
+    source_.run([&init, &func](auto &&item) {
+      init = func(std::move(init), std::forward<decltype(item)>(item));
+      return true;
+    });
+
+    return init;
+  }
+
+  constexpr size_t count() const
+  {
+    size_t count = 0;
+
+    source_.run([&count](auto &&) {
+      count++;
+      return true;
+    });
+
+    return count;
+  }
+
+  // collects the items into a new Vec. references to elements are copied.
+  //
+  // returns the error if memory allocation fails
+  Result<Vec<std::remove_cv_t<std::remove_reference_t<Item>>>, AllocError> collect(Allocator allocator) const
+  {
+    using Element = std::remove_cv_t<std::remove_reference_t<Item>>;
+
+    Vec<Element>       vec{allocator};
+    Option<AllocError> error;
+
+    source_.run([&vec, &error](auto &&item) {
+      Result<Void, AllocError> result = vec.push(Element{std::forward<decltype(item)>(item)});
+
+      if (result.is_err())
+      {
+        error = Some(std::move(result).unwrap_err());
+        return false;
+      }
+
+      return true;
+    });
+
+    if (error.is_some())
+    {
+      return Err(std::move(error).unwrap());
+    }
+
+    return Ok(std::move(vec));
+  }
+
+  Source source_;
+};
+
+template <typename T>
+constexpr Iter<impl::SpanSource<T>> Span<T>::iter() const
+{
+  return Iter<impl::SpanSource<T>>{{*this}};
+}
+
+template <typename T>
+constexpr Iter<impl::ChunksSource<T>> Span<T>::chunks(Size chunk_size) const
+{
+  STX_SPAN_ENSURE(chunk_size > 0, "chunk size must be non-zero");
+  return Iter<impl::ChunksSource<T>>{{*this, chunk_size}};
+}
+
+template <typename T>
+constexpr Iter<impl::WindowsSource<T>> Span<T>::windows(Size window_size) const
+{
+  STX_SPAN_ENSURE(window_size > 0, "window size must be non-zero");
+  return Iter<impl::WindowsSource<T>>{{*this, window_size}};
+}
+
+STX_END_NAMESPACE
@@ -3,6 +3,7 @@
 #include <utility>
 
 #include "stx/config.h"
+#include "stx/relocate.h"
 
 STX_BEGIN_NAMESPACE
 
@@ -122,6 +123,8 @@ struct Manager
   constexpr Manager(Manager const &other)            = default;
   constexpr Manager &operator=(Manager const &other) = default;
 
+  STX_MARK_TRIVIALLY_RELOCATABLE(Manager)
+
   /// on-move, the manager must copy and then invalidate the other
   /// manager's handle, the moved-from manager is required to be valid but
   /// unable to affect the associated state of the resource, i.e. (no-op). why
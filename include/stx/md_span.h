@@ -0,0 +1,555 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <type_traits>
+
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/span.h"
+
+STX_BEGIN_NAMESPACE
+
+// iterates by index rather than by pointer since stepping a pointer past the
+// last element can overshoot the end of the underlying array
+template <typename T>
+struct StridedIterator
+{
+  constexpr T &operator*() const
+  {
+    return data_[index_ * stride_];
+  }
+
+  constexpr T *operator->() const
+  {
+    return data_ + index_ * stride_;
+  }
+
+  constexpr StridedIterator &operator++()
+  {
+    index_++;
+    return *this;
+  }
+
+  constexpr bool operator==(StridedIterator const &other) const
+  {
+    return index_ == other.index_;
+  }
+
+  constexpr bool operator!=(StridedIterator const &other) const
+  {
+    return index_ != other.index_;
+  }
+
+  T     *data_   = nullptr;
+  size_t stride_ = 1;
+  size_t index_  = 0;
+};
+
+// StridedSpan is a non-owning view over elements that are a fixed number of
+// elements (the stride) apart, i.e. a column of a row-major matrix.
+//
+// a StridedSpan with a stride of 1 is contiguous and can be converted back to
+// a `Span` with `as_span`.
+//
+template <typename T>
+struct StridedSpan
+{
+  static_assert(!std::is_reference_v<T>);
+
+  using Size     = size_t;
+  using Index    = size_t;
+  using Iterator = StridedIterator<T>;
+
+  constexpr StridedSpan() = default;
+
+  constexpr StridedSpan(T *data, Size size, Size stride) :
+      data_{data}, size_{size}, stride_{stride}
+  {}
+
+  constexpr StridedSpan(Span<T> span) :
+      data_{span.data()}, size_{span.size()}, stride_{1}
+  {}
+
+  constexpr T *data() const
+  {
+    return data_;
+  }
+
+  constexpr Size size() const
+  {
+    return size_;
+  }
+
+  // distance between consecutive elements, in elements
+  constexpr Size stride() const
+  {
+    return stride_;
+  }
+
+  constexpr bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  constexpr bool is_contiguous() const
+  {
+    return stride_ == 1 || size_ <= 1;
+  }
+
+  constexpr T &operator[](Index index) const
+  {
+    STX_SPAN_ENSURE(index < size_, "index out of bounds");
+    return data_[index * stride_];
+  }
+
+  Option<Ref<T>> at(Index index) const
+  {
+    if (index < size_)
+    {
+      return Some<Ref<T>>(data_[index * stride_]);
+    }
+    else
+    {
+      return None;
+    }
+  }
+
+  constexpr Iterator begin() const
+  {
+    return Iterator{data_, stride_, 0};
+  }
+
+  constexpr Iterator end() const
+  {
+    return Iterator{data_, stride_, size_};
+  }
+
+  constexpr StridedSpan slice(Index offset) const
+  {
+    STX_SPAN_ENSURE(offset <= size_, "index out of bounds");
+    return StridedSpan{element_pointer(offset), size_ - offset, stride_};
+  }
+
+  constexpr StridedSpan slice(Index offset, Size length) const
+  {
+    STX_SPAN_ENSURE(offset <= size_ && length <= size_ - offset, "index out of bounds");
+    return StridedSpan{element_pointer(offset), length, stride_};
+  }
+
+  // every `step`th element
+  constexpr StridedSpan step_by(Size step) const
+  {
+    STX_SPAN_ENSURE(step > 0, "step must be non-zero");
+    return StridedSpan{data_, (size_ + step - 1) / step, stride_ * step};
+  }
+
+  Option<Span<T>> as_span() const
+  {
+    if (is_contiguous())
+    {
+      return Some(Span<T>{data_, size_});
+    }
+
+    return None;
+  }
+
+  constexpr StridedSpan<T const> as_const() const
+  {
+    return StridedSpan<T const>{data_, size_, stride_};
+  }
+
+  template <typename Func>
+  constexpr StridedSpan for_each(Func &&func) const
+  {
+    static_assert(std::is_invocable_v<Func &, T &>);
+
+    for (Index i = 0; i < size_; i++)
+    {
+      func(data_[i * stride_]);
+    }
+
+    return *this;
+  }
+
+  constexpr StridedSpan fill(T const &value) const
+  {
+    for (Index i = 0; i < size_; i++)
+    {
+      data_[i * stride_] = value;
+    }
+
+    return *this;
+  }
+
+  // the address of the `index`th element, or `data_` for the end so the
+  // pointer arithmetic stays within the underlying array
+  constexpr T *element_pointer(Index index) const
+  {
+    return index < size_ ? data_ + index * stride_ : data_;
+  }
+
+  T   *data_   = nullptr;
+  Size size_   = 0;
+  Size stride_ = 1;
+};
+
+template <typename T, size_t Rank>
+struct MdTiles;
+
+// MdSpan is a non-owning `Rank`-dimensional view over a buffer.
+//
+// the view is row-major and the last (innermost) dimension is always
+// contiguous: each row is a `Span` so inner loops are over contiguous memory
+// and the compiler can vectorize them. the outer dimensions can have any
+// stride so sub-blocks of a larger buffer can be viewed without copying.
+//
+// i.e. `for each row: row.span().for_each(...)` processes an MdSpan<T, 2>
+// with contiguous inner loops, and `tiles` splits it into cache-sized blocks
+// whose rows are processed the same way.
+//
+template <typename T, size_t Rank>
+struct MdSpan
+{
+  static_assert(!std::is_reference_v<T>);
+  static_assert(Rank >= 1);
+
+  using Size    = size_t;
+  using Index   = size_t;
+  using Extents = std::array<size_t, Rank>;
+
+  constexpr MdSpan() = default;
+
+  // a contiguous row-major buffer
+  constexpr MdSpan(T *data, Extents extents) :
+      data_{data}, extents_{extents}, strides_{}
+  {
+    Size stride = 1;
+
+    for (Index dim = Rank; dim > 0; dim--)
+    {
+      strides_[dim - 1] = stride;
+      stride *= extents_[dim - 1];
+    }
+  }
+
+  // the last stride must be 1
+  constexpr MdSpan(T *data, Extents extents, Extents strides) :
+      data_{data}, extents_{extents}, strides_{strides}
+  {
+    STX_SPAN_ENSURE(strides_[Rank - 1] == 1, "innermost dimension must be contiguous");
+  }
+
+  // `span` must contain exactly the elements of a buffer of `extents`
+  constexpr MdSpan(Span<T> span, Extents extents) :
+      MdSpan{span.data(), extents}
+  {
+    STX_SPAN_ENSURE(span.size() == size(), "span size does not match the extents");
+  }
+
+  constexpr T *data() const
+  {
+    return data_;
+  }
+
+  constexpr Extents const &extents() const
+  {
+    return extents_;
+  }
+
+  constexpr Size extent(Index dim) const
+  {
+    return extents_[dim];
+  }
+
+  // distance between consecutive elements along `dim`, in elements
+  constexpr Size stride(Index dim) const
+  {
+    return strides_[dim];
+  }
+
+  // total number of elements
+  constexpr Size size() const
+  {
+    Size size = 1;
+
+    for (Size extent : extents_)
+    {
+      size *= extent;
+    }
+
+    return size;
+  }
+
+  constexpr bool is_empty() const
+  {
+    return size() == 0;
+  }
+
+  // true if the elements are in a single contiguous block with no gaps
+  constexpr bool is_contiguous() const
+  {
+    Size stride = 1;
+
+    for (Index dim = Rank; dim > 0; dim--)
+    {
+      if (extents_[dim - 1] != 1 && strides_[dim - 1] != stride)
+      {
+        return false;
+      }
+
+      stride *= extents_[dim - 1];
+    }
+
+    return true;
+  }
+
+  template <typename... I>
+  constexpr T &operator()(I... indices) const
+  {
+    static_assert(sizeof...(I) == Rank);
+    static_assert((std::is_convertible_v<I, Index> && ...));
+
+    Index const index[] = {static_cast<Index>(indices)...};
+    Size        offset  = 0;
+
+    for (Index dim = 0; dim < Rank; dim++)
+    {
+      STX_SPAN_ENSURE(index[dim] < extents_[dim], "index out of bounds");
+      offset += index[dim] * strides_[dim];
+    }
+
+    return data_[offset];
+  }
+
+  // the `index`th sub-view along the outermost dimension. i.e. the `index`th
+  // row of a matrix.
+  constexpr MdSpan<T, Rank - 1> row(Index index) const
+  {
+    static_assert(Rank >= 2);
+    STX_SPAN_ENSURE(index < extents_[0], "index out of bounds");
+
+    typename MdSpan<T, Rank - 1>::Extents extents{};
+    typename MdSpan<T, Rank - 1>::Extents strides{};
+
+    for (Index dim = 1; dim < Rank; dim++)
+    {
+      extents[dim - 1] = extents_[dim];
+      strides[dim - 1] = strides_[dim];
+    }
+
+    return MdSpan<T, Rank - 1>{data_ + index * strides_[0], extents, strides};
+  }
+
+  // the `index`th column of a matrix
+  constexpr StridedSpan<T> column(Index index) const
+  {
+    static_assert(Rank == 2);
+    STX_SPAN_ENSURE(index < extents_[1], "index out of bounds");
+
+    return StridedSpan<T>{data_ + index, extents_[0], strides_[0]};
+  }
+
+  // the elements of a 1-dimensional view
+  constexpr Span<T> span() const
+  {
+    static_assert(Rank == 1);
+    return Span<T>{data_, extents_[0]};
+  }
+
+  // all the elements, if the view is contiguous
+  Option<Span<T>> flatten() const
+  {
+    if (is_contiguous())
+    {
+      return Some(Span<T>{data_, size()});
+    }
+
+    return None;
+  }
+
+  // narrows the view along `dim` to `length` elements starting at `offset`
+  constexpr MdSpan slice(Index dim, Index offset, Size length) const
+  {
+    STX_SPAN_ENSURE(dim < Rank, "dimension out of bounds");
+    STX_SPAN_ENSURE(offset <= extents_[dim] && length <= extents_[dim] - offset, "index out of bounds");
+
+    Extents extents = extents_;
+    extents[dim]    = length;
+
+    // an empty view at the end of an inner dimension would point past the
+    // buffer
+    return MdSpan{length == 0 ? data_ : data_ + offset * strides_[dim], extents, strides_};
+  }
+
+  // narrows the view to the block of `extents` starting at `offsets`
+  constexpr MdSpan block(Extents offsets, Extents extents) const
+  {
+    Size offset = 0;
+    bool empty  = false;
+
+    for (Index dim = 0; dim < Rank; dim++)
+    {
+      STX_SPAN_ENSURE(offsets[dim] <= extents_[dim] && extents[dim] <= extents_[dim] - offsets[dim], "index out of bounds");
+      offset += offsets[dim] * strides_[dim];
+      empty = empty || extents[dim] == 0;
+    }
+
+    return MdSpan{empty ? data_ : data_ + offset, extents, strides_};
+  }
+
+  // splits the view into blocks of at most `tile_extents`, in row-major
+  // order. the tiles at the edges are clipped.
+  constexpr MdTiles<T, Rank> tiles(Extents tile_extents) const;
+
+  // reinterprets the innermost dimension as elements of type `U`. the size of
+  // each row and each stride in bytes must be a multiple of `sizeof(U)`.
+  template <typename U>
+  constexpr MdSpan<U, Rank> transmute() const
+  {
+    Extents extents = extents_;
+    Extents strides = strides_;
+
+    STX_SPAN_ENSURE((extents[Rank - 1] * sizeof(T)) % sizeof(U) == 0, "row size is not a multiple of the target type's size");
+    extents[Rank - 1] = extents[Rank - 1] * sizeof(T) / sizeof(U);
+
+    for (Index dim = 0; dim + 1 < Rank; dim++)
+    {
+      STX_SPAN_ENSURE((strides[dim] * sizeof(T)) % sizeof(U) == 0, "stride is not a multiple of the target type's size");
+      strides[dim] = strides[dim] * sizeof(T) / sizeof(U);
+    }
+
+    return MdSpan<U, Rank>{reinterpret_cast<U *>(data_), extents, strides};
+  }
+
+  constexpr MdSpan<impl::match_cv<T, uint8_t>, Rank> as_u8() const
+  {
+    return transmute<impl::match_cv<T, uint8_t>>();
+  }
+
+  constexpr MdSpan<T const, Rank> as_const() const
+  {
+    return MdSpan<T const, Rank>{data_, extents_, strides_};
+  }
+
+  T      *data_ = nullptr;
+  Extents extents_{};
+  Extents strides_{};
+};
+
+template <typename T, size_t Rank>
+struct MdTileIterator
+{
+  using Extents = typename MdSpan<T, Rank>::Extents;
+
+  constexpr MdSpan<T, Rank> operator*() const
+  {
+    Extents offsets{};
+    Extents extents{};
+
+    for (size_t dim = 0; dim < Rank; dim++)
+    {
+      offsets[dim] = position_[dim] * tile_extents_[dim];
+      extents[dim] = std::min(tile_extents_[dim], span_.extents_[dim] - offsets[dim]);
+    }
+
+    return span_.block(offsets, extents);
+  }
+
+  constexpr MdTileIterator &operator++()
+  {
+    for (size_t dim = Rank; dim > 0; dim--)
+    {
+      position_[dim - 1]++;
+
+      // the outermost dimension is not wrapped so the end position is
+      // `{num_tiles[0], 0, ...}`
+      if (dim == 1 || position_[dim - 1] < num_tiles_[dim - 1])
+      {
+        break;
+      }
+
+      position_[dim - 1] = 0;
+    }
+
+    return *this;
+  }
+
+  constexpr bool operator==(MdTileIterator const &other) const
+  {
+    return position_ == other.position_;
+  }
+
+  constexpr bool operator!=(MdTileIterator const &other) const
+  {
+    return position_ != other.position_;
+  }
+
+  MdSpan<T, Rank> span_;
+  Extents         tile_extents_{};
+  Extents         num_tiles_{};
+  Extents         position_{};
+};
+
+template <typename T, size_t Rank>
+struct MdTiles
+{
+  using Extents = typename MdSpan<T, Rank>::Extents;
+
+  constexpr MdTileIterator<T, Rank> begin() const
+  {
+    MdTileIterator<T, Rank> iter{span_, tile_extents_, num_tiles_, {}};
+
+    for (size_t num : num_tiles_)
+    {
+      if (num == 0)
+      {
+        return end();
+      }
+    }
+
+    return iter;
+  }
+
+  constexpr MdTileIterator<T, Rank> end() const
+  {
+    Extents position{};
+    position[0] = num_tiles_[0];
+    return MdTileIterator<T, Rank>{span_, tile_extents_, num_tiles_, position};
+  }
+
+  // total number of tiles
+  constexpr size_t size() const
+  {
+    size_t size = 1;
+
+    for (size_t num : num_tiles_)
+    {
+      size *= num;
+    }
+
+    return size;
+  }
+
+  MdSpan<T, Rank> span_;
+  Extents         tile_extents_{};
+  Extents         num_tiles_{};
+};
+
+template <typename T, size_t Rank>
+constexpr MdTiles<T, Rank> MdSpan<T, Rank>::tiles(Extents tile_extents) const
+{
+  Extents num_tiles{};
+
+  for (Index dim = 0; dim < Rank; dim++)
+  {
+    STX_SPAN_ENSURE(tile_extents[dim] > 0, "tile extents must be non-zero");
+    num_tiles[dim] = (extents_[dim] + tile_extents[dim] - 1) / tile_extents[dim];
+  }
+
+  return MdTiles<T, Rank>{*this, tile_extents, num_tiles};
+}
+
+STX_END_NAMESPACE
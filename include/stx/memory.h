@@ -3,6 +3,7 @@
 #include <utility>
 
 #include "stx/allocator.h"
+#include "stx/relocate.h"
 #include "stx/result.h"
 #include "stx/void.h"
 
@@ -18,6 +19,8 @@ struct Memory
   Memory(Memory const &)            = delete;
   Memory &operator=(Memory const &) = delete;
 
+  STX_MARK_TRIVIALLY_RELOCATABLE(Memory)
+
   Memory(Memory &&other) :
       allocator{other.allocator}, handle{other.handle}
   {
@@ -59,6 +62,8 @@ struct ReadOnlyMemory
   ReadOnlyMemory(ReadOnlyMemory const &)            = delete;
   ReadOnlyMemory &operator=(ReadOnlyMemory const &) = delete;
 
+  STX_MARK_TRIVIALLY_RELOCATABLE(ReadOnlyMemory)
+
   ReadOnlyMemory(ReadOnlyMemory &&other) :
       allocator{other.allocator}, handle{other.handle}
   {
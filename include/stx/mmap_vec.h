@@ -0,0 +1,347 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "stx/c_string_view.h"
+#include "stx/config.h"
+#include "stx/fs.h"
+#include "stx/option.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+namespace impl
+{
+
+// "STXVEC01"
+constexpr uint64_t MMAP_VEC_MAGIC = 0x3130434556585453ULL;
+
+// the elements start after the header, aligned for any element type
+constexpr size_t MMAP_VEC_HEADER_SIZE = 64;
+
+struct MmapVecHeader
+{
+  uint64_t magic             = 0;
+  uint64_t element_size      = 0;
+  uint64_t element_alignment = 0;
+  uint64_t size              = 0;
+};
+
+static_assert(sizeof(MmapVecHeader) <= MMAP_VEC_HEADER_SIZE);
+
+}        // namespace impl
+
+// MmapVec is a Vec of trivially-copyable elements stored in a memory-mapped
+// file, i.e. large append-only logs or tables that must survive restarts.
+//
+// the elements are written directly to the mapping, so reopening the file is
+// a remap rather than a parse. the number of elements is stored in a header
+// at the start of the file and updated with every insertion or removal.
+//
+// modifications reach the page cache immediately, so they survive the
+// process crashing. `flush` waits for them to be written to the device, so
+// they also survive the operating system crashing or power loss.
+//
+// the file grows in whole pages by resizing it and remapping it, which
+// invalidates references. the layout of the file depends on the layout of
+// `T` and on the target's endianness, and must only be read back by the same
+// build. a file must only be opened by one MmapVec at a time.
+//
+template <typename T>
+struct MmapVec
+{
+  static_assert(std::is_trivially_copyable_v<T>, "MmapVec elements must be trivially-copyable");
+  static_assert(alignof(T) <= impl::MMAP_VEC_HEADER_SIZE);
+
+  using Size     = size_t;
+  using Index    = size_t;
+  using Iterator = T *;
+  using Pointer  = T *;
+
+  explicit MmapVec(impl::SharedFileMapping &&mapping) :
+      mapping_{std::move(mapping)}
+  {
+    size_     = static_cast<Size>(header().size);
+    capacity_ = (mapping_.size_ - impl::MMAP_VEC_HEADER_SIZE) / sizeof(T);
+  }
+
+  MmapVec(MmapVec &&other) :
+      mapping_{std::move(other.mapping_)}, size_{other.size_}, capacity_{other.capacity_}
+  {
+    other.size_     = 0;
+    other.capacity_ = 0;
+  }
+
+  MmapVec &operator=(MmapVec &&other)
+  {
+    std::swap(mapping_, other.mapping_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    return *this;
+  }
+
+  STX_DISABLE_COPY(MmapVec)
+  STX_DEFAULT_DESTRUCTOR(MmapVec)
+  STX_MARK_TRIVIALLY_RELOCATABLE(MmapVec)
+
+  Span<T> span() const
+  {
+    return Span<T>{begin(), size_};
+  }
+
+  // lazy iterator adapters over the elements. requires "stx/iter.h".
+  auto iter() const
+  {
+    return span().iter();
+  }
+
+  T &operator[](Index index) const
+  {
+    return span()[index];
+  }
+
+  Option<Ref<T>> at(Index index) const
+  {
+    return span().at(index);
+  }
+
+  Size size() const
+  {
+    return size_;
+  }
+
+  Size capacity() const
+  {
+    return capacity_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  Pointer data() const
+  {
+    return mapping_.data_ == nullptr ? nullptr : reinterpret_cast<T *>(static_cast<char *>(mapping_.data_) + impl::MMAP_VEC_HEADER_SIZE);
+  }
+
+  Iterator begin() const
+  {
+    return data();
+  }
+
+  Iterator end() const
+  {
+    return data() + size_;
+  }
+
+  // grows the file to contain at least `cap` elements, rounded up to whole
+  // pages
+  //
+  // invalidates references
+  //
+  Result<Void, IoError> reserve(Size cap)
+  {
+    if (cap <= capacity_)
+    {
+      return Ok(Void{});
+    }
+
+    Size const page_size = impl::page_size();
+
+    if (cap > (SIZE_MAX / 2 - impl::MMAP_VEC_HEADER_SIZE - page_size) / sizeof(T))
+    {
+      return Err(IoError::NoMemory);
+    }
+
+    Size const file_size = (impl::MMAP_VEC_HEADER_SIZE + cap * sizeof(T) + page_size - 1) / page_size * page_size;
+
+    TRY_OK(ok, mapping_.resize(file_size));
+
+    (void) ok;
+
+    capacity_ = (mapping_.size_ - impl::MMAP_VEC_HEADER_SIZE) / sizeof(T);
+
+    return Ok(Void{});
+  }
+
+  // capacity is unchanged
+  void clear()
+  {
+    set_size(0);
+  }
+
+  // capacity is unchanged
+  void erase(Span<T> range)
+  {
+    STX_SPAN_ENSURE(begin() <= range.begin() && end() >= range.end(),
+                    "erase operation out of MmapVec range");
+
+    Size const num_trailing = static_cast<Size>(end() - range.end());
+
+    if (num_trailing > 0)
+    {
+      std::memmove(range.begin(), range.end(), num_trailing * sizeof(T));
+    }
+
+    set_size(size_ - range.size());
+  }
+
+  // invalidates references
+  template <typename... Args>
+  Result<Void, IoError> push_inplace(Args &&...args)
+  {
+    static_assert(std::is_constructible_v<T, Args &&...>);
+
+    TRY_OK(ok, reserve(impl::grow_vec(capacity_, size_ + 1)));
+
+    (void) ok;
+
+    new (end()) T{std::forward<Args>(args)...};
+
+    set_size(size_ + 1);
+
+    return Ok(Void{});
+  }
+
+  // invalidates references
+  Result<Void, IoError> push(T &&value)
+  {
+    return push_inplace(std::move(value));
+  }
+
+  Result<Void, IoError> resize(Size target_size, T const &to_copy = {})
+  {
+    if (target_size > size_)
+    {
+      TRY_OK(ok, reserve(impl::grow_vec(capacity_, target_size)));
+
+      (void) ok;
+
+      for (T *iter = end(); iter < begin() + target_size; iter++)
+      {
+        new (iter) T{to_copy};
+      }
+    }
+
+    set_size(target_size);
+
+    return Ok(Void{});
+  }
+
+  Result<Void, IoError> extend(Span<T const> other)
+  {
+    TRY_OK(ok, reserve(size_ + other.size()));
+
+    (void) ok;
+
+    if (!other.is_empty())
+    {
+      std::memcpy(end(), other.data(), other.size_bytes());
+    }
+
+    set_size(size_ + other.size());
+
+    return Ok(Void{});
+  }
+
+  Option<T> pop()
+  {
+    if (size_ == 0)
+    {
+      return None;
+    }
+
+    T last = begin()[size_ - 1];
+
+    set_size(size_ - 1);
+
+    return Some(std::move(last));
+  }
+
+  // writes the modifications to the device and waits for them to be written.
+  // the modifications made before a successful flush survive power loss.
+  Result<Void, IoError> flush() const
+  {
+    return mapping_.sync();
+  }
+
+  impl::MmapVecHeader &header() const
+  {
+    return *static_cast<impl::MmapVecHeader *>(mapping_.data_);
+  }
+
+  void set_size(Size size)
+  {
+    size_ = size;
+
+    // a moved-from MmapVec has no mapping
+    if (mapping_.data_ != nullptr)
+    {
+      header().size = size;
+    }
+  }
+
+  impl::SharedFileMapping mapping_;
+  Size                    size_     = 0;
+  Size                    capacity_ = 0;
+};
+
+namespace fs
+{
+
+// opens the MmapVec stored in the file at `path`, creating an empty one if the
+// file doesn't exist or is empty.
+//
+// returns `IoError::InvalidFormat` if the file is not an MmapVec of `T`.
+//
+template <typename T>
+Result<MmapVec<T>, IoError> map_vec(CStringView path)
+{
+  TRY_OK(mapping, impl::map_shared(path));
+
+  if (mapping.size_ == 0)
+  {
+    TRY_OK(ok, mapping.resize(impl::page_size()));
+
+    (void) ok;
+
+    impl::MmapVecHeader &header = *static_cast<impl::MmapVecHeader *>(mapping.data_);
+
+    header.magic             = impl::MMAP_VEC_MAGIC;
+    header.element_size      = sizeof(T);
+    header.element_alignment = alignof(T);
+    header.size              = 0;
+
+    return Ok(MmapVec<T>{std::move(mapping)});
+  }
+
+  if (mapping.size_ < impl::MMAP_VEC_HEADER_SIZE)
+  {
+    return Err(IoError::InvalidFormat);
+  }
+
+  impl::MmapVecHeader const &header   = *static_cast<impl::MmapVecHeader const *>(mapping.data_);
+  size_t const               capacity = (mapping.size_ - impl::MMAP_VEC_HEADER_SIZE) / sizeof(T);
+
+  if (header.magic != impl::MMAP_VEC_MAGIC || header.element_size != sizeof(T) || header.element_alignment != alignof(T) || header.size > capacity)
+  {
+    return Err(IoError::InvalidFormat);
+  }
+
+  return Ok(MmapVec<T>{std::move(mapping)});
+}
+
+}        // namespace fs
+
+STX_END_NAMESPACE
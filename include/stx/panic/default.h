@@ -58,7 +58,7 @@ inline void panic_default(std::string_view info, std::string_view error_report,
 
   std::fputs(" with hash: '", stderr);
 
-  STX_PANIC_EPRINTF(FMT_BUFFER_SIZE, "%zu", thread_id_hash);
+  STX_PANIC_EPRINT(FMT_BUFFER_SIZE, thread_id_hash);
 
   std::fputs("' ", stderr);
 
@@ -95,7 +95,7 @@ inline void panic_default(std::string_view info, std::string_view error_report,
 
   if (line != 0)
   {
-    STX_PANIC_EPRINTF(FMT_BUFFER_SIZE, "%" PRIuLEAST32, line);
+    STX_PANIC_EPRINT(FMT_BUFFER_SIZE, line);
   }
   else
   {
@@ -108,7 +108,7 @@ inline void panic_default(std::string_view info, std::string_view error_report,
 
   if (column != 0)
   {
-    STX_PANIC_EPRINTF(FMT_BUFFER_SIZE, "%" PRIuLEAST32, column);
+    STX_PANIC_EPRINT(FMT_BUFFER_SIZE, column);
   }
   else
   {
@@ -129,10 +129,10 @@ inline void panic_default(std::string_view info, std::string_view error_report,
         auto const print_none = []() { std::fputs("unknown", stderr); };
 
         auto const print_ptr = [](uintptr_t ip) {
-          STX_PANIC_EPRINTF(FMT_BUFFER_SIZE, "0x%" PRIxPTR, ip);
+          STX_PANIC_EPRINT(FMT_BUFFER_SIZE, "0x", fmt::hex(ip));
         };
 
-        STX_PANIC_EPRINTF(FMT_BUFFER_SIZE, "#%d\t\t", i);
+        STX_PANIC_EPRINT(FMT_BUFFER_SIZE, '#', i, "\t\t");
 
         frame.symbol.match(
             [](backtrace::Symbol const &sym) {
@@ -13,26 +13,18 @@
 
 #include <cstdio>
 
+#include "stx/fmt/core.h"
+
 /// @file
 ///
-/// Safe snprintfs
-/// printf, makes own buffer
-#define STX_PANIC_EPRINTF(STX_ARG_STR_SIZE, STX_ARG_FORMAT, STX_ARG_VALUE) \
+/// allocation-free printing to stderr for the panic handlers
+
+/// formats the arguments with `stx::fmt` into a stack buffer of
+/// `STX_ARG_STR_SIZE` characters and writes them to stderr, without `printf`
+#define STX_PANIC_EPRINT(STX_ARG_STR_SIZE, ...)                            \
   {                                                                        \
-    /* string length + terminating null character */                       \
-    char fmt_buffer[STX_ARG_STR_SIZE + 1];                                 \
-    int  fmt_size = ::std::snprintf(fmt_buffer, STX_ARG_STR_SIZE + 1,      \
-                                    STX_ARG_FORMAT, STX_ARG_VALUE);        \
-    if (fmt_size >= STX_ARG_STR_SIZE)                                      \
-    {                                                                      \
-      ::std::fputs("<format buffer size insufficient>", stderr);           \
-    }                                                                      \
-    else if (fmt_size < 0)                                                 \
-    {                                                                      \
-      ::std::fputs("<format implementation error>", stderr);               \
-    }                                                                      \
-    else                                                                   \
-    {                                                                      \
-      ::std::fputs(fmt_buffer, stderr);                                    \
-    };                                                                     \
+    char         fmt_buffer[STX_ARG_STR_SIZE];                             \
+    size_t const fmt_size = ::stx::fmt::format_to_n(                       \
+        fmt_buffer, STX_ARG_STR_SIZE, __VA_ARGS__);                        \
+    ::std::fwrite(fmt_buffer, 1, fmt_size, stderr);                        \
   }
@@ -13,16 +13,14 @@
 
 #include <cinttypes>
 #include <cstddef>
-#include <cstdio>
 #include <string>
 #include <string_view>
 
 #include "stx/common.h"
+#include "stx/fmt/core.h"
 
 STX_BEGIN_NAMESPACE
 
-constexpr std::string_view REPORT_FORMAT_ERROR = "<format error>";
-
 struct ReportQuery
 {
   struct Buffer
@@ -42,77 +40,97 @@ template <typename T>
   return {};
 }
 
-#define STX_INTERNAL_MAKE_REPORT_(STX_ARG_BUFFER, STX_ARG_FORMAT,        \
-                                  STX_ARG_VALUE)                         \
-  if (STX_ARG_BUFFER.size == 0 || STX_ARG_BUFFER.data == nullptr)        \
-    return std::string_view{};                                           \
-                                                                         \
-  int fmt_size = std::snprintf(STX_ARG_BUFFER.data, STX_ARG_BUFFER.size, \
-                               STX_ARG_FORMAT, STX_ARG_VALUE);           \
-                                                                         \
-  if (fmt_size < 0)                                                      \
-  {                                                                      \
-    return REPORT_FORMAT_ERROR;                                          \
-  }                                                                      \
-  else                                                                   \
-  {                                                                      \
-    return std::string_view{STX_ARG_BUFFER.data,                         \
-                            static_cast<size_t>(fmt_size)};              \
+namespace impl
+{
+
+template <typename... Args>
+std::string_view make_report(ReportQuery::Buffer buffer, Args const &...args)
+{
+  if (buffer.size == 0 || buffer.data == nullptr)
+  {
+    return std::string_view{};
   }
 
+  size_t const size = fmt::format_to_n(buffer.data, buffer.size, args...);
+
+  return std::string_view{buffer.data, size};
+}
+
+}        // namespace impl
+
 template <typename T>
 [[nodiscard]] inline std::string_view operator>>(ReportQuery     query,
                                                  T const *const &ptr)
 {
-  STX_INTERNAL_MAKE_REPORT_(query.buffer, "0x%" PRIxPTR,
-                            reinterpret_cast<uintptr_t>(ptr));
+  return impl::make_report(query.buffer, "0x", fmt::hex(ptr));
 }
 
 template <typename T>
 [[nodiscard]] inline std::string_view operator>>(ReportQuery query,
                                                  T *const   &ptr)
 {
-  STX_INTERNAL_MAKE_REPORT_(query.buffer, "0x%" PRIxPTR,
-                            reinterpret_cast<uintptr_t>(ptr));
+  return impl::make_report(query.buffer, "0x", fmt::hex(ptr));
 }
 
 [[nodiscard]] inline std::string_view operator>>(ReportQuery   query,
                                                  int8_t const &value)
 {
-  STX_INTERNAL_MAKE_REPORT_(query.buffer, "%" PRIi8, value);
+  return impl::make_report(query.buffer, value);
 }
 
 [[nodiscard]] inline std::string_view operator>>(ReportQuery    query,
                                                  uint8_t const &value)
 {
-  STX_INTERNAL_MAKE_REPORT_(query.buffer, "%" PRIu8, value);
+  return impl::make_report(query.buffer, value);
 }
 
 [[nodiscard]] inline std::string_view operator>>(ReportQuery    query,
                                                  int16_t const &value)
 {
-  STX_INTERNAL_MAKE_REPORT_(query.buffer, "%" PRIi16, value);
+  return impl::make_report(query.buffer, value);
 }
 
 [[nodiscard]] inline std::string_view operator>>(ReportQuery     query,
                                                  uint16_t const &value)
 {
-  STX_INTERNAL_MAKE_REPORT_(query.buffer, "%" PRIu16, value);
+  return impl::make_report(query.buffer, value);
 }
 
 [[nodiscard]] inline std::string_view operator>>(ReportQuery    query,
                                                  int32_t const &value)
 {
-  STX_INTERNAL_MAKE_REPORT_(query.buffer, "%" PRIi32, value);
+  return impl::make_report(query.buffer, value);
 }
 
 [[nodiscard]] inline std::string_view operator>>(ReportQuery     query,
                                                  uint32_t const &value)
 {
-  STX_INTERNAL_MAKE_REPORT_(query.buffer, "%" PRIu32, value);
+  return impl::make_report(query.buffer, value);
 }
 
-#undef STX_INTERNAL_MAKE_REPORT_
+[[nodiscard]] inline std::string_view operator>>(ReportQuery    query,
+                                                 int64_t const &value)
+{
+  return impl::make_report(query.buffer, value);
+}
+
+[[nodiscard]] inline std::string_view operator>>(ReportQuery     query,
+                                                 uint64_t const &value)
+{
+  return impl::make_report(query.buffer, value);
+}
+
+[[nodiscard]] inline std::string_view operator>>(ReportQuery  query,
+                                                 float const &value)
+{
+  return impl::make_report(query.buffer, value);
+}
+
+[[nodiscard]] inline std::string_view operator>>(ReportQuery   query,
+                                                 double const &value)
+{
+  return impl::make_report(query.buffer, value);
+}
 
 [[nodiscard]] inline std::string_view operator>>(ReportQuery,
                                                  std::string_view const &str)
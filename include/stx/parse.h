@@ -0,0 +1,332 @@
+#pragma once
+
+#include <charconv>
+#include <cinttypes>
+#include <cstddef>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#include "stx/config.h"
+#include "stx/result.h"
+#include "stx/span.h"
+
+STX_BEGIN_NAMESPACE
+
+enum class [[nodiscard]] ParseError : uint8_t
+{
+  // the input is empty or only a sign
+  Empty,
+  // the input contains a character that is not part of the number
+  InvalidInput,
+  // the number is not representable by the type
+  OutOfRange
+};
+
+/// locale-independent number parsing.
+///
+/// the whole input must be the number: leading or trailing whitespace and
+/// other characters are rejected. the input doesn't need to be
+/// null-terminated.
+///
+namespace parse
+{
+
+namespace impl
+{
+
+// loads 8 characters as a little-endian word, compiles to a single load on
+// little-endian targets
+inline uint64_t load8(char const *str)
+{
+  uint64_t word = 0;
+
+  for (uint32_t i = 0; i < 8; i++)
+  {
+    word |= static_cast<uint64_t>(static_cast<uint8_t>(str[i])) << (i * 8);
+  }
+
+  return word;
+}
+
+inline bool is_eight_digits(uint64_t word)
+{
+  return ((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+// the value of the 8 decimal digits in `word`, the first digit in the lowest
+// byte. combines adjacent digits into pairs, then quads, then the whole word
+// with 3 multiplications.
+inline uint32_t parse_eight_digits(uint64_t word)
+{
+  uint64_t const mask = 0x000000FF000000FFULL;
+  uint64_t const mul1 = 100 + (1000000ULL << 32);
+  uint64_t const mul2 = 1 + (10000ULL << 32);
+
+  word -= 0x3030303030303030ULL;
+  word = (word * 10) + (word >> 8);
+  word = (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+
+  return static_cast<uint32_t>(word);
+}
+
+inline uint32_t digit_value(char c)
+{
+  if (c >= '0' && c <= '9')
+  {
+    return static_cast<uint32_t>(c - '0');
+  }
+
+  if (c >= 'a' && c <= 'z')
+  {
+    return static_cast<uint32_t>(c - 'a' + 10);
+  }
+
+  if (c >= 'A' && c <= 'Z')
+  {
+    return static_cast<uint32_t>(c - 'A' + 10);
+  }
+
+  return UINT32_MAX;
+}
+
+// parses the digits of `str` in `base` into a value no larger than `max`
+inline Result<uint64_t, ParseError> parse_magnitude(char const *str, size_t size, uint32_t base, uint64_t max)
+{
+  if (size == 0)
+  {
+    return Err(ParseError::Empty);
+  }
+
+  uint64_t value = 0;
+  size_t   i     = 0;
+
+  if (base == 10)
+  {
+    // 8 digits at a time while the value can't overflow
+    for (; i + 8 <= size && value < 100000000000ULL; i += 8)
+    {
+      uint64_t const word = load8(str + i);
+
+      if (!is_eight_digits(word))
+      {
+        break;
+      }
+
+      value = value * 100000000ULL + parse_eight_digits(word);
+    }
+  }
+
+  for (; i < size; i++)
+  {
+    uint32_t const digit = digit_value(str[i]);
+
+    if (digit >= base)
+    {
+      return Err(ParseError::InvalidInput);
+    }
+
+    if (value > (max - digit) / base)
+    {
+      // the rest of the input must still be digits
+      for (i++; i < size; i++)
+      {
+        if (digit_value(str[i]) >= base)
+        {
+          return Err(ParseError::InvalidInput);
+        }
+      }
+
+      return Err(ParseError::OutOfRange);
+    }
+
+    value = value * base + digit;
+  }
+
+  if (value > max)
+  {
+    return Err(ParseError::OutOfRange);
+  }
+
+  return Ok(uint64_t{value});
+}
+
+// whether a syntactically valid decimal or scientific number that
+// `from_chars` reported as out of range is too small rather than too large,
+// from the position of its first significant digit
+inline bool is_underflow(char const *str, char const *end)
+{
+  if (str < end && *str == '-')
+  {
+    str++;
+  }
+
+  // the decimal exponent of the first significant digit, without the
+  // explicit exponent
+  int64_t order       = -1;
+  bool    significant = false;
+
+  for (; str < end && *str >= '0' && *str <= '9'; str++)
+  {
+    significant = significant || *str != '0';
+
+    if (significant)
+    {
+      order++;
+    }
+  }
+
+  if (str < end && *str == '.')
+  {
+    for (str++; str < end && *str >= '0' && *str <= '9' && !significant; str++)
+    {
+      significant = *str != '0';
+      order--;
+    }
+
+    for (; str < end && *str >= '0' && *str <= '9'; str++)
+    {
+    }
+  }
+
+  int64_t exponent = 0;
+
+  if (str < end && (*str == 'e' || *str == 'E'))
+  {
+    str++;
+
+    bool const neg_exponent = str < end && *str == '-';
+
+    if (str < end && (*str == '-' || *str == '+'))
+    {
+      str++;
+    }
+
+    // saturates far beyond the range of any floating-point type
+    for (; str < end && *str >= '0' && *str <= '9'; str++)
+    {
+      exponent = exponent < 1000000000 ? exponent * 10 + (*str - '0') : exponent;
+    }
+
+    exponent = neg_exponent ? -exponent : exponent;
+  }
+
+  return order + exponent < 0;
+}
+
+}        // namespace impl
+
+/// parses an integer in `base` (2 to 36), with an optional leading `+` or, for
+/// signed types, `-`. the letters of the digits above 9 are case-insensitive
+/// and there's no `0x`-style prefix. bases outside of 2 to 36 are rejected as
+/// `InvalidInput`.
+///
+/// decimal digits are parsed 8 at a time.
+///
+template <typename T>
+Result<T, ParseError> int_(Span<char const> str, uint32_t base = 10)
+{
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>);
+  static_assert(sizeof(T) <= 8);
+
+  using U = std::make_unsigned_t<T>;
+
+  if (base < 2 || base > 36)
+  {
+    return Err(ParseError::InvalidInput);
+  }
+
+  char const *data = str.data();
+  size_t      size = str.size();
+  bool        neg  = false;
+
+  if (size > 0 && (data[0] == '+' || (std::is_signed_v<T> && data[0] == '-')))
+  {
+    neg = data[0] == '-';
+    data++;
+    size--;
+  }
+
+  // the magnitude of the minimum of signed types is one larger than the maximum
+  uint64_t const max = neg ? static_cast<uint64_t>(std::numeric_limits<T>::max()) + 1 : static_cast<uint64_t>(std::numeric_limits<T>::max());
+
+  Result<uint64_t, ParseError> magnitude = impl::parse_magnitude(data, size, base, max);
+
+  if (magnitude.is_err())
+  {
+    return Err(std::move(magnitude).unwrap_err());
+  }
+
+  U const value = static_cast<U>(std::move(magnitude).unwrap());
+
+  return Ok(static_cast<T>(neg ? static_cast<U>(U{0} - value) : value));
+}
+
+/// parses a decimal or scientific floating-point number (i.e. `-12.5e-3`),
+/// `inf` or `nan`, with an optional leading `-`. the nearest representable
+/// value is returned: numbers too small for the type are rounded to a
+/// denormal or to a zero of the same sign, numbers too large for it are
+/// `OutOfRange`.
+///
+/// uses `std::from_chars`, which is locale-independent and implemented with
+/// the Eisel-Lemire algorithm by the supported standard libraries.
+///
+template <typename T>
+Result<T, ParseError> float_(Span<char const> str)
+{
+  static_assert(std::is_floating_point_v<T>);
+
+  char const *const begin = str.data();
+  char const *const end   = begin + str.size();
+
+  if (str.is_empty() || (str.size() == 1 && (begin[0] == '-' || begin[0] == '+')))
+  {
+    return Err(ParseError::Empty);
+  }
+
+  // from_chars doesn't accept a leading '+'
+  char const *first = begin[0] == '+' ? begin + 1 : begin;
+
+  if (first != begin && first < end && *first == '-')
+  {
+    return Err(ParseError::InvalidInput);
+  }
+
+  T                      value{};
+  std::from_chars_result result = std::from_chars(first, end, value);
+
+  if (result.ec == std::errc::invalid_argument || result.ptr != end)
+  {
+    return Err(ParseError::InvalidInput);
+  }
+
+  if (result.ec == std::errc::result_out_of_range)
+  {
+    if (impl::is_underflow(first, end))
+    {
+      // some standard libraries also report denormals as out of range, they
+      // are parsed through a type with a wider exponent range
+      using Wide = std::conditional_t<std::is_same_v<T, float>, double, long double>;
+
+      Wide wide{};
+
+      if constexpr (std::numeric_limits<Wide>::min_exponent < std::numeric_limits<T>::min_exponent)
+      {
+        if (std::from_chars(first, end, wide).ec == std::errc{})
+        {
+          return Ok(static_cast<T>(wide));
+        }
+      }
+
+      return Ok(T{*first == '-' ? -T{0} : T{0}});
+    }
+
+    return Err(ParseError::OutOfRange);
+  }
+
+  return Ok(T{value});
+}
+
+}        // namespace parse
+
+STX_END_NAMESPACE
@@ -0,0 +1,779 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/bit.h"
+#include "stx/config.h"
+#include "stx/hash.h"
+#include "stx/hash_map.h"
+#include "stx/option.h"
+#include "stx/rc.h"
+#include "stx/relocate.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+namespace impl
+{
+
+// the persistent containers are tries with 32-way branching
+constexpr uint32_t PERSISTENT_BITS   = 5;
+constexpr size_t   PERSISTENT_BRANCH = size_t{1} << PERSISTENT_BITS;
+constexpr size_t   PERSISTENT_MASK   = PERSISTENT_BRANCH - 1;
+
+// an interior node only has children and a leaf node only has values
+template <typename T>
+struct PersistentVecNode
+{
+  Vec<Rc<PersistentVecNode *>> children;
+  Vec<T>                       values;
+};
+
+// a node stores the entries whose hashes end at this level inline, and the
+// sub-tries for the hash fragments shared by several entries as children
+// (CHAMP layout). the entries and children are compacted and indexed by the
+// popcount of their bitmap below the hash fragment's bit.
+//
+// once the hash bits are exhausted, the node is a collision node and its
+// entries are searched linearly.
+template <typename K, typename V>
+struct PersistentMapNode
+{
+  uint32_t                             entry_map = 0;
+  uint32_t                             child_map = 0;
+  Vec<HashMapEntry<K, V>>              entries;
+  Vec<Rc<PersistentMapNode<K, V> *>> children;
+};
+
+template <typename T>
+Result<Vec<Rc<T *>>, AllocError> share_all(Allocator allocator, Span<Rc<T *> const> rcs)
+{
+  Vec<Rc<T *>> shared{allocator};
+
+  TRY_OK(ok, shared.reserve(rcs.size()));
+
+  (void) ok;
+
+  for (Rc<T *> const &rc : rcs)
+  {
+    shared.push(rc.share()).unwrap();
+  }
+
+  return Ok(std::move(shared));
+}
+
+template <typename T>
+Result<Void, AllocError> vec_insert(Vec<T> &vec, size_t index, T &&value)
+{
+  TRY_OK(ok, vec.push(std::move(value)));
+
+  (void) ok;
+
+  std::rotate(vec.begin() + index, vec.end() - 1, vec.end());
+
+  return Ok(Void{});
+}
+
+}        // namespace impl
+
+// PersistentVec is an immutable vector with structural sharing.
+//
+// updates don't modify the vector, they return a new version which shares all
+// but the `O(log32 n)` nodes on the path to the updated element with the old
+// version. publishing a new snapshot to readers holding the old one therefore
+// costs `O(log n)` time and memory instead of a full copy.
+//
+// the nodes are reference-counted `Rc`s allocated from the allocator, so the
+// versions can be shared across threads and are freed once the last version
+// referencing them is released.
+//
+// `T` must be copy-constructible since the leaves on the updated path are
+// copied.
+//
+template <typename T>
+struct PersistentVec
+{
+  static_assert(!std::is_reference_v<T>);
+  static_assert(std::is_copy_constructible_v<T>);
+
+  using Size   = size_t;
+  using Index  = size_t;
+  using Node   = impl::PersistentVecNode<T>;
+  using NodeRc = Rc<Node *>;
+
+  explicit PersistentVec(Allocator allocator) :
+      allocator_{allocator}, root_{None}, size_{0}, shift_{0}
+  {}
+
+  PersistentVec(Allocator allocator, Option<NodeRc> root, Size size, uint32_t shift) :
+      allocator_{allocator}, root_{std::move(root)}, size_{size}, shift_{shift}
+  {}
+
+  STX_DEFAULT_MOVE(PersistentVec)
+  STX_DISABLE_COPY(PersistentVec)
+  STX_DEFAULT_DESTRUCTOR(PersistentVec)
+  STX_MARK_TRIVIALLY_RELOCATABLE(PersistentVec)
+
+  Size size() const
+  {
+    return size_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  // another reference to this version, O(1)
+  PersistentVec share() const
+  {
+    return PersistentVec{allocator_, share_root(), size_, shift_};
+  }
+
+  Option<Ref<T const>> get(Index index) const
+  {
+    if (index >= size_)
+    {
+      return None;
+    }
+
+    Node const *node = root_.value().handle;
+
+    for (uint32_t shift = shift_; shift > 0; shift -= impl::PERSISTENT_BITS)
+    {
+      node = node->children.data()[(index >> shift) & impl::PERSISTENT_MASK].handle;
+    }
+
+    return Some<Ref<T const>>(node->values.data()[index & impl::PERSISTENT_MASK]);
+  }
+
+  // a new version with `value` appended
+  //
+  // returns the error if memory allocation fails
+  Result<PersistentVec, AllocError> push(T &&value) const
+  {
+    if (root_.is_none())
+    {
+      TRY_OK(leaf, new_path(0, std::move(value)));
+      return Ok(PersistentVec{allocator_, Some(std::move(leaf)), 1, 0});
+    }
+
+    // the trie is full, add a level
+    if (size_ == (Size{1} << (shift_ + impl::PERSISTENT_BITS)))
+    {
+      Vec<NodeRc> children{allocator_};
+
+      TRY_OK(path, new_path(shift_, std::move(value)));
+      TRY_OK(ok, children.reserve(2));
+
+      (void) ok;
+
+      children.push(root_.value().share()).unwrap();
+      children.push(std::move(path)).unwrap();
+
+      TRY_OK(root, make_node(std::move(children), Vec<T>{allocator_}));
+
+      return Ok(PersistentVec{allocator_, Some(std::move(root)), size_ + 1, shift_ + impl::PERSISTENT_BITS});
+    }
+
+    TRY_OK(root, push_into(root_.value(), shift_, size_, std::move(value)));
+
+    return Ok(PersistentVec{allocator_, Some(std::move(root)), size_ + 1, shift_});
+  }
+
+  // a new version with the element at `index` replaced by `value`
+  //
+  // returns the error if memory allocation fails
+  Result<PersistentVec, AllocError> set(Index index, T &&value) const
+  {
+    STX_SPAN_ENSURE(index < size_, "index out of bounds");
+
+    TRY_OK(root, set_in(root_.value(), shift_, index, std::move(value)));
+
+    return Ok(PersistentVec{allocator_, Some(std::move(root)), size_, shift_});
+  }
+
+  // a new version without the last element
+  //
+  // returns the error if memory allocation fails
+  Result<PersistentVec, AllocError> pop() const
+  {
+    if (size_ <= 1)
+    {
+      return Ok(PersistentVec{allocator_});
+    }
+
+    TRY_OK(popped, pop_from(root_.value(), shift_, size_ - 1));
+
+    NodeRc   root  = std::move(popped).unwrap();
+    uint32_t shift = shift_;
+
+    // remove the levels that only have one child
+    while (shift > 0 && root.handle->children.size() == 1)
+    {
+      NodeRc child = root.handle->children.data()[0].share();
+      root         = std::move(child);
+      shift -= impl::PERSISTENT_BITS;
+    }
+
+    return Ok(PersistentVec{allocator_, Some(std::move(root)), size_ - 1, shift});
+  }
+
+  // calls `func` with each element, in order
+  template <typename Func>
+  void for_each(Func &&func) const
+  {
+    if (root_.is_some())
+    {
+      for_each_in(*root_.value().handle, func);
+    }
+  }
+
+  Allocator      allocator_;
+  Option<NodeRc> root_;
+  Size           size_  = 0;
+  uint32_t       shift_ = 0;
+
+private:
+  Option<NodeRc> share_root() const
+  {
+    if (root_.is_none())
+    {
+      return None;
+    }
+
+    return Some(root_.value().share());
+  }
+
+  Result<NodeRc, AllocError> make_node(Vec<NodeRc> children, Vec<T> values) const
+  {
+    return rc::make(allocator_, Node{std::move(children), std::move(values)});
+  }
+
+  // a chain of nodes down to a leaf containing only `value`
+  Result<NodeRc, AllocError> new_path(uint32_t shift, T &&value) const
+  {
+    if (shift == 0)
+    {
+      Vec<T> values{allocator_};
+      TRY_OK(ok, values.push(std::move(value)));
+      (void) ok;
+      return make_node(Vec<NodeRc>{allocator_}, std::move(values));
+    }
+
+    TRY_OK(child, new_path(shift - impl::PERSISTENT_BITS, std::move(value)));
+
+    Vec<NodeRc> children{allocator_};
+    TRY_OK(ok, children.push(std::move(child)));
+    (void) ok;
+
+    return make_node(std::move(children), Vec<T>{allocator_});
+  }
+
+  Result<NodeRc, AllocError> push_into(NodeRc const &node, uint32_t shift, Index index, T &&value) const
+  {
+    if (shift == 0)
+    {
+      TRY_OK(values, node.handle->values.copy(allocator_));
+      TRY_OK(ok, values.push(std::move(value)));
+      (void) ok;
+      return make_node(Vec<NodeRc>{allocator_}, std::move(values));
+    }
+
+    TRY_OK(children, impl::share_all(allocator_, node.handle->children.span().as_const()));
+
+    Index const child_index = (index >> shift) & impl::PERSISTENT_MASK;
+
+    if (child_index < children.size())
+    {
+      TRY_OK(child, push_into(children.data()[child_index], shift - impl::PERSISTENT_BITS, index, std::move(value)));
+      children.data()[child_index] = std::move(child);
+    }
+    else
+    {
+      TRY_OK(child, new_path(shift - impl::PERSISTENT_BITS, std::move(value)));
+      TRY_OK(ok, children.push(std::move(child)));
+      (void) ok;
+    }
+
+    return make_node(std::move(children), Vec<T>{allocator_});
+  }
+
+  Result<NodeRc, AllocError> set_in(NodeRc const &node, uint32_t shift, Index index, T &&value) const
+  {
+    if (shift == 0)
+    {
+      TRY_OK(values, node.handle->values.copy(allocator_));
+      values.data()[index & impl::PERSISTENT_MASK] = std::move(value);
+      return make_node(Vec<NodeRc>{allocator_}, std::move(values));
+    }
+
+    TRY_OK(children, impl::share_all(allocator_, node.handle->children.span().as_const()));
+
+    Index const child_index = (index >> shift) & impl::PERSISTENT_MASK;
+
+    TRY_OK(child, set_in(children.data()[child_index], shift - impl::PERSISTENT_BITS, index, std::move(value)));
+    children.data()[child_index] = std::move(child);
+
+    return make_node(std::move(children), Vec<T>{allocator_});
+  }
+
+  // removes the element at `index` (the last element). returns None if the
+  // node becomes empty.
+  Result<Option<NodeRc>, AllocError> pop_from(NodeRc const &node, uint32_t shift, Index index) const
+  {
+    if (shift == 0)
+    {
+      if ((index & impl::PERSISTENT_MASK) == 0)
+      {
+        return Ok(Option<NodeRc>{None});
+      }
+
+      TRY_OK(values, node.handle->values.copy(allocator_));
+      (void) values.pop();
+      TRY_OK(leaf, make_node(Vec<NodeRc>{allocator_}, std::move(values)));
+      return Ok(Option<NodeRc>{Some(std::move(leaf))});
+    }
+
+    Index const child_index = (index >> shift) & impl::PERSISTENT_MASK;
+
+    TRY_OK(child, pop_from(node.handle->children.data()[child_index], shift - impl::PERSISTENT_BITS, index));
+
+    if (child.is_none() && child_index == 0)
+    {
+      return Ok(Option<NodeRc>{None});
+    }
+
+    TRY_OK(children, impl::share_all(allocator_, node.handle->children.span().as_const()));
+
+    if (child.is_none())
+    {
+      (void) children.pop();
+    }
+    else
+    {
+      children.data()[child_index] = std::move(child).unwrap();
+    }
+
+    TRY_OK(new_node, make_node(std::move(children), Vec<T>{allocator_}));
+
+    return Ok(Option<NodeRc>{Some(std::move(new_node))});
+  }
+
+  template <typename Func>
+  static void for_each_in(Node const &node, Func &func)
+  {
+    for (T const &value : node.values)
+    {
+      func(value);
+    }
+
+    for (NodeRc const &child : node.children)
+    {
+      for_each_in(*child.handle, func);
+    }
+  }
+};
+
+// PersistentMap is an immutable hash map with structural sharing (a
+// hash array mapped trie).
+//
+// updates return a new version that shares all but the `O(log32 n)` nodes on
+// the path to the updated entry with the old version. see `PersistentVec`.
+//
+// `K` and `V` must be copy-constructible since the entries of the nodes on the
+// updated path are copied.
+//
+template <typename K, typename V, typename Hasher = Hash<K>>
+struct PersistentMap
+{
+  static_assert(!std::is_reference_v<K> && !std::is_reference_v<V>);
+  static_assert(std::is_copy_constructible_v<K> && std::is_copy_constructible_v<V>);
+
+  using Size   = size_t;
+  using Entry  = HashMapEntry<K, V>;
+  using Node   = impl::PersistentMapNode<K, V>;
+  using NodeRc = Rc<Node *>;
+
+  // number of hash bits
+  static constexpr uint32_t HASH_BITS = 64;
+
+  explicit PersistentMap(Allocator allocator) :
+      allocator_{allocator}, root_{None}, size_{0}
+  {}
+
+  PersistentMap(Allocator allocator, Option<NodeRc> root, Size size) :
+      allocator_{allocator}, root_{std::move(root)}, size_{size}
+  {}
+
+  STX_DEFAULT_MOVE(PersistentMap)
+  STX_DISABLE_COPY(PersistentMap)
+  STX_DEFAULT_DESTRUCTOR(PersistentMap)
+  STX_MARK_TRIVIALLY_RELOCATABLE(PersistentMap)
+
+  Size size() const
+  {
+    return size_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  // another reference to this version, O(1)
+  PersistentMap share() const
+  {
+    if (root_.is_none())
+    {
+      return PersistentMap{allocator_};
+    }
+
+    return PersistentMap{allocator_, Some(root_.value().share()), size_};
+  }
+
+  Option<Ref<V const>> get(K const &key) const
+  {
+    if (root_.is_none())
+    {
+      return None;
+    }
+
+    HashValue const hash  = Hasher{}(key);
+    Node const     *node  = root_.value().handle;
+    uint32_t        shift = 0;
+
+    while (shift < HASH_BITS)
+    {
+      uint32_t const bit = fragment_bit(hash, shift);
+
+      if (node->entry_map & bit)
+      {
+        Entry const &entry = node->entries.data()[popcount(node->entry_map & (bit - 1))];
+
+        if (entry.key == key)
+        {
+          return Some<Ref<V const>>(entry.value);
+        }
+
+        return None;
+      }
+
+      if (!(node->child_map & bit))
+      {
+        return None;
+      }
+
+      node = node->children.data()[popcount(node->child_map & (bit - 1))].handle;
+      shift += impl::PERSISTENT_BITS;
+    }
+
+    for (Entry const &entry : node->entries)
+    {
+      if (entry.key == key)
+      {
+        return Some<Ref<V const>>(entry.value);
+      }
+    }
+
+    return None;
+  }
+
+  bool contains(K const &key) const
+  {
+    return get(key).is_some();
+  }
+
+  // a new version with the entry inserted, or the value of the existing entry
+  // with `key` replaced
+  //
+  // returns the error if memory allocation fails
+  Result<PersistentMap, AllocError> insert(K &&key, V &&value) const
+  {
+    HashValue const hash     = Hasher{}(key);
+    bool            inserted = false;
+
+    if (root_.is_none())
+    {
+      Vec<Entry> entries{allocator_};
+      TRY_OK(ok, entries.push(Entry{std::move(key), std::move(value)}));
+      (void) ok;
+      TRY_OK(root, make_node(fragment_bit(hash, 0), 0, std::move(entries), Vec<NodeRc>{allocator_}));
+      return Ok(PersistentMap{allocator_, Some(std::move(root)), 1});
+    }
+
+    TRY_OK(root, insert_into(*root_.value().handle, 0, hash, Entry{std::move(key), std::move(value)}, inserted));
+
+    return Ok(PersistentMap{allocator_, Some(std::move(root)), inserted ? size_ + 1 : size_});
+  }
+
+  // a new version without the entry with `key`
+  //
+  // returns the error if memory allocation fails
+  Result<PersistentMap, AllocError> remove(K const &key) const
+  {
+    if (root_.is_none())
+    {
+      return Ok(share());
+    }
+
+    bool removed = false;
+
+    TRY_OK(root, remove_from(root_.value(), 0, Hasher{}(key), key, removed));
+
+    if (!removed)
+    {
+      return Ok(share());
+    }
+
+    return Ok(PersistentMap{allocator_, std::move(root), size_ - 1});
+  }
+
+  // calls `func` with each entry, in no particular order
+  template <typename Func>
+  void for_each(Func &&func) const
+  {
+    if (root_.is_some())
+    {
+      for_each_in(*root_.value().handle, func);
+    }
+  }
+
+  Allocator      allocator_;
+  Option<NodeRc> root_;
+  Size           size_ = 0;
+
+private:
+  static uint32_t fragment_bit(HashValue hash, uint32_t shift)
+  {
+    return uint32_t{1} << ((hash >> shift) & impl::PERSISTENT_MASK);
+  }
+
+  Result<NodeRc, AllocError> make_node(uint32_t entry_map, uint32_t child_map, Vec<Entry> entries, Vec<NodeRc> children) const
+  {
+    return rc::make(allocator_, Node{entry_map, child_map, std::move(entries), std::move(children)});
+  }
+
+  // a node containing two entries whose hashes are equal up to `shift`
+  Result<NodeRc, AllocError> merge(uint32_t shift, Entry &&a, HashValue a_hash, Entry &&b, HashValue b_hash) const
+  {
+    Vec<Entry>  entries{allocator_};
+    Vec<NodeRc> children{allocator_};
+
+    if (shift >= HASH_BITS)
+    {
+      TRY_OK(ok, entries.reserve(2));
+      (void) ok;
+      entries.push(std::move(a)).unwrap();
+      entries.push(std::move(b)).unwrap();
+      return make_node(0, 0, std::move(entries), std::move(children));
+    }
+
+    uint32_t const a_bit = fragment_bit(a_hash, shift);
+    uint32_t const b_bit = fragment_bit(b_hash, shift);
+
+    if (a_bit == b_bit)
+    {
+      TRY_OK(child, merge(shift + impl::PERSISTENT_BITS, std::move(a), a_hash, std::move(b), b_hash));
+      TRY_OK(ok, children.push(std::move(child)));
+      (void) ok;
+      return make_node(0, a_bit, std::move(entries), std::move(children));
+    }
+
+    TRY_OK(ok, entries.reserve(2));
+    (void) ok;
+
+    if (a_bit < b_bit)
+    {
+      entries.push(std::move(a)).unwrap();
+      entries.push(std::move(b)).unwrap();
+    }
+    else
+    {
+      entries.push(std::move(b)).unwrap();
+      entries.push(std::move(a)).unwrap();
+    }
+
+    return make_node(a_bit | b_bit, 0, std::move(entries), std::move(children));
+  }
+
+  Result<NodeRc, AllocError> insert_into(Node const &node, uint32_t shift, HashValue hash, Entry &&entry, bool &inserted) const
+  {
+    TRY_OK(entries, node.entries.copy(allocator_));
+    TRY_OK(children, impl::share_all(allocator_, node.children.span().as_const()));
+
+    uint32_t entry_map = node.entry_map;
+    uint32_t child_map = node.child_map;
+
+    if (shift >= HASH_BITS)
+    {
+      for (Entry &existing : entries)
+      {
+        if (existing.key == entry.key)
+        {
+          existing.value = std::move(entry.value);
+          return make_node(0, 0, std::move(entries), std::move(children));
+        }
+      }
+
+      TRY_OK(ok, entries.push(std::move(entry)));
+      (void) ok;
+      inserted = true;
+
+      return make_node(0, 0, std::move(entries), std::move(children));
+    }
+
+    uint32_t const bit         = fragment_bit(hash, shift);
+    size_t const   entry_index = popcount(entry_map & (bit - 1));
+    size_t const   child_index = popcount(child_map & (bit - 1));
+
+    if (entry_map & bit)
+    {
+      Entry &existing = entries.data()[entry_index];
+
+      if (existing.key == entry.key)
+      {
+        existing.value = std::move(entry.value);
+        return make_node(entry_map, child_map, std::move(entries), std::move(children));
+      }
+
+      // move both entries down into a new sub-trie
+      HashValue const existing_hash = Hasher{}(existing.key);
+
+      TRY_OK(child, merge(shift + impl::PERSISTENT_BITS, Entry{existing}, existing_hash, std::move(entry), hash));
+
+      TRY_OK(ok, impl::vec_insert(children, child_index, std::move(child)));
+      (void) ok;
+
+      entries.erase(entries.span().slice(entry_index, 1));
+      entry_map &= ~bit;
+      child_map |= bit;
+      inserted = true;
+
+      return make_node(entry_map, child_map, std::move(entries), std::move(children));
+    }
+
+    if (child_map & bit)
+    {
+      TRY_OK(child, insert_into(*children.data()[child_index].handle, shift + impl::PERSISTENT_BITS, hash, std::move(entry), inserted));
+      children.data()[child_index] = std::move(child);
+      return make_node(entry_map, child_map, std::move(entries), std::move(children));
+    }
+
+    TRY_OK(ok, impl::vec_insert(entries, entry_index, std::move(entry)));
+    (void) ok;
+
+    entry_map |= bit;
+    inserted = true;
+
+    return make_node(entry_map, child_map, std::move(entries), std::move(children));
+  }
+
+  // returns None if the node becomes empty
+  Result<Option<NodeRc>, AllocError> remove_from(NodeRc const &node_rc, uint32_t shift, HashValue hash, K const &key, bool &removed) const
+  {
+    Node const &node = *node_rc.handle;
+
+    uint32_t entry_map = node.entry_map;
+    uint32_t child_map = node.child_map;
+    size_t   remove_at = 0;
+
+    if (shift >= HASH_BITS)
+    {
+      Span<Entry const> entries = node.entries.span();
+
+      remove_at = entries.which([&key](Entry const &entry) { return entry.key == key; }).data() - entries.data();
+
+      if (remove_at == entries.size())
+      {
+        return Ok(Option<NodeRc>{Some(node_rc.share())});
+      }
+    }
+    else
+    {
+      uint32_t const bit = fragment_bit(hash, shift);
+
+      if (child_map & bit)
+      {
+        size_t const child_index = popcount(child_map & (bit - 1));
+
+        TRY_OK(child, remove_from(node.children.data()[child_index], shift + impl::PERSISTENT_BITS, hash, key, removed));
+
+        if (!removed)
+        {
+          return Ok(Option<NodeRc>{Some(node_rc.share())});
+        }
+
+        TRY_OK(entries, node.entries.copy(allocator_));
+        TRY_OK(children, impl::share_all(allocator_, node.children.span().as_const()));
+
+        if (child.is_none())
+        {
+          children.erase(children.span().slice(child_index, 1));
+          child_map &= ~bit;
+
+          if (entry_map == 0 && child_map == 0)
+          {
+            return Ok(Option<NodeRc>{None});
+          }
+        }
+        else
+        {
+          children.data()[child_index] = std::move(child).unwrap();
+        }
+
+        TRY_OK(new_node, make_node(entry_map, child_map, std::move(entries), std::move(children)));
+
+        return Ok(Option<NodeRc>{Some(std::move(new_node))});
+      }
+
+      if (!(entry_map & bit) || !(node.entries.data()[popcount(entry_map & (bit - 1))].key == key))
+      {
+        return Ok(Option<NodeRc>{Some(node_rc.share())});
+      }
+
+      remove_at = popcount(entry_map & (bit - 1));
+      entry_map &= ~bit;
+    }
+
+    removed = true;
+
+    if (node.entries.size() == 1 && node.children.is_empty())
+    {
+      return Ok(Option<NodeRc>{None});
+    }
+
+    TRY_OK(entries, node.entries.copy(allocator_));
+    TRY_OK(children, impl::share_all(allocator_, node.children.span().as_const()));
+
+    entries.erase(entries.span().slice(remove_at, 1));
+
+    TRY_OK(new_node, make_node(entry_map, child_map, std::move(entries), std::move(children)));
+
+    return Ok(Option<NodeRc>{Some(std::move(new_node))});
+  }
+
+  template <typename Func>
+  static void for_each_in(Node const &node, Func &func)
+  {
+    for (Entry const &entry : node.entries)
+    {
+      func(entry.key, entry.value);
+    }
+
+    for (NodeRc const &child : node.children)
+    {
+      for_each_in(*child.handle, func);
+    }
+  }
+};
+
+STX_END_NAMESPACE
@@ -11,6 +11,7 @@
 #include "stx/manager.h"
 #include "stx/memory.h"
 #include "stx/rc.h"
+#include "stx/relocate.h"
 #include "stx/result.h"
 #include "stx/struct.h"
 #include "stx/try_ok.h"
@@ -89,6 +90,8 @@ struct Rc
 
   Rc &operator=(Rc const &other) = delete;
 
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(Rc, is_trivially_relocatable<handle_type>)
+
   ~Rc()
   {
     manager.unref();
@@ -133,6 +136,8 @@ struct Rc<Object *>
 
   Rc &operator=(Rc const &other) = delete;
 
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(Rc, is_trivially_relocatable<handle_type>)
+
   ~Rc()
   {
     manager.unref();
@@ -196,6 +201,8 @@ struct Unique
   Unique(Unique const &other)            = delete;
   Unique &operator=(Unique const &other) = delete;
 
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(Unique, is_trivially_relocatable<handle_type>)
+
   ~Unique()
   {
     manager.unref();
@@ -235,6 +242,8 @@ struct Unique<Object *>
 
   Unique &operator=(Unique const &other) = delete;
 
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(Unique, is_trivially_relocatable<handle_type>)
+
   ~Unique()
   {
     manager.unref();
@@ -326,11 +335,12 @@ struct RefCount
     return ref_count.fetch_add(1, std::memory_order_relaxed);
   }
 
-  // required to be acquire memory order since it could have been modified and
-  // we need to ensure proper instruction ordering
+  // required to be acquire-release memory order: every owner's accesses to the
+  // object must happen before the last owner destroys it, so each decrement
+  // releases them and the last decrement acquires all of them.
   [[nodiscard]] uint64_t unref()
   {
-    return ref_count.fetch_sub(1, std::memory_order_acquire);
+    return ref_count.fetch_sub(1, std::memory_order_acq_rel);
   }
 };
 
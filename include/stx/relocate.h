@@ -0,0 +1,66 @@
+#pragma once
+
+#include <type_traits>
+
+#include "stx/config.h"
+
+STX_BEGIN_NAMESPACE
+
+/// # Trivial Relocation
+///
+/// relocating an object means moving it to a new address and ending the
+/// lifetime of the object at the old address. a trivially relocatable type is
+/// one for which this pair of operations (move-construct + destruct) is
+/// equivalent to copying its bytes to the new address and forgetting the old
+/// ones.
+///
+/// most STX resource types are just handles (pointers) whose move constructors
+/// unarm the moved-from object so its destructor becomes a no-op. i.e. `Rc`,
+/// `Memory`, `Vec`. these are not trivially move-constructible, but they are
+/// trivially relocatable, which lets containers grow with `realloc` and
+/// compact with `memmove` instead of moving and destructing element-by-element.
+///
+/// types opt-in by marking themselves with `STX_MARK_TRIVIALLY_RELOCATABLE` or
+/// `STX_MARK_TRIVIALLY_RELOCATABLE_IF` within their struct body. the mark names
+/// the marked type so it is not inherited by derived types which might
+/// contain non-relocatable members.
+///
+/// NOTE: a type must not be marked if it holds a pointer to itself or any of
+/// its members, or registers its address elsewhere (i.e. pinned types).
+///
+namespace impl
+{
+
+template <typename T, bool Relocatable>
+struct TriviallyRelocatableMark
+{
+  using type                  = T;
+  static constexpr bool value = Relocatable;
+};
+
+template <typename T, typename = void>
+struct is_trivially_relocatable_impl
+    : std::bool_constant<std::is_trivially_move_constructible_v<T> &&
+                         std::is_trivially_destructible_v<T>>
+{};
+
+template <typename T>
+struct is_trivially_relocatable_impl<T, std::void_t<typename T::StxTriviallyRelocatableMark>>
+    : std::bool_constant<(std::is_same_v<typename T::StxTriviallyRelocatableMark::type, T> &&
+                          T::StxTriviallyRelocatableMark::value) ||
+                         (std::is_trivially_move_constructible_v<T> &&
+                          std::is_trivially_destructible_v<T>)>
+{};
+
+}        // namespace impl
+
+template <typename T>
+constexpr bool is_trivially_relocatable = impl::is_trivially_relocatable_impl<std::remove_cv_t<T>>::value;
+
+STX_END_NAMESPACE
+
+#define STX_MARK_TRIVIALLY_RELOCATABLE_IF(target_type, ...) \
+  using StxTriviallyRelocatableMark = ::stx::impl::TriviallyRelocatableMark<target_type, (__VA_ARGS__)>;
+
+#define STX_MARK_TRIVIALLY_RELOCATABLE(target_type) \
+  STX_MARK_TRIVIALLY_RELOCATABLE_IF(target_type, true)
@@ -14,9 +14,11 @@
 #include "stx/fn.h"
 #include "stx/option.h"
 #include "stx/rc.h"
+#include "stx/relocate.h"
 #include "stx/scheduler/thread_pool.h"
 #include "stx/scheduler/thread_slot.h"
 #include "stx/scheduler/timeline.h"
+#include "stx/slot_map.h"
 #include "stx/stream.h"
 #include "stx/string.h"
 #include "stx/task/chain.h"
@@ -34,6 +36,8 @@ struct TaskTraceInfo
 {
   Rc<std::string_view> content = string::rc::make_static_view("[Unspecified Context]");
   Rc<std::string_view> purpose = string::rc::make_static_view("[Unspecified Purpose]");
+
+  STX_MARK_TRIVIALLY_RELOCATABLE(TaskTraceInfo)
 };
 
 enum class TaskReady : uint8_t
@@ -90,6 +94,8 @@ struct Task
 
   // information needed for tracing & profiling of tasks
   TaskTraceInfo trace_info{};
+
+  STX_MARK_TRIVIALLY_RELOCATABLE(Task)
 };
 
 // scheduler just dispatches to the task timeline once the tasks are
@@ -111,17 +117,25 @@ struct TaskScheduler
   {
     TimePoint present = std::chrono::steady_clock::now();
 
-    Span ready_tasks = entries.span().partition([present](Task const &task) { return task.poll_ready.handle(present - task.schedule_timepoint) == TaskReady::No; }).second;
-
-    for (Task &task : ready_tasks)
+    // ready tasks are removed in O(1) each, the last entry is moved into the
+    // removed task's position so it is polled next
+    for (size_t i = 0; i < entries.size();)
     {
+      Task const &entry = entries.span()[i];
+
+      if (entry.poll_ready.handle(present - entry.schedule_timepoint) == TaskReady::No)
+      {
+        i++;
+        continue;
+      }
+
+      Task task = entries.remove_at(i);
+
       timeline
           .add_task(std::move(task.function), std::move(task.scheduler_promise), task.task_id, task.priority, present)
           .unwrap();
     }
 
-    entries.erase(ready_tasks);
-
     timeline.tick(thread_pool.get_thread_slots(), present);
     thread_pool.tick(interval);
 
@@ -136,7 +150,7 @@ struct TaskScheduler
 
   Allocator        allocator;
   TimePoint        reference_timepoint;
-  Vec<Task>        entries;
+  SlotMap<Task>    entries;
   Promise<void>    cancelation_promise;
   uint64_t         next_task_id;
   ThreadPool       thread_pool;
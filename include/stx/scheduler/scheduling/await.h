@@ -69,7 +69,7 @@ auto await(TaskScheduler &scheduler, Fn task, TaskPriority priority, TaskTraceIn
                     }).unwrap();
 
   scheduler.entries
-      .push(Task{std::move(fn), std::move(readiness_fn), std::move(task_promise), task_id, priority, timepoint, std::move(trace_info)})
+      .insert(Task{std::move(fn), std::move(readiness_fn), std::move(task_promise), task_id, priority, timepoint, std::move(trace_info)})
       .unwrap();
 
   return future;
@@ -134,7 +134,7 @@ auto await_any(TaskScheduler &scheduler, Fn task, TaskPriority priority, TaskTra
                     }).unwrap();
 
   scheduler.entries
-      .push(Task{std::move(fn), std::move(readiness_fn), std::move(task_promise), task_id, priority, timepoint, std::move(trace_info)})
+      .insert(Task{std::move(fn), std::move(readiness_fn), std::move(task_promise), task_id, priority, timepoint, std::move(trace_info)})
       .unwrap();
 
   return future;
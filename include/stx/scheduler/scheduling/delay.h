@@ -63,7 +63,7 @@ auto delay(TaskScheduler &scheduler, Fn fn_task, TaskPriority priority, TaskTrac
                           }).unwrap();
 
   scheduler.entries
-      .push(Task{std::move(sched_fn), std::move(readiness_fn), std::move(scheduler_promise), task_id, priority, timepoint, std::move(trace_info)})
+      .insert(Task{std::move(sched_fn), std::move(readiness_fn), std::move(scheduler_promise), task_id, priority, timepoint, std::move(trace_info)})
       .unwrap();
 
   return future;
@@ -60,7 +60,7 @@ auto fn(TaskScheduler &scheduler, Fn fn_task, TaskPriority priority, TaskTraceIn
                           }).unwrap();
 
   scheduler.entries
-      .push(Task{std::move(sched_fn), fn::rc::make_unique_static(task_is_ready), std::move(scheduler_promise), task_id, priority, timepoint, std::move(trace_info)})
+      .insert(Task{std::move(sched_fn), fn::rc::make_unique_static(task_is_ready), std::move(scheduler_promise), task_id, priority, timepoint, std::move(trace_info)})
       .unwrap();
 
   return future;
@@ -134,7 +134,7 @@ auto chain(TaskScheduler &scheduler, Chain<Fn, OtherFns...> chain,
                     }).unwrap();
 
   scheduler.entries
-      .push(Task{std::move(fn), fn::rc::make_unique_static(task_is_ready), std::move(scheduler_promise), task_id, priority, timepoint, std::move(trace_info)})
+      .insert(Task{std::move(fn), fn::rc::make_unique_static(task_is_ready), std::move(scheduler_promise), task_id, priority, timepoint, std::move(trace_info)})
       .unwrap();
 
   return future;
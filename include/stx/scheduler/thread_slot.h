@@ -6,6 +6,7 @@
 #include "stx/config.h"
 #include "stx/fn.h"
 #include "stx/option.h"
+#include "stx/relocate.h"
 #include "stx/spinlock.h"
 #include "stx/task/id.h"
 
@@ -27,6 +28,8 @@ struct ThreadSlot
   {
     RcFn<void()> fn;
     TaskId       id{};
+
+    STX_MARK_TRIVIALLY_RELOCATABLE(Task)
   };
 
   struct Query
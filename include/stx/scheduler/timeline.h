@@ -7,8 +7,11 @@
 #include <utility>
 
 #include "stx/async.h"
+#include "stx/bit_vec.h"
 #include "stx/config.h"
+#include "stx/hash_map.h"
 #include "stx/scheduler/thread_slot.h"
+#include "stx/soa_vec.h"
 #include "stx/task/id.h"
 #include "stx/task/priority.h"
 #include "stx/vec.h"
@@ -37,38 +40,42 @@ struct ScheduleTimeline
 {
   static constexpr nanoseconds STARVATION_PERIOD = 16ms * 4;
 
-  struct Task
-  {
-    // task to execute
-    RcFn<void()> fn = fn::rc::make_static([]() {});
+  // columns of the starvation timeline.
+  //
+  // the task records are stored as a structure-of-arrays since each pass over
+  // the timeline only touches one or two of the fields of each task.
+  //
+  // task to execute
+  static constexpr size_t FN = 0;
+
+  // used for book-keeping and notification of state
+  static constexpr size_t PROMISE = 1;
 
-    // used for book-keeping and notification of state
-    PromiseAny promise;
+  // assigned id of the task
+  static constexpr size_t ID = 2;
 
-    // assigned id of the task
-    TaskId id{};
+  // priority to use in evaluating CPU-time worthiness
+  static constexpr size_t PRIORITY = 3;
 
-    // priority to use in evaluating CPU-time worthiness
-    TaskPriority priority{NORMAL_PRIORITY};
+  // the timepoint the task became ready for execution. in the case of a
+  // suspended task, it correlates with the timepoint the task became ready
+  // for resumption
+  static constexpr size_t LAST_PREEMPT_TIMEPOINT = 4;
 
-    // the timepoint the task became ready for execution. in the case of a
-    // suspended task, it correlates with the timepoint the task became ready
-    // for resumption
-    TimePoint last_preempt_timepoint{};
+  // last known status of the task
+  static constexpr size_t LAST_STATUS_POLL = 5;
 
-    // last known status of the task
-    FutureStatus last_status_poll{FutureStatus::Preempted};
-  };
+  using Timeline = SoaVec<RcFn<void()>, PromiseAny, TaskId, TaskPriority, TimePoint, FutureStatus>;
 
   explicit ScheduleTimeline(Allocator allocator) :
-      starvation_timeline{allocator}, thread_slots_capture{allocator}
+      starvation_timeline{allocator}, thread_slots_capture{allocator}, slotted_tasks{allocator}, free_slots{allocator}
   {}
 
   Result<Void, AllocError> add_task(RcFn<void()> fn, PromiseAny promise, TaskId id, TaskPriority priority, TimePoint present_timepoint)
   {
     // task is ready to execute but preempteed upon adding
     promise.notify_preempted();
-    TRY_OK(ok, starvation_timeline.push(Task{std::move(fn), std::move(promise), id, priority, present_timepoint, FutureStatus::Preempted}));
+    TRY_OK(ok, starvation_timeline.push(std::move(fn), std::move(promise), std::move(id), std::move(priority), std::move(present_timepoint), FutureStatus::Preempted));
 
     (void) ok;
 
@@ -89,79 +96,89 @@ struct ScheduleTimeline
     // state before we attend to the request, our changes are ignored.
     //
     //
-    for (Task &task : starvation_timeline.span())
+    Span promises                = starvation_timeline.span<PROMISE>();
+    Span last_preempt_timepoints = starvation_timeline.span<LAST_PREEMPT_TIMEPOINT>();
+    Span last_status_polls       = starvation_timeline.span<LAST_STATUS_POLL>();
+
+    for (size_t i = 0; i < starvation_timeline.size(); i++)
     {
       // the status could have been modified in another thread, so we need
       // to fetch the status
-      FutureStatus new_status = task.promise.fetch_status();
+      FutureStatus new_status = promises[i].fetch_status();
 
       // if preempt timepoint not already updated, update it
-      if ((task.last_status_poll != FutureStatus::Preempted && new_status == FutureStatus::Preempted))
+      if ((last_status_polls[i] != FutureStatus::Preempted && new_status == FutureStatus::Preempted))
       {
-        task.last_preempt_timepoint = present_timepoint;
+        last_preempt_timepoints[i] = present_timepoint;
       }
 
-      task.last_status_poll = new_status;
+      last_status_polls[i] = new_status;
     }
   }
 
   void execute_resume_requests()
   {
-    for (Task &task : starvation_timeline)
+    Span promises          = starvation_timeline.span<PROMISE>();
+    Span last_status_polls = starvation_timeline.span<LAST_STATUS_POLL>();
+
+    for (size_t i = 0; i < starvation_timeline.size(); i++)
     {
-      if (task.last_status_poll == FutureStatus::Suspended && task.promise.fetch_suspend_request() == SuspendState::Executing)
+      if (last_status_polls[i] == FutureStatus::Suspended && promises[i].fetch_suspend_request() == SuspendState::Executing)
       {
         // make it ready for resumption/execution
-        task.promise.notify_preempted();
+        promises[i].notify_preempted();
       }
     }
   }
 
   void remove_done_tasks()
   {
-    Span done_tasks = starvation_timeline.span()
-                          .partition([](Task const &task) { return task.last_status_poll != FutureStatus::Completed && task.last_status_poll != FutureStatus::Canceled; })
-                          .second;
+    size_t num_pending = starvation_timeline.partition<LAST_STATUS_POLL>([](FutureStatus status) { return status != FutureStatus::Completed && status != FutureStatus::Canceled; });
 
-    starvation_timeline.erase(done_tasks);
+    starvation_timeline.erase(num_pending, starvation_timeline.size() - num_pending);
   }
 
   // returns number of selected tasks
   size_t select_tasks_for_slots(size_t num_slots)
   {
-    Span starving = starvation_timeline.span()
-                        // ASSUMPTION(unproven): The tasks are mostly sorted so we are very
-                        // unlikely to pay much cost in sorting???
-                        //
-                        // suspended tasks are not considered for execution
-                        //
-                        .partition([](Task const &task) { return task.last_status_poll == FutureStatus::Preempted || task.last_status_poll == FutureStatus::Executing; })
-                        .first
-                        // sort hungry tasks by preemption/starvation duration (most starved
-                        // first). Hence the starved tasks would ideally be more likely
-                        // chosen for execution
-                        .sort([](Task const &a, Task const &b) { return a.last_preempt_timepoint < b.last_preempt_timepoint; });
-
-    auto *selection = starving.begin();
-
-    TimePoint const most_starved_task_timepoint = starving[0].last_preempt_timepoint;
+    // suspended tasks are not considered for execution
+    size_t num_starving = starvation_timeline.partition<LAST_STATUS_POLL>([](FutureStatus status) { return status == FutureStatus::Preempted || status == FutureStatus::Executing; });
+
+    if (num_starving == 0)
+    {
+      return 0;
+    }
+
+    // ASSUMPTION(unproven): The tasks are mostly sorted so we are very
+    // unlikely to pay much cost in sorting???
+    //
+    // sort hungry tasks by preemption/starvation duration (most starved
+    // first). Hence the starved tasks would ideally be more likely
+    // chosen for execution
+    starvation_timeline.sort<LAST_PREEMPT_TIMEPOINT>(0, num_starving, [](TimePoint const &a, TimePoint const &b) { return a < b; });
+
+    Span starving = starvation_timeline.span<LAST_PREEMPT_TIMEPOINT>().slice(0, num_starving);
+
+    TimePoint const *selection = starving.begin();
+
+    TimePoint const most_starved_task_timepoint = starving[0];
 
     nanoseconds selection_period_span = STARVATION_PERIOD;
 
     while (selection < starving.end())
     {
-      if ((selection->last_preempt_timepoint - most_starved_task_timepoint) <= selection_period_span)
+      if ((*selection - most_starved_task_timepoint) <= selection_period_span)
       {
         // add to timeline selection
         selection++;
         continue;
       }
-      else if ((selection->last_preempt_timepoint - most_starved_task_timepoint) > selection_period_span && (static_cast<size_t>(selection - starving.begin()) < num_slots))
+      else if ((*selection - most_starved_task_timepoint) > selection_period_span && (static_cast<size_t>(selection - starving.begin()) < num_slots))
       {
         // if there's not enough tasks within the current starvation period span
         // to fill up all the slots then extend the starvation period span
         // (multiple enough to cover this selection's timepoint)
-        nanoseconds diff = selection->last_preempt_timepoint - most_starved_task_timepoint;
+        nanoseconds diff = *selection - most_starved_task_timepoint;
 
         // (STARVATION_PERIOD-1ns) added since division by STARVATION_PERIOD
         // ONLY will result in the remainder of the division operation being
@@ -179,11 +196,11 @@ struct ScheduleTimeline
       }
     }
 
-    // sort selection span by priority
-    std::sort(starving.begin(), selection, [](Task const &a, Task const &b) { return a.priority > b.priority; });
-
     size_t num_selected = selection - starving.begin();
 
+    // sort selection span by priority
+    starvation_timeline.sort<PRIORITY>(0, num_selected, [](TaskPriority a, TaskPriority b) { return a > b; });
+
     // the number of selected starving tasks might be more than the number of
     // available ones, so we select the top tasks (by priority)
     num_selected = std::min(num_slots, num_selected);
@@ -206,6 +223,32 @@ struct ScheduleTimeline
     // fetch the status of each thread slot
     slots.map([](Rc<ThreadSlot *> const &rc_slot) { return rc_slot.handle->slot.query(); }, thread_slots_capture.span());
 
+    // index the tasks already on the slots so the selected tasks' slot
+    // lookups don't need to scan all the slots
+    slotted_tasks.clear();
+    free_slots.clear();
+    free_slots.resize(num_slots).unwrap();
+
+    for (size_t slot = 0; slot < num_slots; slot++)
+    {
+      ThreadSlot::Query const &query = thread_slots_capture[slot];
+
+      if (query.can_push)
+      {
+        free_slots.set(slot);
+      }
+
+      if (query.executing_task.is_some())
+      {
+        slotted_tasks.insert(TaskId{query.executing_task.value()}).unwrap();
+      }
+
+      if (query.pending_task.is_some())
+      {
+        slotted_tasks.insert(TaskId{query.pending_task.value()}).unwrap();
+      }
+    }
+
     poll_tasks(present_timepoint);
     execute_resume_requests();
     remove_done_tasks();
@@ -225,9 +268,9 @@ struct ScheduleTimeline
     // we don't expect just-suspended tasks to suspend immediately, even if
     // they do we'll process them in the next tick.
     //
-    for (Task const &task : starvation_timeline.span().slice(num_selected))
+    for (PromiseAny const &promise : starvation_timeline.span<PROMISE>().slice(num_selected))
     {
-      task.promise.request_preempt();
+      promise.request_preempt();
     }
 
     // push the tasks onto the task slots if the task is not already on any of
@@ -240,36 +283,43 @@ struct ScheduleTimeline
     // add tasks to slot if not already on the slots
     size_t next_slot = 0;
 
-    for (Task const &task : starvation_timeline.span().slice(0, num_selected))
+    Span fns      = starvation_timeline.span<FN>();
+    Span promises = starvation_timeline.span<PROMISE>();
+    Span ids      = starvation_timeline.span<ID>();
+
+    for (size_t i = 0; i < num_selected; i++)
     {
-      bool has_slot = !thread_slots_capture.span().which([&task](ThreadSlot::Query const &query) { return query.executing_task.contains(task.id) || query.pending_task.contains(task.id); }).is_empty();
+      TaskId const id = ids[i];
 
-      if (has_slot)
+      if (slotted_tasks.contains(id))
       {
         continue;
       }
 
-      while (next_slot < num_slots && !has_slot)
+      Option<size_t> free_slot = free_slots.span().find_first_set(next_slot);
+
+      if (free_slot.is_none())
       {
-        if (thread_slots_capture[next_slot].can_push)
-        {
-          // possibly a preempted task.
-          // tasks are expected to check their request states.
-          //
-          // we have to unpreempt the task
-          //
-          task.promise.clear_preempt_request();
-          slots[next_slot].handle->slot.push_task(ThreadSlot::Task{task.fn.share(), task.id});
-          has_slot = true;
-        }
-
-        next_slot++;
+        break;
       }
+
+      // possibly a preempted task.
+      // tasks are expected to check their request states.
+      //
+      // we have to unpreempt the task
+      //
+      promises[i].clear_preempt_request();
+      slots[free_slot.value()].handle->slot.push_task(ThreadSlot::Task{fns[i].share(), id});
+
+      next_slot = free_slot.value() + 1;
     }
   }
 
-  Vec<Task>              starvation_timeline;
+  Timeline               starvation_timeline;
   Vec<ThreadSlot::Query> thread_slots_capture;
+  HashSet<TaskId>        slotted_tasks;
+  // thread slots that can accept a task
+  BitVec                 free_slots;
 };
 
 STX_END_NAMESPACE
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <cinttypes>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/config.h"
+#include "stx/option.h"
+#include "stx/relocate.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+// handle to an element of a `SlotMap`.
+//
+// the generation is bumped every time the element in a slot is removed, so a
+// key to a removed element never aliases an element inserted into the same slot
+// afterwards.
+struct SlotKey
+{
+  uint32_t index      = 0;
+  uint32_t generation = 0;
+
+  constexpr bool operator==(SlotKey const &other) const
+  {
+    return index == other.index && generation == other.generation;
+  }
+
+  constexpr bool operator!=(SlotKey const &other) const
+  {
+    return !(*this == other);
+  }
+};
+
+namespace impl
+{
+
+constexpr uint32_t SLOT_MAP_NO_FREE_SLOT = UINT32_MAX;
+
+// an occupied slot has an odd generation and points into the dense arrays.
+// a vacant slot has an even generation and points to the next vacant slot.
+struct SlotMapSlot
+{
+  uint32_t dense_index_or_next_free = SLOT_MAP_NO_FREE_SLOT;
+  uint32_t generation               = 0;
+
+  constexpr bool is_occupied() const
+  {
+    return (generation & 1) == 1;
+  }
+};
+
+}        // namespace impl
+
+// SlotMap is a container with stable generational keys and O(1) insertion,
+// removal, and lookup.
+//
+// the elements are stored densely (unordered) so they can be iterated over as
+// a contiguous span, a removal moves the last element into the removed
+// element's position.
+//
+// the allocator must be alive for the lifetime of the SlotMap.
+//
+// ONLY NON-CONST METHODS INVALIDATE ITERATORS AND REFERENCES. KEYS ARE ONLY
+// INVALIDATED BY REMOVING THEIR ELEMENTS.
+//
+template <typename T>
+struct SlotMap
+{
+  static_assert(!std::is_reference_v<T>);
+
+  using Size  = size_t;
+  using Index = size_t;
+
+  explicit SlotMap(Allocator allocator) :
+      values_{allocator},
+      dense_keys_{allocator},
+      slots_{allocator},
+      free_head_{impl::SLOT_MAP_NO_FREE_SLOT}
+  {}
+
+  SlotMap(SlotMap &&other) :
+      values_{std::move(other.values_)},
+      dense_keys_{std::move(other.dense_keys_)},
+      slots_{std::move(other.slots_)},
+      free_head_{other.free_head_}
+  {
+    other.free_head_ = impl::SLOT_MAP_NO_FREE_SLOT;
+  }
+
+  SlotMap &operator=(SlotMap &&other)
+  {
+    std::swap(values_, other.values_);
+    std::swap(dense_keys_, other.dense_keys_);
+    std::swap(slots_, other.slots_);
+    std::swap(free_head_, other.free_head_);
+
+    return *this;
+  }
+
+  STX_DISABLE_COPY(SlotMap)
+  STX_DEFAULT_DESTRUCTOR(SlotMap)
+  STX_MARK_TRIVIALLY_RELOCATABLE(SlotMap)
+
+  Size size() const
+  {
+    return values_.size();
+  }
+
+  bool is_empty() const
+  {
+    return values_.is_empty();
+  }
+
+  // the elements, in no particular order
+  Span<T> span() const
+  {
+    return values_.span();
+  }
+
+  // the key of each element in `span`
+  Span<SlotKey const> keys() const
+  {
+    return dense_keys_.span();
+  }
+
+  bool contains(SlotKey key) const
+  {
+    return find_dense_index(key).is_some();
+  }
+
+  Option<Ref<T>> get(SlotKey key) const
+  {
+    Option<Index> dense_index = find_dense_index(key);
+
+    if (dense_index.is_none())
+    {
+      return None;
+    }
+
+    return Some<Ref<T>>(values_.data()[dense_index.value()]);
+  }
+
+  // reserve enough memory to contain at least `cap` elements
+  //
+  // invalidates references
+  //
+  Result<Void, AllocError> reserve(Size cap)
+  {
+    TRY_OK(values_ok, values_.reserve(cap));
+    TRY_OK(keys_ok, dense_keys_.reserve(cap));
+    TRY_OK(slots_ok, slots_.reserve(cap));
+
+    (void) values_ok;
+    (void) keys_ok;
+    (void) slots_ok;
+
+    return Ok(Void{});
+  }
+
+  // invalidates references
+  //
+  // value is not moved if an allocation error occurs
+  Result<SlotKey, AllocError> insert(T &&value)
+  {
+    // reserve everything upfront so the containers are left untouched if any
+    // of them fail to grow
+    TRY_OK(ok, reserve(impl::grow_vec(values_.capacity(), values_.size() + 1)));
+
+    (void) ok;
+
+    uint32_t const dense_index = static_cast<uint32_t>(values_.size());
+    uint32_t       slot_index  = free_head_;
+
+    if (slot_index == impl::SLOT_MAP_NO_FREE_SLOT)
+    {
+      slot_index = static_cast<uint32_t>(slots_.size());
+      slots_.push(impl::SlotMapSlot{}).unwrap();
+    }
+    else
+    {
+      free_head_ = slots_.data()[slot_index].dense_index_or_next_free;
+    }
+
+    impl::SlotMapSlot &slot = slots_.data()[slot_index];
+
+    slot.dense_index_or_next_free = dense_index;
+    slot.generation++;
+
+    SlotKey const key{slot_index, slot.generation};
+
+    values_.push(std::move(value)).unwrap();
+    dense_keys_.push(SlotKey{key}).unwrap();
+
+    return Ok(SlotKey{key});
+  }
+
+  // removes the element with `key` and returns it, if any
+  //
+  // invalidates references
+  Option<T> remove(SlotKey key)
+  {
+    Option<Index> dense_index = find_dense_index(key);
+
+    if (dense_index.is_none())
+    {
+      return None;
+    }
+
+    return Some(remove_at(dense_index.value()));
+  }
+
+  // removes the element at `dense_index` of `span` and returns it. the last
+  // element is moved into its position.
+  //
+  // invalidates references
+  T remove_at(Index dense_index)
+  {
+    STX_SPAN_ENSURE(dense_index < size(), "index out of bounds");
+
+    Index const last = size() - 1;
+
+    impl::SlotMapSlot &slot = slots_.data()[dense_keys_.data()[dense_index].index];
+
+    slot.dense_index_or_next_free = free_head_;
+    slot.generation++;
+    free_head_ = dense_keys_.data()[dense_index].index;
+
+    T value = std::move(values_.data()[dense_index]);
+
+    if (dense_index != last)
+    {
+      values_.data()[dense_index]     = std::move(values_.data()[last]);
+      dense_keys_.data()[dense_index] = dense_keys_.data()[last];
+
+      slots_.data()[dense_keys_.data()[dense_index].index].dense_index_or_next_free = static_cast<uint32_t>(dense_index);
+    }
+
+    (void) values_.pop();
+    (void) dense_keys_.pop();
+
+    return value;
+  }
+
+  // all keys are invalidated. capacity is unchanged
+  void clear()
+  {
+    while (!is_empty())
+    {
+      remove_at(size() - 1);
+    }
+  }
+
+  Vec<T>                 values_;
+  Vec<SlotKey>           dense_keys_;
+  Vec<impl::SlotMapSlot> slots_;
+  uint32_t               free_head_ = impl::SLOT_MAP_NO_FREE_SLOT;
+
+private:
+  Option<Index> find_dense_index(SlotKey key) const
+  {
+    if (key.index >= slots_.size())
+    {
+      return None;
+    }
+
+    impl::SlotMapSlot const &slot = slots_.data()[key.index];
+
+    if (slot.generation != key.generation || !slot.is_occupied())
+    {
+      return None;
+    }
+
+    return Some(Index{slot.dense_index_or_next_free});
+  }
+};
+
+STX_END_NAMESPACE
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/config.h"
+#include "stx/relocate.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+// SoaVec (structure-of-arrays vec) maintains a sequence of records whose fields
+// are each stored in their own contiguous allocator-backed array (column).
+//
+// algorithms that only touch one or two fields of each record (i.e. polling
+// statuses or sorting by a timepoint) only pull those fields' columns through
+// the cache instead of whole records.
+//
+// all columns always have the same size. insertions, removals, partitioning,
+// and sorting are applied across all columns so the `i`th element of each
+// column always belongs to the same record.
+//
+// partitioning and sorting compute an index permutation using a scratch
+// column that is grown alongside the others, so they never allocate.
+//
+// ONLY NON-CONST METHODS INVALIDATE ITERATORS
+//
+template <typename... Fields>
+struct SoaVec
+{
+  static_assert(sizeof...(Fields) > 0);
+  static_assert((!std::is_reference_v<Fields> && ...));
+
+  using Size  = size_t;
+  using Index = size_t;
+
+  template <Index I>
+  using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+  static constexpr Size NUM_FIELDS = sizeof...(Fields);
+
+  explicit SoaVec(Allocator allocator) :
+      columns_{Vec<Fields>{allocator}...}, permutation_{allocator}, capacity_{0}
+  {}
+
+  STX_DEFAULT_MOVE(SoaVec)
+  STX_DISABLE_COPY(SoaVec)
+  STX_DEFAULT_DESTRUCTOR(SoaVec)
+  STX_MARK_TRIVIALLY_RELOCATABLE(SoaVec)
+
+  Size size() const
+  {
+    return std::get<0>(columns_).size();
+  }
+
+  Size capacity() const
+  {
+    return capacity_;
+  }
+
+  bool is_empty() const
+  {
+    return size() == 0;
+  }
+
+  // the column containing the `I`th field of every record
+  template <Index I>
+  Span<Field<I>> span() const
+  {
+    return std::get<I>(columns_).span();
+  }
+
+  // reserve enough memory in all the columns to contain at least `cap`
+  // records
+  //
+  // returns the error if memory allocation fails. the records are unaffected
+  // if any of the columns fail to grow.
+  //
+  // invalidates references
+  //
+  Result<Void, AllocError> reserve(Size cap)
+  {
+    if (cap <= capacity_)
+    {
+      return Ok(Void{});
+    }
+
+    if (!reserve_columns(cap, std::index_sequence_for<Fields...>{}) ||
+        permutation_.reserve(cap).is_err())
+    {
+      return Err(AllocError::NoMemory);
+    }
+
+    capacity_ = cap;
+
+    return Ok(Void{});
+  }
+
+  // invalidates references
+  //
+  // values are not moved if an allocation error occurs
+  Result<Void, AllocError> push(Fields &&...fields)
+  {
+    TRY_OK(ok, reserve(impl::grow_vec(capacity_, size() + 1)));
+
+    (void) ok;
+
+    push_columns(std::index_sequence_for<Fields...>{}, std::move(fields)...);
+
+    return Ok(Void{});
+  }
+
+  // removes `count` records starting at `offset` from all the columns.
+  //
+  // `capacity` is unchanged
+  void erase(Index offset, Size count)
+  {
+    STX_SPAN_ENSURE(offset <= size() && count <= size() - offset,
+                    "erase operation out of SoaVec range");
+    erase_columns(offset, count, std::index_sequence_for<Fields...>{});
+  }
+
+  // capacity is unchanged
+  void clear()
+  {
+    erase(0, size());
+  }
+
+  // swaps the records at indices `a` and `b` across all the columns
+  void swap(Index a, Index b)
+  {
+    swap_columns(a, b, std::index_sequence_for<Fields...>{});
+  }
+
+  // reorders the records such that the records whose `I`th field satisfies
+  // the predicate appear before those that don't. the relative order of the
+  // records within each partition is preserved.
+  //
+  // returns the number of records in the first partition.
+  template <Index I, typename Predicate>
+  Size partition(Predicate &&predicate)
+  {
+    static_assert(std::is_invocable_v<Predicate, Field<I> const &>);
+    static_assert(std::is_convertible_v<std::invoke_result_t<Predicate, Field<I> const &>, bool>);
+
+    Size const           num_records = size();
+    Span<Field<I> const> column      = span<I>();
+    Span<Size>           permutation = get_permutation();
+
+    Size front = 0;
+    Size back  = num_records;
+
+    for (Index i = 0; i < num_records; i++)
+    {
+      if (predicate(column.data()[i]))
+      {
+        permutation.data()[front] = i;
+        front++;
+      }
+      else
+      {
+        back--;
+        permutation.data()[back] = i;
+      }
+    }
+
+    // the second partition's indices were placed in reverse order
+    std::reverse(permutation.begin() + front, permutation.end());
+
+    permute(permutation);
+
+    return front;
+  }
+
+  // sorts the `count` records starting at `offset` by their `I`th field
+  template <Index I, typename Cmp>
+  void sort(Index offset, Size count, Cmp &&cmp)
+  {
+    static_assert(std::is_invocable_v<Cmp, Field<I> const &, Field<I> const &>);
+    static_assert(std::is_convertible_v<std::invoke_result_t<Cmp, Field<I> const &, Field<I> const &>, bool>);
+
+    STX_SPAN_ENSURE(offset <= size() && count <= size() - offset,
+                    "sort operation out of SoaVec range");
+
+    Span<Field<I> const> column      = span<I>();
+    Span<Size>           permutation = get_permutation();
+
+    for (Index i = 0; i < permutation.size(); i++)
+    {
+      permutation.data()[i] = i;
+    }
+
+    std::sort(permutation.begin() + offset, permutation.begin() + offset + count,
+              [&column, &cmp](Index a, Index b) { return cmp(column.data()[a], column.data()[b]); });
+
+    permute(permutation);
+  }
+
+  template <Index I, typename Cmp>
+  void sort(Cmp &&cmp)
+  {
+    sort<I>(0, size(), std::forward<Cmp>(cmp));
+  }
+
+  std::tuple<Vec<Fields>...> columns_;
+  // scratch memory for partitioning and sorting. always has the same capacity
+  // as the columns.
+  Vec<Size> permutation_;
+  Size      capacity_ = 0;
+
+private:
+  template <Index... I>
+  bool reserve_columns(Size cap, std::index_sequence<I...>)
+  {
+    return (std::get<I>(columns_).reserve(cap).is_ok() && ...);
+  }
+
+  template <Index... I>
+  void push_columns(std::index_sequence<I...>, Fields &&...fields)
+  {
+    (std::get<I>(columns_).push(std::move(fields)).unwrap(), ...);
+  }
+
+  template <Index... I>
+  void erase_columns(Index offset, Size count, std::index_sequence<I...>)
+  {
+    (std::get<I>(columns_).erase(std::get<I>(columns_).span().slice(offset, count)), ...);
+  }
+
+  template <Index... I>
+  void swap_columns(Index a, Index b, std::index_sequence<I...>)
+  {
+    using std::swap;
+    (swap(std::get<I>(columns_).data()[a], std::get<I>(columns_).data()[b]), ...);
+  }
+
+  // scratch memory is already reserved, this never allocates
+  Span<Size> get_permutation()
+  {
+    permutation_.unsafe_resize_uninitialized(size()).unwrap();
+    return permutation_.span();
+  }
+
+  // moves the record at index `permutation[i]` to index `i`, for all `i`.
+  // follows each cycle of the permutation so each record is only moved once
+  // (through a swap).
+  //
+  // the permutation is reset to identity afterwards.
+  void permute(Span<Size> permutation)
+  {
+    Size *indices = permutation.data();
+
+    for (Index start = 0; start < permutation.size(); start++)
+    {
+      Index current = start;
+
+      while (indices[current] != start)
+      {
+        Index next = indices[current];
+        swap(current, next);
+        indices[current] = current;
+        current          = next;
+      }
+
+      indices[current] = current;
+    }
+  }
+};
+
+STX_END_NAMESPACE
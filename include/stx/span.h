@@ -14,6 +14,7 @@
 #include <array>
 #include <cinttypes>
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <type_traits>
@@ -101,8 +102,20 @@ struct is_compatible_container_impl<
 template <typename T, typename Element>
 constexpr bool is_compatible_container = is_compatible_container_impl<T, Element>::value;
 
+template <typename T>
+struct SpanSource;
+
+template <typename T>
+struct ChunksSource;
+
+template <typename T>
+struct WindowsSource;
+
 }        // namespace impl
 
+template <typename Source>
+struct Iter;
+
 ///
 /// # Span
 ///
@@ -515,6 +528,123 @@ public:
     return std::make_pair(Span<T>{iterator_, first_partition_end}, Span<T>{first_partition_end, second_partition_end - first_partition_end});
   }
 
+  /// index of the first element that is not ordered before `object`, or
+  /// `size()` if there is none. the span must be sorted by `cmp`.
+  ///
+  /// the search is branchless: the loop always runs `log2(size)` iterations
+  /// and the halving step compiles to a conditional move, so mispredictions
+  /// don't stall the pipeline on large spans.
+  template <typename Cmp>
+  constexpr Index lower_bound(T const &object, Cmp &&cmp) const
+  {
+    static_assert(std::is_invocable_v<Cmp, T const &, T const &>);
+    static_assert(std::is_convertible_v<std::invoke_result_t<Cmp, T const &, T const &>, bool>);
+
+    if (size_ == 0)
+    {
+      return 0;
+    }
+
+    Iterator base   = iterator_;
+    Size     length = size_;
+
+    while (length > 1)
+    {
+      Size const half = length / 2;
+      base            = cmp(base[half - 1], object) ? base + half : base;
+      length -= half;
+    }
+
+    return static_cast<Index>(base - iterator_) + static_cast<Index>(cmp(*base, object));
+  }
+
+  constexpr Index lower_bound(T const &object) const
+  {
+    return lower_bound(object, std::less<>{});
+  }
+
+  /// index of the first element that is ordered after `object`, or `size()`
+  /// if there is none. the span must be sorted by `cmp`.
+  template <typename Cmp>
+  constexpr Index upper_bound(T const &object, Cmp &&cmp) const
+  {
+    return lower_bound(object, [&cmp](T const &a, T const &b) { return !cmp(b, a); });
+  }
+
+  constexpr Index upper_bound(T const &object) const
+  {
+    return upper_bound(object, std::less<>{});
+  }
+
+  /// span of the elements equivalent to `object`. the span must be sorted by
+  /// `cmp`.
+  template <typename Cmp>
+  constexpr Span<T> equal_range(T const &object, Cmp &&cmp) const
+  {
+    Index const first = lower_bound(object, cmp);
+    Index const last  = first + slice(first).upper_bound(object, cmp);
+
+    return Span<T>{iterator_ + first, last - first};
+  }
+
+  constexpr Span<T> equal_range(T const &object) const
+  {
+    return equal_range(object, std::less<>{});
+  }
+
+  /// span of 1 element if found, otherwise span of zero elements. the span must
+  /// be sorted by `cmp`.
+  template <typename Cmp>
+  constexpr Span<T> binary_search(T const &object, Cmp &&cmp) const
+  {
+    Index const index = lower_bound(object, cmp);
+
+    if (index < size_ && !cmp(object, iterator_[index]))
+    {
+      return Span<T>{iterator_ + index, 1};
+    }
+
+    return Span<T>{iterator_ + size_, 0};
+  }
+
+  constexpr Span<T> binary_search(T const &object) const
+  {
+    return binary_search(object, std::less<>{});
+  }
+
+  /// merges this span and `other`, both sorted by `cmp`, into `output`. the
+  /// merge is stable.
+  template <typename Cmp, typename Output>
+  constexpr Span<Output> merge(Span<T const> other, Span<Output> output, Cmp &&cmp) const
+  {
+    static_assert(!std::is_const_v<Output>);
+    static_assert(std::is_assignable_v<Output &, T const &>);
+
+    STX_SPAN_ENSURE(size() + other.size() == output.size(), "source and destination span size mismatch");
+
+    std::merge(begin(), end(), other.begin(), other.end(), output.begin(), std::forward<Cmp>(cmp));
+
+    return output;
+  }
+
+  template <typename Output>
+  constexpr Span<Output> merge(Span<T const> other, Span<Output> output) const
+  {
+    return merge(other, output, std::less<>{});
+  }
+
+  /// lazy iterator adapters over the elements. requires "stx/iter.h".
+  constexpr Iter<impl::SpanSource<T>> iter() const;
+
+  /// lazy iterator over consecutive non-overlapping sub-spans of
+  /// `chunk_size` elements. the last chunk may be shorter. requires
+  /// "stx/iter.h".
+  constexpr Iter<impl::ChunksSource<T>> chunks(Size chunk_size) const;
+
+  /// lazy iterator over all the overlapping sub-spans of `window_size`
+  /// elements. requires "stx/iter.h".
+  constexpr Iter<impl::WindowsSource<T>> windows(Size window_size) const;
+
   // TODO(lamarrr): also check for rust lang's name for these
   // is_partitioned
   // accumulate, reduce
@@ -5,6 +5,7 @@
 
 #include "stx/allocator.h"
 #include "stx/async.h"
+#include "stx/intrusive_list.h"
 #include "stx/manager.h"
 #include "stx/memory.h"
 #include "stx/option.h"
@@ -94,9 +95,8 @@ struct [[nodiscard]] StreamChunk
 
   Manager manager;
 
-  // points to the next added element in the stream it belongs to (if any).
-  // must always be nullptr until added into the stream.
-  StreamChunk<T> *next{nullptr};
+  // links to the next added element in the stream it belongs to (if any).
+  SListHook<StreamChunk<T>> hook;
 
   T data;
 };
@@ -217,10 +217,9 @@ struct [[nodiscard]] StreamState
 
   StreamState() = default;
 
-  SpinLock        lock;
-  bool            closed     = false;
-  StreamChunk<T> *pop_it     = nullptr;
-  StreamChunk<T> *yield_last = nullptr;
+  SpinLock                                              lock;
+  bool                                                  closed = false;
+  IntrusiveSList<StreamChunk<T>, &StreamChunk<T>::hook> chunks;
 
   // yield is O(1)
   // contention is O(1) and not proportional to the contained object nor
@@ -247,26 +246,7 @@ struct [[nodiscard]] StreamState
         break;
       }
 
-      // yield_last == nullptr ?: we haven't yielded anything yet
-      // pop_it == nullptr?: popping has caught up to yielding and released
-      // all the previous handles. so, no handle is valid now.
-      //
-      if (yield_last == nullptr || pop_it == nullptr)
-      {
-        yield_last = chunk_handle;
-      }
-      else
-      {
-        yield_last->next = chunk_handle;
-        yield_last       = chunk_handle;
-      }
-
-      // popping has previously caught up with yielding, we need to update
-      // the popping iterator (to notify that new data has been added)
-      if (pop_it == nullptr)
-      {
-        pop_it = yield_last;
-      }
+      chunks.push_back(*chunk_handle);
 
       closed    = should_close;
       was_added = true;
@@ -304,12 +284,12 @@ struct [[nodiscard]] StreamState
     StreamChunk<T> *chunk = nullptr;
 
     STX_WITH_LOCK(lock, {
-      if (pop_it == nullptr)
-        break;
+      Option<Ref<StreamChunk<T>>> front = chunks.pop_front();
 
-      chunk = pop_it;
-
-      pop_it = pop_it->next;
+      if (front.is_some())
+      {
+        chunk = &front.value().get();
+      }
     });
 
     if (chunk == nullptr)
@@ -335,27 +315,16 @@ struct [[nodiscard]] StreamState
   }
 
 private:
-  // we unref the entries in a bottom-up order (inwards-outwards).
-  // NOTE: we don't begin unref-ing the entries until we reach the end of
-  // the chunks. since the the top-most element refers to the next one,
-  // otherwise we'd risk a use-after-unref (use-after-free).
-  //
-  void unref_pass(StreamChunk<T> *chunk_handle) const
+  // each chunk is unlinked before it is released, so the link to the next
+  // chunk is never read from a released chunk.
+  void unref_items()
   {
-    if (chunk_handle != nullptr)
+    for (Option<Ref<StreamChunk<T>>> chunk = chunks.pop_front(); chunk.is_some(); chunk = chunks.pop_front())
     {
-      unref_pass(chunk_handle->next);
-
-      // release the chunk
-      chunk_handle->manager.unref();
+      chunk.value().get().manager.unref();
     }
   }
 
-  void unref_items() const
-  {
-    unref_pass(pop_it);
-  }
-
 public:
   // guaranteed to not happen along or before the operations possible on the
   // streams.
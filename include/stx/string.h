@@ -1,40 +1,134 @@
 
 #pragma once
 
-#include <cctype>
 #include <cstddef>
 #include <cstring>
+#include <new>
 #include <string_view>
 #include <utility>
 
 #include "stx/allocator.h"
+#include "stx/ascii.h"
+#include "stx/bit.h"
 #include "stx/c_string_view.h"
 #include "stx/config.h"
+#include "stx/fmt.h"
+#include "stx/hash.h"
 #include "stx/memory.h"
 #include "stx/option.h"
 #include "stx/rc.h"
+#include "stx/relocate.h"
 #include "stx/span.h"
+#include "stx/try_ok.h"
+
+#if STX_CFG(SIMD, SSE2)
+#  include <emmintrin.h>
+#endif
 
 STX_BEGIN_NAMESPACE
 
 constexpr char const EMPTY_STRING[] = "";
 
+namespace impl
+{
+
+// substring search with a first/last byte filter: the positions where both
+// the first and the last byte of the needle match are found 16 at a time and
+// only those are compared in full. the scalar fallback finds the candidates
+// with `memchr`.
+inline Option<size_t> find_substring(std::string_view haystack, std::string_view needle)
+{
+  size_t const size        = haystack.size();
+  size_t const needle_size = needle.size();
+
+  if (needle_size == 0)
+  {
+    return Some(size_t{0});
+  }
+
+  if (needle_size > size)
+  {
+    return None;
+  }
+
+  char const *const str        = haystack.data();
+  char const        first      = needle[0];
+  char const        last       = needle[needle_size - 1];
+  size_t const      num_starts = size - needle_size + 1;
+  size_t            i          = 0;
+
+  auto const matches_at = [&](size_t pos) {
+    return needle_size <= 2 || std::memcmp(str + pos + 1, needle.data() + 1, needle_size - 2) == 0;
+  };
+
+#if STX_CFG(SIMD, SSE2)
+  __m128i const first_chars = _mm_set1_epi8(first);
+  __m128i const last_chars  = _mm_set1_epi8(last);
+
+  for (; i + 16 <= num_starts; i += 16)
+  {
+    __m128i const block_first = _mm_loadu_si128(reinterpret_cast<__m128i const *>(str + i));
+    __m128i const block_last  = _mm_loadu_si128(reinterpret_cast<__m128i const *>(str + i + needle_size - 1));
+
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first_chars), _mm_cmpeq_epi8(block_last, last_chars))));
+
+    for (; mask != 0; mask &= mask - 1)
+    {
+      size_t const pos = i + count_trailing_zeros(mask);
+
+      if (matches_at(pos))
+      {
+        return Some(size_t{pos});
+      }
+    }
+  }
+#endif
+
+  while (i < num_starts)
+  {
+    void const *candidate = std::memchr(str + i, first, num_starts - i);
+
+    if (candidate == nullptr)
+    {
+      return None;
+    }
+
+    size_t const pos = static_cast<size_t>(static_cast<char const *>(candidate) - str);
+
+    if (str[pos + needle_size - 1] == last && matches_at(pos))
+    {
+      return Some(size_t{pos});
+    }
+
+    i = pos + 1;
+  }
+
+  return None;
+}
+
+}        // namespace impl
+
 //
 // An owning read-only byte string.
 //
 // PROPERTIES:
-// - No small string optimization (SSO)
+// - small string optimization (SSO): strings of up to `INLINE_CAPACITY` bytes
+// are stored inline and never allocate
 // - always read-only
 // - always null-terminated (for compatibility with C APIs, to prevent extra
 // allocations for null-termination)
 // - doesn't support copying from copy constructors
 // - it's just a plain dumb sequence of characters/bytes
 //
-// with these attributes, we can avoid heap allocation of static strings.
+// with these attributes, we can avoid heap allocation of static and short
+// strings.
 // we can be move the strings across threads.
 // the string can be accessed from multiple threads with no data race.
 // the string is always valid as long as lifetime of `Str` is valid.
 //
+// the string is inline if and only if its size is at most `INLINE_CAPACITY`,
+// longer strings are stored in `memory_`. the inline bytes don't refer to the
+// string's address so it remains trivially relocatable.
 //
 struct String
 {
@@ -43,37 +137,87 @@ struct String
   using Size     = size_t;
   using Index    = size_t;
 
+  // maximum number of bytes stored inline, excluding the null-terminator
+  static constexpr Size INLINE_CAPACITY = 23;
+
   String() :
-      memory_{static_storage_allocator, EMPTY_STRING}, size_{0}
-  {}
+      size_{0}
+  {
+    inline_[0] = '\0';
+  }
 
   String(char const *static_storage_string_literal) :
-      memory_{static_storage_allocator, static_storage_string_literal}, size_{CStringView::length(static_storage_string_literal)}
+      String{ReadOnlyMemory{static_storage_allocator, static_storage_string_literal}, CStringView::length(static_storage_string_literal)}
   {}
 
+  // `memory` must contain `size` bytes followed by a null-terminator. short
+  // strings are copied inline and their memory is released.
   String(ReadOnlyMemory memory, Size size) :
-      memory_{std::move(memory)}, size_{size}
-  {}
+      size_{size}
+  {
+    if (is_inline())
+    {
+      // an empty string's memory can be null
+      if (size != 0)
+      {
+        std::memcpy(inline_, memory.handle, size);
+      }
+
+      inline_[size] = '\0';
+    }
+    else
+    {
+      new (&memory_) ReadOnlyMemory{std::move(memory)};
+    }
+  }
 
   String(String const &)            = delete;
   String &operator=(String const &) = delete;
 
+  STX_MARK_TRIVIALLY_RELOCATABLE(String)
+
   String(String &&other) :
-      memory_{std::move(other.memory_)}, size_{other.size_}
+      size_{other.size_}
   {
-    other.memory_.allocator = static_storage_allocator;
-    other.memory_.handle    = EMPTY_STRING;
-    other.size_             = 0;
+    if (other.is_inline())
+    {
+      std::memcpy(inline_, other.inline_, size_ + 1);
+    }
+    else
+    {
+      new (&memory_) ReadOnlyMemory{std::move(other.memory_)};
+      other.memory_.~ReadOnlyMemory();
+    }
+
+    other.inline_[0] = '\0';
+    other.size_      = 0;
   }
 
   String &operator=(String &&other)
   {
-    std::swap(memory_, other.memory_);
-    std::swap(size_, other.size_);
+    if (this != &other)
+    {
+      String tmp{std::move(other)};
+      this->~String();
+      new (this) String{std::move(tmp)};
+    }
 
     return *this;
   }
 
+  ~String()
+  {
+    if (!is_inline())
+    {
+      memory_.~ReadOnlyMemory();
+    }
+  }
+
+  bool is_inline() const
+  {
+    return size_ <= INLINE_CAPACITY;
+  }
+
   char const *c_str() const
   {
     return data();
@@ -81,7 +225,7 @@ struct String
 
   Pointer data() const
   {
-    return static_cast<char const *>(memory_.handle);
+    return is_inline() ? inline_ : static_cast<char const *>(memory_.handle);
   }
 
   Size size() const
@@ -164,6 +308,23 @@ struct String
     return size_ > 0 && data()[size_ - 1] == c;
   }
 
+  // index of the first occurrence of `other`, if any
+  Option<Index> find(std::string_view other) const
+  {
+    return impl::find_substring(view(), other);
+  }
+
+  bool contains(std::string_view other) const
+  {
+    return find(other).is_some();
+  }
+
+  // ASCII case-insensitive equality
+  bool equal_ignore_case(std::string_view other) const
+  {
+    return ascii::equal_ignore_case(view(), other);
+  }
+
   std::string_view view() const
   {
     return std::string_view{data(), size_};
@@ -219,17 +380,26 @@ struct String
     return CStringView{data(), size()};
   }
 
-  Result<String, AllocError> copy(Allocator allocator) const
+  // inline strings are copied without allocating
+  Result<String, AllocError> copy(Allocator allocator) const;
+
+  union
   {
-    TRY_OK(memory, mem::allocate(allocator, size_ + 1));
+    ReadOnlyMemory memory_;
+    char           inline_[INLINE_CAPACITY + 1];
+  };
 
-    std::memcpy(memory.handle, memory_.handle, size_ + 1);
+  Size size_ = 0;
+};
 
-    return Ok(String{ReadOnlyMemory{std::move(memory)}, size_});
+// hashes the contents, equal to the hash of the equivalent `std::string_view`
+template <>
+struct Hash<String, void>
+{
+  HashValue operator()(String const &value) const
+  {
+    return hash::string(value.view());
   }
-
-  ReadOnlyMemory memory_;
-  Size           size_ = 0;
 };
 
 inline namespace literals
@@ -245,15 +415,41 @@ inline String operator""_str(char const *string_literal, size_t str_size)
 namespace string
 {
 
-inline Result<String, AllocError> make(Allocator allocator, std::string_view str)
+// makes a string of `size` bytes which are written by `writer(char *out)`.
+// the string is stored inline if it fits, otherwise it is allocated.
+//
+// returns the error if memory allocation fails
+template <typename Writer>
+Result<String, AllocError> make_with(Allocator allocator, size_t size, Writer &&writer)
 {
-  TRY_OK(memory, mem::allocate(allocator, str.size() + 1));
+  static_assert(std::is_invocable_v<Writer &, char *>);
 
-  std::memcpy(memory.handle, str.data(), str.size());
+  if (size <= String::INLINE_CAPACITY)
+  {
+    String str;
 
-  static_cast<char *>(memory.handle)[str.size()] = '\0';
+    writer(str.inline_);
 
-  return Ok(String{ReadOnlyMemory{std::move(memory)}, str.size()});
+    str.inline_[size] = '\0';
+    str.size_         = size;
+
+    return Ok(std::move(str));
+  }
+
+  TRY_OK(memory, mem::allocate(allocator, size + 1));
+
+  char *out = static_cast<char *>(memory.handle);
+
+  writer(out);
+
+  out[size] = '\0';
+
+  return Ok(String{ReadOnlyMemory{std::move(memory)}, size});
+}
+
+inline Result<String, AllocError> make(Allocator allocator, std::string_view str)
+{
+  return make_with(allocator, str.size(), [str](char *out) { std::memcpy(out, str.data(), str.size()); });
 }
 
 inline String make_static(std::string_view str)
@@ -273,66 +469,40 @@ inline Rc<std::string_view> make_static_view(std::string_view str)
 
 }        // namespace rc
 
+// formats the arguments with `fmt` into a new string, see "stx/fmt/core.h"
+// for the formats of the argument types.
+//
+// ```cpp
+// String message = string::format(allocator, "task ", task_id, " took ", ms, "ms").unwrap();
+// ```
+//
+template <typename... Args>
+Result<String, AllocError> format(Allocator allocator, Args const &...args)
+{
+  size_t const size = fmt::formatted_size(args...);
+
+  return make_with(allocator, size, [size, &args...](char *out) { fmt::format_to_n(out, size, args...); });
+}
+
+// joins the formatted arguments with `glue`
 template <typename Glue, typename A, typename B, typename... S>
 Result<String, AllocError> join(Allocator allocator, Glue const &glue,
                                 A const &a, B const &b, S const &...s)
 {
   static_assert(std::is_convertible_v<Glue const &, std::string_view>);
-  static_assert(std::is_convertible_v<A const &, std::string_view>);
-  static_assert(std::is_convertible_v<B const &, std::string_view> && (std::is_convertible_v<S const &, std::string_view> && ...));
-
-  std::string_view views[] = {std::string_view{a}, std::string_view{b}, std::string_view{s}...};
-  size_t           nviews  = std::size(views);
 
   std::string_view glue_v{glue};
 
-  size_t str_size = 0;
-
-  {
-    size_t index = 0;
-
-    for (std::string_view v : views)
-    {
-      str_size += v.size();
-
-      if (index != nviews - 1)
-      {
-        str_size += glue_v.size();
-      }
-
-      index++;
-    }
-  }
-
-  // with null terminator
-  size_t memory_size = str_size + 1;
-
-  TRY_OK(memory, mem::allocate(allocator, memory_size));
-
-  char *str = static_cast<char *>(memory.handle);
-
-  {
-    size_t index      = 0;
-    size_t view_index = 0;
-
-    for (std::string_view v : views)
-    {
-      std::memcpy(str + index, v.data(), v.size());
-      index += v.size();
-
-      if (view_index != nviews - 1)
-      {
-        std::memcpy(str + index, glue_v.data(), glue_v.size());
-        index += glue_v.size();
-      }
-
-      view_index++;
-    }
-  }
+  size_t const size = fmt::formatted_size(a, b, s...) + (1 + sizeof...(S)) * glue_v.size();
 
-  str[str_size] = '\0';
+  return make_with(allocator, size, [&, glue_v, size](char *out) {
+    fmt::impl::Sink sink{out, size, 0};
 
-  return Ok(String{ReadOnlyMemory{std::move(memory)}, str_size});
+    sink.put(a);
+    sink.put(glue_v);
+    sink.put(b);
+    ((sink.put(glue_v), sink.put(s)), ...);
+  });
 }
 
 template <typename Glue, typename T>
@@ -360,13 +530,7 @@ Result<String, AllocError> join(Allocator allocator, Glue const &glue,
     }
   }
 
-  size_t memory_size = size + 1;
-
-  TRY_OK(memory, mem::allocate(allocator, memory_size));
-
-  char *out = static_cast<char *>(memory.handle);
-
-  {
+  return make_with(allocator, size, [strings, nstrings, glue_v](char *out) {
     size_t index     = 0;
     size_t str_index = 0;
 
@@ -384,50 +548,71 @@ Result<String, AllocError> join(Allocator allocator, Glue const &glue,
 
       str_index++;
     }
-  }
-
-  out[size] = '\0';
-
-  return Ok(String{ReadOnlyMemory{std::move(memory)}, size});
+  });
 }
 
+// ASCII uppercase of `str`, see `ascii::to_upper`
 inline Result<String, AllocError> upper(Allocator allocator, std::string_view str)
 {
-  TRY_OK(memory, mem::allocate(allocator, str.size() + 1));
-
-  char *out = static_cast<char *>(memory.handle);
-
-  for (size_t i = 0; i < str.size(); i++)
-  {
-    out[i] = std::toupper(str[i]);
-  }
+  return make_with(allocator, str.size(), [str](char *out) { ascii::to_upper(Span<char const>{str.data(), str.size()}, Span<char>{out, str.size()}); });
+}
 
-  out[str.size()] = '\0';
+// ASCII lowercase of `str`, see `ascii::to_lower`
+inline Result<String, AllocError> lower(Allocator allocator, std::string_view str)
+{
+  return make_with(allocator, str.size(), [str](char *out) { ascii::to_lower(Span<char const>{str.data(), str.size()}, Span<char>{out, str.size()}); });
+}
 
-  return Ok(String{ReadOnlyMemory{std::move(memory)}, str.size()});
+// index of the first occurrence of `needle` in `str`, if any
+inline Option<size_t> find(std::string_view str, std::string_view needle)
+{
+  return impl::find_substring(str, needle);
 }
 
-inline Result<String, AllocError> lower(Allocator allocator, std::string_view str)
+inline bool contains(std::string_view str, std::string_view needle)
 {
-  size_t size = str.size();
+  return impl::find_substring(str, needle).is_some();
+}
 
-  TRY_OK(memory, mem::allocate(allocator, size + 1));
+// ASCII case-insensitive equality
+inline bool equal_ignore_case(std::string_view a, std::string_view b)
+{
+  return ascii::equal_ignore_case(a, b);
+}
 
-  char *out = static_cast<char *>(memory.handle);
+// calls `func(std::string_view)` with each of the pieces of `str` separated
+// by `delimiter`, in order. an empty `delimiter` yields `str` whole.
+template <typename Func>
+void split(std::string_view str, std::string_view delimiter, Func &&func)
+{
+  static_assert(std::is_invocable_v<Func &, std::string_view>);
 
-  for (size_t i = 0; i < size; i++)
+  if (delimiter.empty())
   {
-    out[i] = std::tolower(str[i]);
+    func(str);
+    return;
   }
 
-  out[size] = '\0';
+  while (true)
+  {
+    Option<size_t> pos = impl::find_substring(str, delimiter);
 
-  return Ok(String{ReadOnlyMemory{std::move(memory)}, size});
+    if (pos.is_none())
+    {
+      func(str);
+      return;
+    }
+
+    func(str.substr(0, pos.value()));
+    str.remove_prefix(pos.value() + delimiter.size());
+  }
 }
 
-// TODO(lamarrr):
-// void split(allocator, string, delimeter, callback);
-//
 }        // namespace string
 
+inline Result<String, AllocError> String::copy(Allocator allocator) const
+{
+  return string::make(allocator, view());
+}
+
 STX_END_NAMESPACE
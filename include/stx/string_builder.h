@@ -0,0 +1,221 @@
+#pragma once
+
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/config.h"
+#include "stx/fmt.h"
+#include "stx/memory.h"
+#include "stx/option.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/string.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+// StringBuilder builds a `String` incrementally in a geometrically growing
+// buffer, so appending is amortized O(1) per byte.
+//
+// ```cpp
+// StringBuilder builder{allocator};
+//
+// builder.append("task ").append_int(task_id).append(" took ").append_float(ms).append("ms");
+// builder.append_fmt(" at ", fmt::hex(address));
+//
+// Result<String, AllocError> line = builder.build();
+// ```
+//
+// the appends return the builder for chaining. the first allocation error is
+// latched, the subsequent appends are ignored and `build` returns the error.
+//
+// `build` hands the buffer over to the long strings without copying (at most
+// one reallocation to add the null-terminator) and copies short strings into
+// the `String`'s inline storage, keeping the buffer for reuse.
+//
+struct StringBuilder
+{
+  using Size = size_t;
+
+  explicit StringBuilder(Allocator allocator) :
+      buffer_{allocator}, error_{None}
+  {}
+
+  STX_DEFAULT_MOVE(StringBuilder)
+  STX_DISABLE_COPY(StringBuilder)
+  STX_DEFAULT_DESTRUCTOR(StringBuilder)
+  STX_MARK_TRIVIALLY_RELOCATABLE(StringBuilder)
+
+  Size size() const
+  {
+    return buffer_.size();
+  }
+
+  bool is_empty() const
+  {
+    return buffer_.is_empty();
+  }
+
+  // the contents appended so far, not null-terminated
+  std::string_view view() const
+  {
+    return std::string_view{buffer_.data(), buffer_.size()};
+  }
+
+  bool has_error() const
+  {
+    return error_.is_some();
+  }
+
+  Result<Void, AllocError> reserve(Size capacity)
+  {
+    return buffer_.reserve(capacity);
+  }
+
+  StringBuilder &append(std::string_view str)
+  {
+    Option<Span<char>> out = extend_uninitialized(str.size());
+
+    if (out.is_some() && !str.empty())
+    {
+      std::memcpy(out.value().data(), str.data(), str.size());
+    }
+
+    return *this;
+  }
+
+  StringBuilder &append(char c)
+  {
+    return append(std::string_view{&c, 1});
+  }
+
+  // appends the decimal representation of `value`
+  template <typename T>
+  StringBuilder &append_int(T value)
+  {
+    static_assert(std::is_integral_v<T>);
+
+    char                 digits[std::numeric_limits<T>::digits10 + 3];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+
+    return append(std::string_view{digits, static_cast<size_t>(result.ptr - digits)});
+  }
+
+  // appends the shortest decimal representation of `value` that parses back
+  // to the same value
+  template <typename T>
+  StringBuilder &append_float(T value)
+  {
+    static_assert(std::is_floating_point_v<T>);
+
+    // enough for the longest scientific form: sign, significant digits, point
+    // and exponent
+    char                 digits[std::numeric_limits<T>::max_digits10 + 16];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+
+    return append(std::string_view{digits, static_cast<size_t>(result.ptr - digits)});
+  }
+
+  // appends the formatted arguments, see "stx/fmt/core.h" for the formats of
+  // the argument types
+  template <typename... Args>
+  StringBuilder &append_fmt(Args const &...args)
+  {
+    Size const size = fmt::formatted_size(args...);
+
+    Option<Span<char>> out = extend_uninitialized(size);
+
+    if (out.is_some())
+    {
+      fmt::format_to_n(out.value().data(), size, args...);
+    }
+
+    return *this;
+  }
+
+  // builds the string and resets the builder
+  //
+  // returns the first allocation error that occurred while appending or
+  // building, if any
+  Result<String, AllocError> build()
+  {
+    if (error_.is_some())
+    {
+      AllocError error = error_.value();
+      clear();
+      return Err(std::move(error));
+    }
+
+    Size const size = buffer_.size();
+
+    if (size <= String::INLINE_CAPACITY)
+    {
+      std::string_view const contents = view();
+
+      String str = string::make_with(noop_allocator, size, [contents](char *out) {
+        if (!contents.empty())
+        {
+          std::memcpy(out, contents.data(), contents.size());
+        }
+      }).unwrap();
+
+      buffer_.clear();
+
+      return Ok(std::move(str));
+    }
+
+    TRY_OK(ok, buffer_.push('\0'));
+
+    (void) ok;
+
+    Allocator allocator = buffer_.memory_.allocator;
+    Memory    memory{std::move(buffer_.memory_)};
+
+    buffer_.memory_   = Memory{allocator, nullptr};
+    buffer_.size_     = 0;
+    buffer_.capacity_ = 0;
+
+    return Ok(String{ReadOnlyMemory{std::move(memory)}, size});
+  }
+
+  // discards the contents and the latched error. capacity is unchanged.
+  void clear()
+  {
+    buffer_.clear();
+    error_ = None;
+  }
+
+  Vec<char>          buffer_;
+  Option<AllocError> error_;
+
+private:
+  // grows the buffer by `size` uninitialized bytes, None if an error is or
+  // gets latched
+  Option<Span<char>> extend_uninitialized(Size size)
+  {
+    if (error_.is_some())
+    {
+      return None;
+    }
+
+    Result<Span<char>, AllocError> result = buffer_.unsafe_resize_uninitialized(buffer_.size() + size);
+
+    if (result.is_err())
+    {
+      error_ = Some(std::move(result).unwrap_err());
+      return None;
+    }
+
+    return Some(std::move(result).unwrap());
+  }
+};
+
+STX_END_NAMESPACE
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/config.h"
+#include "stx/hash.h"
+#include "stx/hash_map.h"
+#include "stx/manager.h"
+#include "stx/memory.h"
+#include "stx/option.h"
+#include "stx/rc.h"
+#include "stx/result.h"
+#include "stx/spinlock.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+// a 32-bit id of a string interned in a `StringInterner`. two symbols from the
+// same interner are equal iff their contents are equal.
+enum class Symbol : uint32_t
+{
+};
+
+namespace impl
+{
+
+constexpr size_t STRING_INTERNER_SHARDS     = 16;
+constexpr size_t STRING_INTERNER_SHARD_BITS = 4;
+constexpr size_t STRING_INTERNER_CHUNK_SIZE = 4096;
+
+static_assert((size_t{1} << STRING_INTERNER_SHARD_BITS) == STRING_INTERNER_SHARDS);
+
+// the strings are copied into chunks of `STRING_INTERNER_CHUNK_SIZE` bytes
+// that are only released with the interner. strings larger than a quarter of a
+// chunk get a chunk of their own so they don't waste the current one.
+//
+// the shards are not cache-line aligned since the allocators don't support
+// over-aligned allocations, but each spans more than a cache line.
+struct StringInternerShard
+{
+  SpinLock                            lock;
+  HashMap<std::string_view, uint32_t> index;
+  Vec<std::string_view>               symbols;
+  Vec<Memory>                         chunks;
+  char                               *cursor    = nullptr;
+  size_t                              remaining = 0;
+
+  Result<char const *, AllocError> store(Allocator allocator, std::string_view str)
+  {
+    if (str.size() > remaining)
+    {
+      bool const   dedicated  = str.size() > STRING_INTERNER_CHUNK_SIZE / 4;
+      size_t const chunk_size = dedicated ? str.size() : STRING_INTERNER_CHUNK_SIZE;
+
+      TRY_OK(chunks_ok, chunks.reserve(chunks.size() + 1));
+      TRY_OK(memory, mem::allocate(allocator, chunk_size));
+
+      (void) chunks_ok;
+
+      char *chunk = static_cast<char *>(memory.handle);
+
+      chunks.push(std::move(memory)).unwrap();
+
+      if (dedicated)
+      {
+        std::memcpy(chunk, str.data(), str.size());
+        return Ok(static_cast<char const *>(chunk));
+      }
+
+      cursor    = chunk;
+      remaining = chunk_size;
+    }
+
+    char *out = cursor;
+
+    if (!str.empty())
+    {
+      std::memcpy(out, str.data(), str.size());
+    }
+
+    cursor += str.size();
+    remaining -= str.size();
+
+    return Ok(static_cast<char const *>(out));
+  }
+
+  // the local id of `str`, interning it if it isn't already
+  Result<uint32_t, AllocError> intern(Allocator allocator, std::string_view str)
+  {
+    Option<Ref<uint32_t>> id = index.get(str);
+
+    if (id.is_some())
+    {
+      return Ok(uint32_t{id.value().get()});
+    }
+
+    // the symbol ids are exhausted
+    if (symbols.size() >= (size_t{UINT32_MAX} >> STRING_INTERNER_SHARD_BITS))
+    {
+      return Err(AllocError::NoMemory);
+    }
+
+    uint32_t const new_id = static_cast<uint32_t>(symbols.size());
+
+    TRY_OK(symbols_ok, symbols.reserve(symbols.size() + 1));
+    TRY_OK(data, store(allocator, str));
+
+    (void) symbols_ok;
+
+    std::string_view const stored{data, str.size()};
+
+    // on failure the stored copy is just left unused in the chunk
+    TRY_OK(index_ok, index.insert(std::string_view{stored}, uint32_t{new_id}));
+
+    (void) index_ok;
+
+    symbols.push(std::string_view{stored}).unwrap();
+
+    return Ok(uint32_t{new_id});
+  }
+};
+
+struct StringInternerState
+{
+  explicit StringInternerState(Allocator iallocator) :
+      allocator{iallocator}
+  {
+    for (StringInternerShard &shard : shards)
+    {
+      shard.index   = HashMap<std::string_view, uint32_t>{allocator};
+      shard.symbols = Vec<std::string_view>{allocator};
+      shard.chunks  = Vec<Memory>{allocator};
+    }
+  }
+
+  Allocator           allocator;
+  StringInternerShard shards[STRING_INTERNER_SHARDS];
+};
+
+}        // namespace impl
+
+// StringInterner deduplicates strings: interning the same contents always
+// yields the same copy, stored once in the interner's arena.
+//
+// ```cpp
+// StringInterner interner = string::make_interner(os_allocator).unwrap();
+//
+// TaskTraceInfo trace_info{interner.intern("image decoder").unwrap(), interner.intern("thumbnail").unwrap()};
+// ```
+//
+// `intern` returns an `Rc<std::string_view>` that keeps the arena alive, so the
+// views remain valid after the interner is destroyed. `intern_symbol` returns
+// a 32-bit `Symbol` instead, which is resolved back with `resolve`. since the
+// contents are stored once, two views interned by the same interner are equal
+// iff their `data()` pointers are equal.
+//
+// the strings are partitioned by their hashes into shards with their own
+// locks, so threads interning different strings rarely contend. the interned
+// strings are only released with the arena.
+//
+struct StringInterner
+{
+  using Size = size_t;
+
+  STX_DEFAULT_MOVE(StringInterner)
+  STX_DISABLE_COPY(StringInterner)
+  STX_DEFAULT_DESTRUCTOR(StringInterner)
+  STX_MARK_TRIVIALLY_RELOCATABLE(StringInterner)
+
+  explicit StringInterner(Rc<impl::StringInternerState *> &&state) :
+      state_{std::move(state)}
+  {}
+
+  // the interned copy of `str`
+  Result<Rc<std::string_view>, AllocError> intern(std::string_view str)
+  {
+    TRY_OK(symbol, intern_symbol(str));
+
+    Manager manager{state_.manager};
+    manager.ref();
+
+    return Ok(Rc<std::string_view>{resolve(symbol), std::move(manager)});
+  }
+
+  Result<Symbol, AllocError> intern_symbol(std::string_view str)
+  {
+    size_t const                 shard_index = Hash<std::string_view>{}(str) >> (64 - impl::STRING_INTERNER_SHARD_BITS);
+    impl::StringInternerShard   &shard       = state_.handle->shards[shard_index];
+    Result<uint32_t, AllocError> id          = Err(AllocError::NoMemory);
+
+    STX_WITH_LOCK(shard.lock, { id = shard.intern(state_.handle->allocator, str); });
+
+    TRY_OK(local_id, std::move(id));
+
+    return Ok(Symbol{static_cast<uint32_t>((local_id << impl::STRING_INTERNER_SHARD_BITS) | shard_index)});
+  }
+
+  // the contents of `symbol`, which must be from this interner. valid for the
+  // lifetime of the interner.
+  std::string_view resolve(Symbol symbol) const
+  {
+    uint32_t const             id    = static_cast<uint32_t>(symbol);
+    impl::StringInternerShard &shard = state_.handle->shards[id & (impl::STRING_INTERNER_SHARDS - 1)];
+    std::string_view           str;
+
+    STX_WITH_LOCK(shard.lock, { str = shard.symbols.data()[id >> impl::STRING_INTERNER_SHARD_BITS]; });
+
+    return str;
+  }
+
+  // number of interned strings. only a snapshot if other threads are
+  // interning.
+  Size size() const
+  {
+    Size size = 0;
+
+    for (impl::StringInternerShard &shard : state_.handle->shards)
+    {
+      STX_WITH_LOCK(shard.lock, { size += shard.symbols.size(); });
+    }
+
+    return size;
+  }
+
+  // another handle to the same interner, i.e. for other threads
+  StringInterner share() const
+  {
+    return StringInterner{state_.share()};
+  }
+
+  Rc<impl::StringInternerState *> state_;
+};
+
+namespace string
+{
+
+inline Result<StringInterner, AllocError> make_interner(Allocator allocator)
+{
+  TRY_OK(state, rc::make_inplace<impl::StringInternerState>(allocator, allocator));
+
+  return Ok(StringInterner{std::move(state)});
+}
+
+}        // namespace string
+
+STX_END_NAMESPACE
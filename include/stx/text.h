@@ -1,13 +1,36 @@
 #pragma once
 #include <cinttypes>
+#include <cstring>
 #include <string_view>
 
+#include "stx/allocator.h"
+#include "stx/bit.h"
 #include "stx/config.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/vec.h"
+
+#if STX_CFG(SIMD, SSE2)
+#  include <emmintrin.h>
+#elif STX_CFG(SIMD, NEON)
+#  include <arm_neon.h>
+#endif
 
 STX_BEGIN_NAMESPACE
 
+enum class [[nodiscard]] Utf8Error : uint8_t
+{
+  // the text is not valid UTF-8
+  InvalidSequence,
+  // the output could not be allocated
+  NoMemory
+};
+
 /// gets the unicode codepoint at iter and then advances iter to the next codepoint
 ///
+/// the text is assumed to be valid UTF-8, use `utf8_validate` or `utf8_decode`
+/// for untrusted text.
+///
 constexpr uint32_t utf8_next(uint8_t const *&iter)
 {
   if ((*iter & 0xF8) == 0xF0)
@@ -20,7 +43,7 @@ constexpr uint32_t utf8_next(uint8_t const *&iter)
     iter++;
     uint32_t c4 = *iter;
     iter++;
-    return c1 << 24 | c2 << 16 | c3 << 8 | c4;
+    return (c1 & 0x07) << 18 | (c2 & 0x3F) << 12 | (c3 & 0x3F) << 6 | (c4 & 0x3F);
   }
   else if ((*iter & 0xF0) == 0xE0)
   {
@@ -30,7 +53,7 @@ constexpr uint32_t utf8_next(uint8_t const *&iter)
     iter++;
     uint32_t c3 = *iter;
     iter++;
-    return c1 << 16 | c2 << 8 | c3;
+    return (c1 & 0x0F) << 12 | (c2 & 0x3F) << 6 | (c3 & 0x3F);
   }
   else if ((*iter & 0xE0) == 0xC0)
   {
@@ -38,7 +61,7 @@ constexpr uint32_t utf8_next(uint8_t const *&iter)
     iter++;
     uint32_t c2 = *iter;
     iter++;
-    return c1 << 8 | c2;
+    return (c1 & 0x1F) << 6 | (c2 & 0x3F);
   }
   else
   {
@@ -48,4 +71,312 @@ constexpr uint32_t utf8_next(uint8_t const *&iter)
   }
 }
 
+namespace impl
+{
+
+constexpr bool utf8_is_continuation(uint8_t byte)
+{
+  return (byte & 0xC0) == 0x80;
+}
+
+// decodes and validates the sequence at the start of `text`, which has
+// `size` > 0 bytes.
+//
+// returns the length of the sequence, or 0 if it is truncated, overlong,
+// encodes a surrogate or is beyond U+10FFFF.
+inline size_t utf8_decode_one(uint8_t const *text, size_t size, uint32_t &codepoint)
+{
+  uint8_t const lead = text[0];
+
+  if (lead < 0x80)
+  {
+    codepoint = lead;
+    return 1;
+  }
+
+  // continuation bytes and the overlong 2-byte leads 0xC0 and 0xC1
+  if (lead < 0xC2)
+  {
+    return 0;
+  }
+
+  if (lead < 0xE0)
+  {
+    if (size < 2 || !utf8_is_continuation(text[1]))
+    {
+      return 0;
+    }
+
+    codepoint = uint32_t{lead & 0x1Fu} << 6 | (text[1] & 0x3Fu);
+    return 2;
+  }
+
+  if (lead < 0xF0)
+  {
+    // excludes the overlong forms (E0 80..9F) and the surrogates (ED A0..BF)
+    uint8_t const min = lead == 0xE0 ? 0xA0 : 0x80;
+    uint8_t const max = lead == 0xED ? 0x9F : 0xBF;
+
+    if (size < 3 || text[1] < min || text[1] > max || !utf8_is_continuation(text[2]))
+    {
+      return 0;
+    }
+
+    codepoint = uint32_t{lead & 0x0Fu} << 12 | uint32_t{text[1] & 0x3Fu} << 6 | (text[2] & 0x3Fu);
+    return 3;
+  }
+
+  if (lead < 0xF5)
+  {
+    // excludes the overlong forms (F0 80..8F) and beyond U+10FFFF (F4 90..BF)
+    uint8_t const min = lead == 0xF0 ? 0x90 : 0x80;
+    uint8_t const max = lead == 0xF4 ? 0x8F : 0xBF;
+
+    if (size < 4 || text[1] < min || text[1] > max || !utf8_is_continuation(text[2]) || !utf8_is_continuation(text[3]))
+    {
+      return 0;
+    }
+
+    codepoint = uint32_t{lead & 0x07u} << 18 | uint32_t{text[1] & 0x3Fu} << 12 | uint32_t{text[2] & 0x3Fu} << 6 | (text[3] & 0x3Fu);
+    return 4;
+  }
+
+  return 0;
+}
+
+// length of the run of ASCII bytes at the start of `text`. checks 16 bytes at
+// a time (8 without SIMD) until the block with the first non-ASCII byte.
+inline size_t utf8_ascii_prefix(uint8_t const *text, size_t size)
+{
+  size_t i = 0;
+
+#if STX_CFG(SIMD, SSE2)
+  for (; i + 16 <= size; i += 16)
+  {
+    if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(text + i))) != 0)
+    {
+      break;
+    }
+  }
+#elif STX_CFG(SIMD, NEON)
+  for (; i + 16 <= size; i += 16)
+  {
+    uint64x2_t const chars = vreinterpretq_u64_u8(vld1q_u8(text + i));
+
+    if (((vgetq_lane_u64(chars, 0) | vgetq_lane_u64(chars, 1)) & 0x8080808080808080ULL) != 0)
+    {
+      break;
+    }
+  }
+#else
+  for (; i + 8 <= size; i += 8)
+  {
+    uint64_t chars;
+    std::memcpy(&chars, text + i, 8);
+
+    if ((chars & 0x8080808080808080ULL) != 0)
+    {
+      break;
+    }
+  }
+#endif
+
+  while (i < size && text[i] < 0x80)
+  {
+    i++;
+  }
+
+  return i;
+}
+
+}        // namespace impl
+
+/// length of the longest prefix of `text` that is valid UTF-8. equal to
+/// `text.size()` if all of `text` is valid.
+///
+/// runs of ASCII are checked 16 bytes at a time.
+///
+inline size_t utf8_valid_up_to(Span<uint8_t const> text)
+{
+  uint8_t const *const data = text.data();
+  size_t const         size = text.size();
+  size_t               i    = 0;
+
+  while (i < size)
+  {
+    if (data[i] < 0x80)
+    {
+      i += impl::utf8_ascii_prefix(data + i, size - i);
+      continue;
+    }
+
+    uint32_t     codepoint;
+    size_t const length = impl::utf8_decode_one(data + i, size - i, codepoint);
+
+    if (length == 0)
+    {
+      return i;
+    }
+
+    i += length;
+  }
+
+  return size;
+}
+
+/// checks that `text` is valid UTF-8: no truncated or overlong sequences, no
+/// surrogates and nothing beyond U+10FFFF
+///
+inline bool utf8_validate(Span<uint8_t const> text)
+{
+  return utf8_valid_up_to(text) == text.size();
+}
+
+/// number of codepoints in `text`, which must be valid UTF-8. i.e. the number
+/// of bytes that are not continuation bytes.
+///
+inline size_t utf8_count(Span<uint8_t const> text)
+{
+  uint8_t const *const data  = text.data();
+  size_t const         size  = text.size();
+  size_t               i     = 0;
+  size_t               count = 0;
+
+#if STX_CFG(SIMD, SSE2)
+  // the continuation bytes 0x80-0xBF are -128 to -65 as signed bytes
+  __m128i const continuation_max = _mm_set1_epi8(-65);
+
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i const chars = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + i));
+    count += popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(chars, continuation_max))));
+  }
+#elif STX_CFG(SIMD, NEON)
+  for (; i + 16 <= size; i += 16)
+  {
+    int8x16_t const  chars  = vreinterpretq_s8_u8(vld1q_u8(data + i));
+    uint8x16_t const starts = vshrq_n_u8(vcgtq_s8(chars, vdupq_n_s8(-65)), 7);
+    uint64x2_t const sums   = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(starts)));
+
+    count += vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1);
+  }
+#endif
+
+  for (; i < size; i++)
+  {
+    count += !impl::utf8_is_continuation(data[i]);
+  }
+
+  return count;
+}
+
+/// decodes `text` into `codepoints`, which must have room for all the
+/// codepoints (see `utf8_count`).
+///
+/// returns the number of codepoints written, or `Utf8Error::InvalidSequence`
+/// if `text` is not valid UTF-8, the contents of `codepoints` are then
+/// unspecified.
+///
+/// runs of ASCII are widened 16 bytes at a time.
+///
+inline Result<size_t, Utf8Error> utf8_decode(Span<uint8_t const> text, Span<uint32_t> codepoints)
+{
+  uint8_t const *const data     = text.data();
+  size_t const         size     = text.size();
+  uint32_t *const      out      = codepoints.data();
+  size_t const         capacity = codepoints.size();
+  size_t               i        = 0;
+  size_t               count    = 0;
+
+  while (i < size)
+  {
+#if STX_CFG(SIMD, SSE2)
+    for (; i + 16 <= size && count + 16 <= capacity; i += 16, count += 16)
+    {
+      __m128i const chars = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + i));
+
+      if (_mm_movemask_epi8(chars) != 0)
+      {
+        break;
+      }
+
+      __m128i const zero = _mm_setzero_si128();
+      __m128i const lo   = _mm_unpacklo_epi8(chars, zero);
+      __m128i const hi   = _mm_unpackhi_epi8(chars, zero);
+
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + count), _mm_unpacklo_epi16(lo, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + count + 4), _mm_unpackhi_epi16(lo, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + count + 8), _mm_unpacklo_epi16(hi, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + count + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+#elif STX_CFG(SIMD, NEON)
+    for (; i + 16 <= size && count + 16 <= capacity; i += 16, count += 16)
+    {
+      uint8x16_t const chars = vld1q_u8(data + i);
+      uint64x2_t const words = vreinterpretq_u64_u8(chars);
+
+      if (((vgetq_lane_u64(words, 0) | vgetq_lane_u64(words, 1)) & 0x8080808080808080ULL) != 0)
+      {
+        break;
+      }
+
+      uint16x8_t const lo = vmovl_u8(vget_low_u8(chars));
+      uint16x8_t const hi = vmovl_u8(vget_high_u8(chars));
+
+      vst1q_u32(out + count, vmovl_u16(vget_low_u16(lo)));
+      vst1q_u32(out + count + 4, vmovl_u16(vget_high_u16(lo)));
+      vst1q_u32(out + count + 8, vmovl_u16(vget_low_u16(hi)));
+      vst1q_u32(out + count + 12, vmovl_u16(vget_high_u16(hi)));
+    }
+#endif
+
+    if (i >= size)
+    {
+      break;
+    }
+
+    uint32_t     codepoint;
+    size_t const length = impl::utf8_decode_one(data + i, size - i, codepoint);
+
+    if (length == 0)
+    {
+      return Err(Utf8Error::InvalidSequence);
+    }
+
+    STX_SPAN_ENSURE(count < capacity, "codepoint span is too small");
+
+    out[count] = codepoint;
+    count++;
+    i += length;
+  }
+
+  return Ok(size_t{count});
+}
+
+/// decodes `text` into a new `Vec`.
+///
+/// returns `Utf8Error::InvalidSequence` if `text` is not valid UTF-8 and
+/// `Utf8Error::NoMemory` if the `Vec` could not be allocated.
+///
+inline Result<Vec<uint32_t>, Utf8Error> utf8_decode(Allocator allocator, Span<uint8_t const> text)
+{
+  Vec<uint32_t> codepoints{allocator};
+
+  Result<Span<uint32_t>, AllocError> out = codepoints.unsafe_resize_uninitialized(utf8_count(text));
+
+  if (out.is_err())
+  {
+    return Err(Utf8Error::NoMemory);
+  }
+
+  Result<size_t, Utf8Error> count = utf8_decode(text, std::move(out).unwrap());
+
+  if (count.is_err())
+  {
+    return Err(std::move(count).unwrap_err());
+  }
+
+  return Ok(std::move(codepoints));
+}
+
 STX_END_NAMESPACE
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <utility>
 
 #include "stx/allocator.h"
 #include "stx/config.h"
 #include "stx/memory.h"
+#include "stx/relocate.h"
 #include "stx/result.h"
 #include "stx/span.h"
 #include "stx/struct.h"
@@ -34,12 +36,49 @@ constexpr void destruct_range(T *start, size_t size)
   }
 }
 
+// the source elements remain alive and still need to be destroyed.
+// `start` and `output` must not overlap.
 template <typename T>
 constexpr void move_construct_range(T *start, size_t size, T *output)
 {
-  for (T *iter = start; iter < (start + size); iter++, output++)
+  if constexpr (std::is_trivially_move_constructible_v<T>)
   {
-    new (output) T{std::move(*iter)};
+    if (size > 0)
+    {
+      std::memcpy(static_cast<void *>(output), start, size * sizeof(T));
+    }
+  }
+  else
+  {
+    for (T *iter = start; iter < (start + size); iter++, output++)
+    {
+      new (output) T{std::move(*iter)};
+    }
+  }
+}
+
+// moves the elements to `output` and ends the lifetime of the source
+// elements.
+//
+// `output` may overlap with the source range as long as it is at a lower
+// address, i.e. compacting trailing elements to the front.
+template <typename T>
+constexpr void relocate_range(T *start, size_t size, T *output)
+{
+  if constexpr (is_trivially_relocatable<T>)
+  {
+    if (size > 0)
+    {
+      std::memmove(static_cast<void *>(output), start, size * sizeof(T));
+    }
+  }
+  else
+  {
+    for (T *iter = start; iter < (start + size); iter++, output++)
+    {
+      new (output) T{std::move(*iter)};
+      iter->~T();
+    }
   }
 }
 
@@ -110,6 +149,7 @@ struct VecBase
   }
 
   STX_DISABLE_COPY(VecBase)
+  STX_MARK_TRIVIALLY_RELOCATABLE(VecBase)
 
   ~VecBase()
   {
@@ -121,6 +161,12 @@ struct VecBase
     return Span<T>{begin(), size_};
   }
 
+  // lazy iterator adapters over the elements. requires "stx/iter.h".
+  auto iter() const
+  {
+    return span().iter();
+  }
+
   T &operator[](Index index) const
   {
     return span()[index];
@@ -176,8 +222,7 @@ struct VecBase
 
     if (new_capacity != capacity_)
     {
-      if constexpr (std::is_trivially_move_constructible_v<T> &&
-                    std::is_trivially_destructible_v<T>)
+      if constexpr (is_trivially_relocatable<T>)
       {
         TRY_OK(ok, mem::reallocate(memory_, new_capacity_bytes));
 
@@ -190,17 +235,7 @@ struct VecBase
         TRY_OK(new_memory,
                mem::allocate(memory_.allocator, new_capacity_bytes));
 
-        T *new_location = static_cast<T *>(new_memory.handle);
-
-        T *iter = new_location;
-
-        for (T &element : span())
-        {
-          new (iter) T{std::move(element)};
-          iter++;
-        }
-
-        impl::destruct_range(begin(), size_);
+        impl::relocate_range(begin(), size_, static_cast<T *>(new_memory.handle));
 
         memory_   = std::move(new_memory);
         capacity_ = new_capacity;
@@ -243,7 +278,7 @@ struct VecBase
     size_t num_trailing = end() - erase_end;
 
     // move trailing elements to the front
-    impl::move_construct_range(erase_end, num_trailing, erase_start);
+    impl::relocate_range(erase_end, num_trailing, erase_start);
 
     size_ -= destruct_size;
   }
@@ -287,6 +322,7 @@ struct Vec : public VecBase<T>
 
   STX_DEFAULT_MOVE(Vec)
   STX_DISABLE_COPY(Vec)
+  STX_MARK_TRIVIALLY_RELOCATABLE(Vec)
   STX_DEFAULT_DESTRUCTOR(Vec)
 
   // invalidates references
@@ -435,11 +471,15 @@ struct Vec : public VecBase<T>
     if (base::size_ == 0)
       return None;
 
-    T last = std::move(*(base::begin() + base::size_ - 1));
+    T *last_pos = base::begin() + base::size_ - 1;
+
+    Option<T> last = Some(std::move(*last_pos));
 
-    resize(base::size_ - 1).unwrap();
+    impl::destruct_range(last_pos, 1);
 
-    return Some(std::move(last));
+    base::size_--;
+
+    return last;
   }
 };
 
@@ -463,6 +503,7 @@ struct FixedVec : public VecBase<T>
 
   STX_DEFAULT_MOVE(FixedVec)
   STX_DISABLE_COPY(FixedVec)
+  STX_MARK_TRIVIALLY_RELOCATABLE(FixedVec)
   STX_DEFAULT_DESTRUCTOR(FixedVec)
 
   template <typename... Args>
@@ -565,11 +606,15 @@ struct FixedVec : public VecBase<T>
     if (base::size_ == 0)
       return None;
 
-    T last = std::move(*(base::begin() + base::size_ - 1));
+    T *last_pos = base::begin() + base::size_ - 1;
+
+    Option<T> last = Some(std::move(*last_pos));
+
+    impl::destruct_range(last_pos, 1);
 
-    resize(base::size_ - 1).unwrap();
+    base::size_--;
 
-    return Some(std::move(last));
+    return last;
   }
 };
 
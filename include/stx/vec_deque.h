@@ -0,0 +1,349 @@
+#pragma once
+
+#include <cstring>
+#include <utility>
+
+#include "stx/allocator.h"
+#include "stx/config.h"
+#include "stx/memory.h"
+#include "stx/option.h"
+#include "stx/relocate.h"
+#include "stx/result.h"
+#include "stx/span.h"
+#include "stx/struct.h"
+#include "stx/try_ok.h"
+#include "stx/vec.h"
+#include "stx/void.h"
+
+STX_BEGIN_NAMESPACE
+
+namespace impl
+{
+
+constexpr size_t grow_deque_capacity(size_t capacity, size_t target)
+{
+  size_t new_capacity = capacity == 0 ? 1 : capacity;
+
+  while (new_capacity < target)
+  {
+    new_capacity <<= 1;
+  }
+
+  return new_capacity;
+}
+
+}        // namespace impl
+
+// VecDeque is a double-ended queue implemented as a growable ring buffer.
+//
+// pushing and popping at both ends are O(1) (amortized for pushes), unlike
+// `Vec` where removing the front element shifts every remaining element.
+//
+// the capacity is always a power of two so the ring indices wrap around with a
+// mask. the elements are contiguous in at most two segments, see `as_spans`.
+//
+// the allocator must be alive for the lifetime of the VecDeque.
+//
+// ONLY NON-CONST METHODS INVALIDATE ITERATORS
+//
+template <typename T>
+struct VecDeque
+{
+  static_assert(!std::is_reference_v<T>);
+
+  using Size  = size_t;
+  using Index = size_t;
+
+  // `memory` must hold `capacity` elements, `capacity` must be 0 or a power of
+  // two
+  VecDeque(Memory memory, Size capacity) :
+      memory_{std::move(memory)}, head_{0}, size_{0}, capacity_{capacity}
+  {
+    STX_SPAN_ENSURE((capacity & (capacity - 1)) == 0, "VecDeque capacity must be 0 or a power of two");
+  }
+
+  VecDeque() :
+      memory_{Memory{os_allocator, nullptr}}, head_{0}, size_{0}, capacity_{0}
+  {}
+
+  explicit VecDeque(Allocator allocator) :
+      memory_{Memory{allocator, nullptr}}, head_{0}, size_{0}, capacity_{0}
+  {}
+
+  VecDeque(VecDeque &&other) :
+      memory_{std::move(other.memory_)},
+      head_{other.head_},
+      size_{other.size_},
+      capacity_{other.capacity_}
+  {
+    other.memory_.allocator = memory_.allocator;
+    other.memory_.handle    = nullptr;
+    other.head_             = 0;
+    other.size_             = 0;
+    other.capacity_         = 0;
+  }
+
+  VecDeque &operator=(VecDeque &&other)
+  {
+    std::swap(memory_, other.memory_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+
+    return *this;
+  }
+
+  STX_DISABLE_COPY(VecDeque)
+  STX_MARK_TRIVIALLY_RELOCATABLE(VecDeque)
+
+  ~VecDeque()
+  {
+    clear();
+  }
+
+  Size size() const
+  {
+    return size_;
+  }
+
+  Size capacity() const
+  {
+    return capacity_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  T &operator[](Index index) const
+  {
+    STX_SPAN_ENSURE(index < size_, "index out of bounds");
+    return data()[physical_index(index)];
+  }
+
+  Option<Ref<T>> at(Index index) const
+  {
+    if (index < size_)
+    {
+      return Some<Ref<T>>(data()[physical_index(index)]);
+    }
+    else
+    {
+      return None;
+    }
+  }
+
+  Option<Ref<T>> front() const
+  {
+    return at(0);
+  }
+
+  Option<Ref<T>> back() const
+  {
+    if (size_ == 0)
+    {
+      return None;
+    }
+
+    return at(size_ - 1);
+  }
+
+  // the elements in order, as the segment from the head to the end of the
+  // ring buffer and the wrapped-around segment at the start of the ring
+  // buffer. the second span is empty if the elements don't wrap around.
+  std::pair<Span<T>, Span<T>> as_spans() const
+  {
+    Size first_size = std::min(size_, capacity_ - head_);
+
+    return std::make_pair(Span<T>{data() + head_, first_size},
+                          Span<T>{data(), size_ - first_size});
+  }
+
+  // reserve enough memory to contain at least `cap` elements. the capacity is
+  // rounded up to a power of two.
+  //
+  // does not release excess memory.
+  //
+  // returns the error if memory allocation fails
+  //
+  // invalidates references
+  //
+  Result<Void, AllocError> reserve(Size cap)
+  {
+    if (cap <= capacity_)
+    {
+      return Ok(Void{});
+    }
+
+    Size new_capacity = impl::grow_deque_capacity(capacity_, cap);
+
+    if constexpr (is_trivially_relocatable<T>)
+    {
+      TRY_OK(ok, mem::reallocate(memory_, new_capacity * sizeof(T)));
+
+      (void) ok;
+
+      // the wrapped-around segment is moved to just after the old end of the
+      // ring buffer. there is always enough space for it since the capacity
+      // at least doubles.
+      if (head_ + size_ > capacity_)
+      {
+        Size num_wrapped = head_ + size_ - capacity_;
+        std::memcpy(static_cast<void *>(data() + capacity_), data(), num_wrapped * sizeof(T));
+      }
+    }
+    else
+    {
+      TRY_OK(new_memory, mem::allocate(memory_.allocator, new_capacity * sizeof(T)));
+
+      T *new_data = static_cast<T *>(new_memory.handle);
+
+      std::pair<Span<T>, Span<T>> spans = as_spans();
+
+      impl::relocate_range(spans.first.data(), spans.first.size(), new_data);
+      impl::relocate_range(spans.second.data(), spans.second.size(), new_data + spans.first.size());
+
+      memory_ = std::move(new_memory);
+      head_   = 0;
+    }
+
+    capacity_ = new_capacity;
+
+    return Ok(Void{});
+  }
+
+  // invalidates references
+  //
+  // typically needed for non-movable types
+  template <typename... Args>
+  Result<Void, AllocError> push_back_inplace(Args &&...args)
+  {
+    static_assert(std::is_constructible_v<T, Args &&...>);
+
+    TRY_OK(ok, reserve(size_ + 1));
+
+    (void) ok;
+
+    new (data() + physical_index(size_)) T{std::forward<Args>(args)...};
+
+    size_++;
+
+    return Ok(Void{});
+  }
+
+  // invalidates references
+  //
+  // value is not moved if an allocation error occurs
+  Result<Void, AllocError> push_back(T &&value)
+  {
+    return push_back_inplace(std::move(value));
+  }
+
+  // invalidates references
+  //
+  // typically needed for non-movable types
+  template <typename... Args>
+  Result<Void, AllocError> push_front_inplace(Args &&...args)
+  {
+    static_assert(std::is_constructible_v<T, Args &&...>);
+
+    TRY_OK(ok, reserve(size_ + 1));
+
+    (void) ok;
+
+    Index new_head = (head_ + capacity_ - 1) & (capacity_ - 1);
+
+    new (data() + new_head) T{std::forward<Args>(args)...};
+
+    head_ = new_head;
+    size_++;
+
+    return Ok(Void{});
+  }
+
+  // invalidates references
+  //
+  // value is not moved if an allocation error occurs
+  Result<Void, AllocError> push_front(T &&value)
+  {
+    return push_front_inplace(std::move(value));
+  }
+
+  Option<T> pop_back()
+  {
+    if (size_ == 0)
+      return None;
+
+    T *last_pos = data() + physical_index(size_ - 1);
+
+    Option<T> last = Some(std::move(*last_pos));
+
+    impl::destruct_range(last_pos, 1);
+
+    size_--;
+
+    return last;
+  }
+
+  Option<T> pop_front()
+  {
+    if (size_ == 0)
+      return None;
+
+    T *first_pos = data() + head_;
+
+    Option<T> first = Some(std::move(*first_pos));
+
+    impl::destruct_range(first_pos, 1);
+
+    head_ = (head_ + 1) & (capacity_ - 1);
+    size_--;
+
+    return first;
+  }
+
+  // capacity is unchanged
+  void clear()
+  {
+    std::pair<Span<T>, Span<T>> spans = as_spans();
+
+    impl::destruct_range(spans.first.data(), spans.first.size());
+    impl::destruct_range(spans.second.data(), spans.second.size());
+
+    head_ = 0;
+    size_ = 0;
+  }
+
+  T *data() const
+  {
+    return static_cast<T *>(memory_.handle);
+  }
+
+  Memory memory_;
+  Index  head_     = 0;
+  Size   size_     = 0;
+  Size   capacity_ = 0;
+
+private:
+  Index physical_index(Index index) const
+  {
+    return (head_ + index) & (capacity_ - 1);
+  }
+};
+
+namespace vec
+{
+
+// capacity is rounded up to a power of two
+template <typename T>
+Result<VecDeque<T>, AllocError> make_deque(Allocator allocator, size_t capacity = 0)
+{
+  size_t const deque_capacity = capacity == 0 ? 0 : impl::grow_deque_capacity(0, capacity);
+  TRY_OK(memory, mem::allocate(allocator, deque_capacity * sizeof(T)));
+  return Ok(VecDeque<T>{std::move(memory), deque_capacity});
+}
+
+}        // namespace vec
+
+STX_END_NAMESPACE
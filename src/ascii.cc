@@ -0,0 +1 @@
+#include "stx/ascii.h"
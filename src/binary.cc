@@ -0,0 +1 @@
+#include "stx/binary.h"
@@ -0,0 +1 @@
+#include "stx/binary_heap.h"
@@ -0,0 +1 @@
+#include "stx/bit.h"
@@ -0,0 +1 @@
+#include "stx/cache.h"
@@ -0,0 +1 @@
+#include "stx/concurrent_hash_map.h"
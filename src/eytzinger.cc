@@ -0,0 +1 @@
+#include "stx/eytzinger.h"
@@ -0,0 +1 @@
+#include "stx/flat_map.h"
@@ -0,0 +1 @@
+#include "stx/fmt.h"
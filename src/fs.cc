@@ -0,0 +1,388 @@
+#include "stx/fs.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if STX_CFG(OS, POSIX)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+STX_BEGIN_NAMESPACE
+
+#if STX_CFG(OS, POSIX)
+
+namespace
+{
+
+IoError io_error_from_errno(int error)
+{
+  switch (error)
+  {
+    case ENOENT:
+    case ENOTDIR:
+    case ENAMETOOLONG:
+    case ELOOP:
+      return IoError::NotFound;
+    case EACCES:
+    case EPERM:
+      return IoError::PermissionDenied;
+    case EISDIR:
+    case ENODEV:
+      return IoError::NotRegularFile;
+    case ENOMEM:
+    case EMFILE:
+    case ENFILE:
+    case EOVERFLOW:
+      return IoError::NoMemory;
+    case ENOSPC:
+    case EFBIG:
+#  if defined(EDQUOT)
+    case EDQUOT:
+#  endif
+      return IoError::NoSpace;
+    default:
+      return IoError::Other;
+  }
+}
+
+int to_posix_advice(MemoryAdvice advice)
+{
+  switch (advice)
+  {
+    case MemoryAdvice::Sequential:
+      return POSIX_MADV_SEQUENTIAL;
+    case MemoryAdvice::Random:
+      return POSIX_MADV_RANDOM;
+    case MemoryAdvice::WillNeed:
+      return POSIX_MADV_WILLNEED;
+    case MemoryAdvice::DontNeed:
+      return POSIX_MADV_DONTNEED;
+    default:
+      return POSIX_MADV_NORMAL;
+  }
+}
+
+// unmaps a file mapping once the memory referring to it is deallocated. each
+// mapping gets its own handle since the size of the mapping is needed to
+// unmap it, the handle destroys itself with the mapping.
+struct FileMappingHandle final : public AllocatorHandle
+{
+  FileMappingHandle(void *ibase, size_t isize) :
+      base{ibase}, size{isize}
+  {}
+
+  virtual RawAllocError allocate(memory_handle &, size_t) override
+  {
+    return RawAllocError::NoMemory;
+  }
+
+  virtual RawAllocError reallocate(memory_handle &, size_t) override
+  {
+    return RawAllocError::NoMemory;
+  }
+
+  virtual void deallocate(memory_handle mem) override
+  {
+    if (mem == nullptr)
+    {
+      return;
+    }
+
+    ::munmap(base, size);
+
+    this->~FileMappingHandle();
+    std::free(this);
+  }
+
+  void  *base = nullptr;
+  size_t size = 0;
+};
+
+}        // namespace
+
+size_t impl::page_size()
+{
+  static size_t const size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+impl::SharedFileMapping::~SharedFileMapping()
+{
+  if (data_ != nullptr)
+  {
+    ::munmap(data_, size_);
+  }
+
+  if (fd_ != -1)
+  {
+    ::close(fd_);
+  }
+}
+
+Result<Void, IoError> impl::SharedFileMapping::resize(Size size)
+{
+  if (::ftruncate(fd_, static_cast<off_t>(size)) != 0)
+  {
+    return Err(io_error_from_errno(errno));
+  }
+
+  if (size == 0)
+  {
+    if (data_ != nullptr)
+    {
+      ::munmap(data_, size_);
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+
+    return Ok(Void{});
+  }
+
+#  if defined(MREMAP_MAYMOVE)
+  if (data_ != nullptr)
+  {
+    void *data = ::mremap(data_, size_, size, MREMAP_MAYMOVE);
+
+    if (data == MAP_FAILED)
+    {
+      return Err(io_error_from_errno(errno));
+    }
+
+    data_ = data;
+    size_ = size;
+
+    return Ok(Void{});
+  }
+#  endif
+
+  // the new mapping is made before the old one is released so the old one is
+  // kept on failure
+  void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+
+  if (data == MAP_FAILED)
+  {
+    return Err(io_error_from_errno(errno));
+  }
+
+  if (data_ != nullptr)
+  {
+    ::munmap(data_, size_);
+  }
+
+  data_ = data;
+  size_ = size;
+
+  return Ok(Void{});
+}
+
+Result<Void, IoError> impl::SharedFileMapping::sync() const
+{
+  if (data_ != nullptr && ::msync(data_, size_, MS_SYNC) != 0)
+  {
+    return Err(io_error_from_errno(errno));
+  }
+
+  return Ok(Void{});
+}
+
+Result<impl::SharedFileMapping, IoError> impl::map_shared(CStringView path)
+{
+  SharedFileMapping mapping;
+
+  do
+  {
+    mapping.fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  } while (mapping.fd_ == -1 && errno == EINTR);
+
+  if (mapping.fd_ == -1)
+  {
+    return Err(io_error_from_errno(errno));
+  }
+
+  struct stat info;
+
+  if (::fstat(mapping.fd_, &info) != 0)
+  {
+    return Err(io_error_from_errno(errno));
+  }
+
+  if (!S_ISREG(info.st_mode))
+  {
+    return Err(IoError::NotRegularFile);
+  }
+
+  if (static_cast<uintmax_t>(info.st_size) >= SIZE_MAX / 2)
+  {
+    return Err(IoError::NoMemory);
+  }
+
+  size_t const size = static_cast<size_t>(info.st_size);
+
+  if (size != 0)
+  {
+    void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mapping.fd_, 0);
+
+    if (data == MAP_FAILED)
+    {
+      return Err(io_error_from_errno(errno));
+    }
+
+    mapping.data_ = data;
+    mapping.size_ = size;
+  }
+
+  return Ok(std::move(mapping));
+}
+
+Result<Void, IoError> MappedFile::advise(MemoryAdvice advice) const
+{
+  if (size_ == 0)
+  {
+    return Ok(Void{});
+  }
+
+  // the mapping starts at a page boundary
+  int const error = ::posix_madvise(const_cast<void *>(memory_.handle), size_, to_posix_advice(advice));
+
+  if (error != 0)
+  {
+    return Err(io_error_from_errno(error));
+  }
+
+  return Ok(Void{});
+}
+
+Result<MappedFile, IoError> fs::map_readonly(CStringView path, MemoryAdvice advice)
+{
+  int fd = -1;
+
+  do
+  {
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  } while (fd == -1 && errno == EINTR);
+
+  if (fd == -1)
+  {
+    return Err(io_error_from_errno(errno));
+  }
+
+  struct stat info;
+
+  if (::fstat(fd, &info) != 0)
+  {
+    int const error = errno;
+    ::close(fd);
+    return Err(io_error_from_errno(error));
+  }
+
+  if (!S_ISREG(info.st_mode))
+  {
+    ::close(fd);
+    return Err(IoError::NotRegularFile);
+  }
+
+  if (static_cast<uintmax_t>(info.st_size) >= SIZE_MAX / 2)
+  {
+    ::close(fd);
+    return Err(IoError::NoMemory);
+  }
+
+  size_t const size = static_cast<size_t>(info.st_size);
+
+  if (size == 0)
+  {
+    ::close(fd);
+    return Ok(MappedFile{ReadOnlyMemory{static_storage_allocator, ""}, 0});
+  }
+
+  size_t const page_size = impl::page_size();
+  size_t const reserved  = (size + 1 + page_size - 1) / page_size * page_size;
+
+  // reserves zeroed pages for the file and a null-terminator, then maps the
+  // file over them. the rest of the file's last page is zero-filled, and if
+  // the file ends at a page boundary the next reserved page is.
+  void *base = ::mmap(nullptr, reserved, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+  if (base == MAP_FAILED)
+  {
+    int const error = errno;
+    ::close(fd);
+    return Err(io_error_from_errno(error));
+  }
+
+  if (::mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+  {
+    int const error = errno;
+    ::munmap(base, reserved);
+    ::close(fd);
+    return Err(io_error_from_errno(error));
+  }
+
+  // the mapping keeps the file open
+  ::close(fd);
+
+  void *handle_memory = std::malloc(sizeof(FileMappingHandle));
+
+  if (handle_memory == nullptr)
+  {
+    ::munmap(base, reserved);
+    return Err(IoError::NoMemory);
+  }
+
+  FileMappingHandle *handle = new (handle_memory) FileMappingHandle{base, reserved};
+
+  MappedFile file{ReadOnlyMemory{Allocator{*handle}, base}, size};
+
+  if (advice != MemoryAdvice::Normal)
+  {
+    // only a hint, the mapping is usable without it
+    (void) file.advise(advice);
+  }
+
+  return Ok(std::move(file));
+}
+
+#else
+
+size_t impl::page_size()
+{
+  return 4096;
+}
+
+impl::SharedFileMapping::~SharedFileMapping()
+{}
+
+Result<Void, IoError> impl::SharedFileMapping::resize(Size)
+{
+  return Err(IoError::Unsupported);
+}
+
+Result<Void, IoError> impl::SharedFileMapping::sync() const
+{
+  return Err(IoError::Unsupported);
+}
+
+Result<impl::SharedFileMapping, IoError> impl::map_shared(CStringView)
+{
+  return Err(IoError::Unsupported);
+}
+
+Result<Void, IoError> MappedFile::advise(MemoryAdvice) const
+{
+  return Err(IoError::Unsupported);
+}
+
+Result<MappedFile, IoError> fs::map_readonly(CStringView, MemoryAdvice)
+{
+  return Err(IoError::Unsupported);
+}
+
+#endif
+
+STX_END_NAMESPACE
@@ -0,0 +1 @@
+#include "stx/hash_map.h"
@@ -0,0 +1 @@
+#include "stx/intrusive_list.h"
@@ -0,0 +1 @@
+#include "stx/iter.h"
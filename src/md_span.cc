@@ -0,0 +1 @@
+#include "stx/md_span.h"
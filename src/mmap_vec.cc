@@ -0,0 +1 @@
+#include "stx/mmap_vec.h"
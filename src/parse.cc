@@ -0,0 +1 @@
+#include "stx/parse.h"
@@ -0,0 +1 @@
+#include "stx/persistent.h"
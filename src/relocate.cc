@@ -0,0 +1 @@
+#include "stx/relocate.h"
@@ -0,0 +1 @@
+#include "stx/slot_map.h"
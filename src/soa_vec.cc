@@ -0,0 +1 @@
+#include "stx/soa_vec.h"
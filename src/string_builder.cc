@@ -0,0 +1 @@
+#include "stx/string_builder.h"
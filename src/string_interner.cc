@@ -0,0 +1 @@
+#include "stx/string_interner.h"
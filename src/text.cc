@@ -0,0 +1 @@
+#include "stx/text.h"
@@ -0,0 +1 @@
+#include "stx/vec_deque.h"
@@ -0,0 +1,55 @@
+#include "stx/ascii.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(AsciiTest, Char)
+{
+  for (int i = 0; i < 256; i++)
+  {
+    char const c = static_cast<char>(i);
+
+    bool const is_upper = c >= 'A' && c <= 'Z';
+    bool const is_lower = c >= 'a' && c <= 'z';
+
+    EXPECT_EQ(ascii::to_lower(c), is_upper ? static_cast<char>(c + 32) : c);
+    EXPECT_EQ(ascii::to_upper(c), is_lower ? static_cast<char>(c - 32) : c);
+  }
+}
+
+TEST(AsciiTest, Bulk)
+{
+  // every byte value, so both the 16-byte blocks and the tail see the
+  // boundaries of the letter ranges
+  std::string all;
+  for (int i = 0; i < 256; i++)
+  {
+    all.push_back(static_cast<char>(i));
+  }
+  all += "tail";
+
+  std::string lower(all.size(), '\0');
+  std::string upper(all.size(), '\0');
+
+  ascii::to_lower(Span<char const>{all.data(), all.size()}, Span<char>{lower.data(), lower.size()});
+  ascii::to_upper(Span<char const>{all.data(), all.size()}, Span<char>{upper.data(), upper.size()});
+
+  for (size_t i = 0; i < all.size(); i++)
+  {
+    EXPECT_EQ(lower[i], ascii::to_lower(all[i]));
+    EXPECT_EQ(upper[i], ascii::to_upper(all[i]));
+  }
+
+  EXPECT_TRUE(ascii::equal_ignore_case(lower, upper));
+  EXPECT_TRUE(ascii::equal_ignore_case(all, lower));
+
+  // in place
+  ascii::to_upper(Span<char const>{lower.data(), lower.size()}, Span<char>{lower.data(), lower.size()});
+  EXPECT_EQ(lower, upper);
+
+  upper[200] ^= 1;
+  EXPECT_FALSE(ascii::equal_ignore_case(lower, upper));
+}
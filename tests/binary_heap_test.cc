@@ -0,0 +1,129 @@
+#include "stx/binary_heap.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "stx/rc.h"
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(BinaryHeapTest, PushPop)
+{
+  BinaryHeap<int> heap{os_allocator};
+
+  EXPECT_TRUE(heap.is_empty());
+  EXPECT_EQ(heap.top(), None);
+  EXPECT_EQ(heap.pop(), None);
+
+  std::mt19937     generator{0};
+  std::vector<int> expected;
+
+  for (int i = 0; i < 1000; i++)
+  {
+    int value = static_cast<int>(generator() % 500);
+    expected.push_back(value);
+    heap.push(int{value}).unwrap();
+  }
+
+  std::sort(expected.begin(), expected.end());
+
+  EXPECT_EQ(heap.size(), 1000);
+  EXPECT_EQ(heap.top().value().get(), expected[0]);
+
+  for (int value : expected)
+  {
+    EXPECT_EQ(heap.pop(), Some(int{value}));
+  }
+
+  EXPECT_TRUE(heap.is_empty());
+}
+
+TEST(BinaryHeapTest, MaxHeap)
+{
+  BinaryHeap<int, std::greater<int>, 8> heap{os_allocator};
+
+  for (int i = 0; i < 100; i++)
+  {
+    heap.push(int{i}).unwrap();
+  }
+
+  for (int i = 99; i >= 0; i--)
+  {
+    EXPECT_EQ(heap.pop(), Some(int{i}));
+  }
+}
+
+TEST(BinaryHeapTest, UpdateErase)
+{
+  BinaryHeap<int> heap{os_allocator};
+
+  HeapHandle handles[100];
+
+  for (int i = 0; i < 100; i++)
+  {
+    handles[i] = heap.push(int{i + 100}).unwrap();
+  }
+
+  // decrease-key
+  EXPECT_TRUE(heap.update(handles[50], 0));
+  EXPECT_EQ(heap.top().value().get(), 0);
+  EXPECT_EQ(heap.get(handles[50]).value().get(), 0);
+
+  // increase-key
+  EXPECT_TRUE(heap.update(handles[50], 1000));
+  EXPECT_EQ(heap.top().value().get(), 100);
+
+  EXPECT_EQ(heap.erase(handles[0]), Some(100));
+  EXPECT_EQ(heap.erase(handles[0]), None);
+  EXPECT_FALSE(heap.contains(handles[0]));
+  EXPECT_FALSE(heap.update(handles[0], 5));
+
+  for (int i = 1; i < 100; i++)
+  {
+    EXPECT_TRUE(heap.contains(handles[i]));
+  }
+
+  for (int i = 1; i < 100; i++)
+  {
+    if (i == 50)
+    {
+      continue;
+    }
+
+    EXPECT_EQ(heap.pop(), Some(int{i + 100}));
+  }
+
+  EXPECT_EQ(heap.pop(), Some(1000));
+  EXPECT_FALSE(heap.contains(handles[50]));
+}
+
+TEST(BinaryHeapTest, Lifetime)
+{
+  BinaryHeap<Rc<int *>, bool (*)(Rc<int *> const &, Rc<int *> const &)> heap{
+      os_allocator, [](Rc<int *> const &a, Rc<int *> const &b) { return *a < *b; }};
+
+  HeapHandle handle = heap.push(rc::make(os_allocator, 5).unwrap()).unwrap();
+
+  for (int i = 10; i > 0; i--)
+  {
+    heap.push(rc::make(os_allocator, int{i}).unwrap()).unwrap();
+  }
+
+  EXPECT_EQ(*heap.erase(handle).unwrap(), 5);
+  EXPECT_EQ(*heap.pop().unwrap(), 1);
+  EXPECT_EQ(heap.size(), 9);
+
+  heap.clear();
+  EXPECT_TRUE(heap.is_empty());
+}
+
+TEST(BinaryHeapTest, AllocationFailure)
+{
+  BinaryHeap<int> heap{noop_allocator};
+
+  EXPECT_EQ(heap.push(1), Err(AllocError::NoMemory));
+  EXPECT_TRUE(heap.is_empty());
+}
@@ -0,0 +1,204 @@
+#include "stx/binary.h"
+
+#include <string_view>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+namespace
+{
+
+struct Point
+{
+  float x = 0;
+  float y = 0;
+};
+
+struct Entry
+{
+  String           name;
+  Vec<Point>       points;
+  Option<uint32_t> parent = None;
+};
+
+// an older version of `Entry`, without `parent`
+struct EntryV1
+{
+  String     name;
+  Vec<Point> points;
+};
+
+enum class Status : uint8_t
+{
+  Ok,
+  Missing
+};
+
+}        // namespace
+
+template <>
+struct stx::is_fixed_layout<Point> : std::true_type
+{};
+
+template <>
+struct stx::Binary<Entry>
+{
+  static Result<Void, AllocError> encode(BinaryWriter &writer, Entry const &entry)
+  {
+    return writer.write_struct(entry.name, entry.points, entry.parent);
+  }
+
+  static Result<Entry, BinaryError> decode(BinaryReader &reader)
+  {
+    Entry entry;
+    TRY_OK(ok, reader.read_struct(entry.name, entry.points, entry.parent));
+    (void) ok;
+    return Ok(std::move(entry));
+  }
+};
+
+template <>
+struct stx::Binary<EntryV1>
+{
+  static Result<Void, AllocError> encode(BinaryWriter &writer, EntryV1 const &entry)
+  {
+    return writer.write_struct(entry.name, entry.points);
+  }
+
+  static Result<EntryV1, BinaryError> decode(BinaryReader &reader)
+  {
+    EntryV1 entry;
+    TRY_OK(ok, reader.read_struct(entry.name, entry.points));
+    (void) ok;
+    return Ok(std::move(entry));
+  }
+};
+
+TEST(BinaryTest, Scalars)
+{
+  Vec<uint8_t> buffer = binary::encode(os_allocator, uint32_t{7}, true, Status::Missing, 2.5).unwrap();
+
+  EXPECT_EQ(buffer.size(), 4 + 1 + 1 + 8);
+
+  BinaryReader reader{buffer.span(), os_allocator};
+
+  uint32_t number = 0;
+  bool     flag   = false;
+  Status   status = Status::Ok;
+  double   real   = 0;
+
+  reader.read(number, flag, status, real).unwrap();
+
+  EXPECT_EQ(number, 7);
+  EXPECT_TRUE(flag);
+  EXPECT_EQ(status, Status::Missing);
+  EXPECT_EQ(real, 2.5);
+  EXPECT_EQ(reader.remaining(), 0);
+
+  EXPECT_EQ(reader.read(number).unwrap_err(), BinaryError::UnexpectedEnd);
+}
+
+TEST(BinaryTest, Varint)
+{
+  for (uint64_t value : {uint64_t{0}, uint64_t{127}, uint64_t{128}, uint64_t{300}, UINT64_MAX})
+  {
+    BinaryWriter writer{os_allocator};
+    writer.write_varint(value).unwrap();
+
+    BinaryReader reader{writer.buffer_.span(), os_allocator};
+    EXPECT_EQ(reader.read_varint().unwrap(), value);
+  }
+
+  uint8_t overlong[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F};
+  EXPECT_EQ((BinaryReader{overlong, os_allocator}.read_varint().unwrap_err()), BinaryError::InvalidData);
+}
+
+TEST(BinaryTest, ZeroCopy)
+{
+  uint32_t ids[] = {1, 2, 3, 4};
+
+  Vec<uint8_t> buffer = binary::encode(os_allocator, std::string_view{"name"}, Span<uint32_t const>{ids}).unwrap();
+
+  BinaryReader         reader{buffer.span(), os_allocator};
+  std::string_view     name;
+  Span<uint32_t const> decoded_ids;
+
+  reader.read(name, decoded_ids).unwrap();
+
+  EXPECT_EQ(name, "name");
+  ASSERT_EQ(decoded_ids.size(), 4);
+  EXPECT_EQ(decoded_ids[3], 4);
+
+  // the views refer to the input
+  EXPECT_GE(reinterpret_cast<uint8_t const *>(name.data()), buffer.begin());
+  EXPECT_LT(reinterpret_cast<uint8_t const *>(decoded_ids.data()), buffer.end());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(decoded_ids.data()) % alignof(uint32_t), 0);
+}
+
+TEST(BinaryTest, Containers)
+{
+  Entry entry;
+  entry.name = string::make(os_allocator, "thumbnail").unwrap();
+  entry.points.push(Point{1, 2}).unwrap();
+  entry.points.push(Point{3, 4}).unwrap();
+  entry.parent = Some(uint32_t{9});
+
+  Vec<uint8_t> buffer = binary::encode(os_allocator, entry).unwrap();
+  Entry        decoded = binary::decode<Entry>(buffer.span(), os_allocator).unwrap();
+
+  EXPECT_EQ(decoded.name, "thumbnail");
+  ASSERT_EQ(decoded.points.size(), 2);
+  EXPECT_EQ(decoded.points[1].y, 4);
+  EXPECT_EQ(decoded.parent, Some(uint32_t{9}));
+
+  Vec<Result<String, uint32_t>> results{os_allocator};
+  results.push(Ok(string::make(os_allocator, "ok").unwrap())).unwrap();
+  results.push(Err(uint32_t{404})).unwrap();
+
+  buffer = binary::encode(os_allocator, results).unwrap();
+
+  Vec<Result<String, uint32_t>> decoded_results = binary::decode<Vec<Result<String, uint32_t>>>(buffer.span(), os_allocator).unwrap();
+
+  ASSERT_EQ(decoded_results.size(), 2);
+  EXPECT_EQ(decoded_results[0].value(), "ok");
+  EXPECT_EQ(decoded_results[1].err(), 404);
+
+  // owned values need an allocator
+  buffer = binary::encode(os_allocator, string::make(os_allocator, "a longer string than fits inline").unwrap()).unwrap();
+  EXPECT_EQ(binary::decode<String>(buffer.span()).unwrap_err(), BinaryError::NoMemory);
+}
+
+TEST(BinaryTest, SchemaEvolution)
+{
+  EntryV1 old_entry;
+  old_entry.name = string::make(os_allocator, "old").unwrap();
+
+  Vec<uint8_t> old_buffer = binary::encode(os_allocator, old_entry).unwrap();
+
+  // the missing field keeps its value
+  Entry entry = binary::decode<Entry>(old_buffer.span(), os_allocator).unwrap();
+  EXPECT_EQ(entry.name, "old");
+  EXPECT_EQ(entry.parent, None);
+
+  // the appended field is skipped
+  entry.parent = Some(uint32_t{1});
+
+  Vec<uint8_t> new_buffer = binary::encode(os_allocator, entry).unwrap();
+  EXPECT_EQ(binary::decode<EntryV1>(new_buffer.span(), os_allocator).unwrap().name, "old");
+}
+
+TEST(BinaryTest, InvalidInput)
+{
+  uint8_t bad_bool[] = {2};
+  EXPECT_EQ(binary::decode<bool>(bad_bool).unwrap_err(), BinaryError::InvalidData);
+
+  uint8_t truncated_string[] = {10, 'a'};
+  EXPECT_EQ(binary::decode<std::string_view>(truncated_string).unwrap_err(), BinaryError::UnexpectedEnd);
+
+  uint8_t huge_vec[] = {0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+  EXPECT_EQ(binary::decode<Vec<String>>(huge_vec, os_allocator).unwrap_err(), BinaryError::UnexpectedEnd);
+
+  uint8_t trailing[] = {1, 0};
+  EXPECT_EQ(binary::decode<bool>(trailing).unwrap_err(), BinaryError::InvalidData);
+}
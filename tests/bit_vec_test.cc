@@ -0,0 +1,168 @@
+#include "stx/bit_vec.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(BitVecTest, SetGet)
+{
+  BitVec bits{os_allocator};
+
+  bits.resize(130).unwrap();
+
+  EXPECT_EQ(bits.size(), 130);
+  EXPECT_EQ(bits.span().num_words(), 3);
+  EXPECT_FALSE(bits.span().any());
+
+  bits.set(0);
+  bits.set(64);
+  bits.set(129);
+
+  EXPECT_TRUE(bits.get(0));
+  EXPECT_FALSE(bits.get(1));
+  EXPECT_TRUE(bits.get(64));
+  EXPECT_TRUE(bits.get(129));
+  EXPECT_EQ(bits.span().count_ones(), 3);
+
+  bits.unset(64);
+  EXPECT_FALSE(bits.get(64));
+  EXPECT_EQ(bits.span().count_ones(), 2);
+
+  bits.span().set_all();
+  EXPECT_TRUE(bits.span().all());
+  EXPECT_EQ(bits.span().count_ones(), 130);
+
+  bits.span().unset_all();
+  EXPECT_FALSE(bits.span().any());
+}
+
+TEST(BitVecTest, ResizePush)
+{
+  BitVec bits{os_allocator};
+
+  for (size_t i = 0; i < 100; i++)
+  {
+    bits.push(i % 3 == 0).unwrap();
+  }
+
+  EXPECT_EQ(bits.size(), 100);
+  EXPECT_EQ(bits.span().count_ones(), 34);
+
+  bits.resize(200, true).unwrap();
+  EXPECT_EQ(bits.span().count_ones(), 134);
+
+  // the truncated bits must not be counted once the vec grows again
+  bits.resize(10).unwrap();
+  EXPECT_EQ(bits.span().count_ones(), 4);
+
+  bits.resize(128).unwrap();
+  EXPECT_EQ(bits.span().count_ones(), 4);
+}
+
+TEST(BitVecTest, Find)
+{
+  BitVec bits{os_allocator};
+
+  bits.resize(200).unwrap();
+
+  EXPECT_EQ(bits.span().find_first_set(), None);
+  EXPECT_EQ(bits.span().find_first_unset(), Some<size_t>(0));
+
+  bits.set(5);
+  bits.set(70);
+  bits.set(199);
+
+  EXPECT_EQ(bits.span().find_first_set(), Some<size_t>(5));
+  EXPECT_EQ(bits.span().find_first_set(5), Some<size_t>(5));
+  EXPECT_EQ(bits.span().find_first_set(6), Some<size_t>(70));
+  EXPECT_EQ(bits.span().find_first_set(71), Some<size_t>(199));
+  EXPECT_EQ(bits.span().find_first_set(200), None);
+
+  bits.span().set_all();
+  bits.unset(150);
+
+  EXPECT_EQ(bits.span().find_first_unset(), Some<size_t>(150));
+  bits.set(150);
+
+  // the bits past the end are not considered
+  EXPECT_EQ(bits.span().find_first_unset(), None);
+}
+
+TEST(BitVecTest, Ones)
+{
+  BitVec bits{os_allocator};
+
+  bits.resize(300).unwrap();
+
+  std::vector<size_t> expected{0, 3, 63, 64, 65, 200, 299};
+
+  for (size_t index : expected)
+  {
+    bits.set(index);
+  }
+
+  std::vector<size_t> ones;
+
+  for (size_t index : bits.span().ones())
+  {
+    ones.push_back(index);
+  }
+
+  EXPECT_EQ(ones, expected);
+
+  BitVec empty{os_allocator};
+
+  EXPECT_EQ(empty.span().ones().begin(), empty.span().ones().end());
+}
+
+TEST(BitVecTest, SetOperations)
+{
+  BitVec a{os_allocator};
+  BitVec b{os_allocator};
+
+  a.resize(100).unwrap();
+  b.resize(100).unwrap();
+
+  a.set(1);
+  a.set(2);
+  b.set(2);
+  b.set(99);
+
+  a.span().union_with(b.span());
+  EXPECT_EQ(a.span().count_ones(), 3);
+
+  a.span().intersect_with(b.span());
+  EXPECT_EQ(a.span().count_ones(), 2);
+  EXPECT_TRUE(a.get(99));
+
+  a.span().difference_with(b.span());
+  EXPECT_FALSE(a.span().any());
+}
+
+TEST(FixedBitSetTest, SetGet)
+{
+  FixedBitSet<70> bits;
+
+  EXPECT_EQ(bits.size(), 70);
+
+  bits.set(69);
+  bits.set(3);
+
+  EXPECT_TRUE(bits.get(69));
+  EXPECT_FALSE(bits.get(68));
+  EXPECT_EQ(bits.span().count_ones(), 2);
+  EXPECT_EQ(bits.span().find_first_set(4), Some<size_t>(69));
+
+  bits.span().set_all();
+  EXPECT_EQ(bits.span().count_ones(), 70);
+}
+
+TEST(BitVecTest, AllocationFailure)
+{
+  BitVec bits{noop_allocator};
+
+  EXPECT_EQ(bits.push(true), Err(AllocError::NoMemory));
+  EXPECT_TRUE(bits.is_empty());
+}
@@ -0,0 +1,171 @@
+#include "stx/cache.h"
+
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+namespace
+{
+
+// fails every allocation once `fail` is set
+struct FailingAllocatorHandle final : public AllocatorHandle
+{
+  virtual RawAllocError allocate(memory_handle &out_mem, size_t size) override
+  {
+    return fail ? RawAllocError::NoMemory : os_allocator.handle->allocate(out_mem, size);
+  }
+
+  virtual RawAllocError reallocate(memory_handle &out_mem, size_t new_size) override
+  {
+    return fail ? RawAllocError::NoMemory : os_allocator.handle->reallocate(out_mem, new_size);
+  }
+
+  virtual void deallocate(memory_handle mem) override
+  {
+    os_allocator.handle->deallocate(mem);
+  }
+
+  bool fail = false;
+};
+
+}        // namespace
+
+TEST(ClockCacheTest, Basic)
+{
+  ClockCache<int, int, Hash<int>, 1> cache{os_allocator, 4};
+
+  EXPECT_EQ(cache.get(1), None);
+
+  for (int i = 0; i < 4; i++)
+  {
+    cache.insert(int{i}, rc::make(os_allocator, int{i * 10}).unwrap(), 1).unwrap();
+  }
+
+  EXPECT_EQ(*cache.get(2).unwrap().handle, 20);
+
+  CacheStats stats = cache.stats();
+  EXPECT_EQ(stats.entries, 4);
+  EXPECT_EQ(stats.bytes, 4);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.evictions, 0);
+
+  // 2 was referenced, so the clock skips it and evicts 0
+  cache.insert(4, rc::make(os_allocator, 40).unwrap(), 1).unwrap();
+
+  EXPECT_EQ(cache.get(0), None);
+  EXPECT_TRUE(cache.get(2).is_some());
+  EXPECT_TRUE(cache.get(4).is_some());
+  EXPECT_EQ(cache.stats().evictions, 1);
+
+  // evicts as many entries as needed
+  cache.insert(5, rc::make(os_allocator, 50).unwrap(), 3).unwrap();
+  EXPECT_EQ(*cache.get(5).unwrap().handle, 50);
+  EXPECT_EQ(cache.stats().bytes, 4);
+  EXPECT_LE(cache.stats().entries, 2);
+
+  // replacing a value recharges its bytes
+  cache.insert(5, rc::make(os_allocator, 51).unwrap(), 1).unwrap();
+  EXPECT_EQ(*cache.get(5).unwrap().handle, 51);
+
+  // too large to be cached
+  cache.insert(6, rc::make(os_allocator, 60).unwrap(), 5).unwrap();
+  EXPECT_EQ(cache.get(6), None);
+
+  EXPECT_TRUE(cache.erase(5));
+  EXPECT_FALSE(cache.erase(5));
+
+  cache.clear();
+  EXPECT_EQ(cache.stats().entries, 0);
+  EXPECT_EQ(cache.stats().bytes, 0);
+}
+
+TEST(ClockCacheTest, AllocationFailure)
+{
+  FailingAllocatorHandle handle;
+  Allocator              allocator{handle};
+
+  ClockCache<int, int, Hash<int>, 1> cache{allocator, 1000};
+
+  cache.insert(1, rc::make(os_allocator, 10).unwrap(), 1).unwrap();
+
+  handle.fail = true;
+
+  // the first failing insertion of a new key leaves the cache unchanged
+  Result<Void, AllocError> result = Ok(Void{});
+
+  for (int key = 2; key < 1000 && result.is_ok(); key++)
+  {
+    result = cache.insert(int{key}, rc::make(os_allocator, int{key}).unwrap(), 1);
+  }
+
+  EXPECT_EQ(result, Err(AllocError::NoMemory));
+  EXPECT_EQ(*cache.get(1).unwrap().handle, 10);
+
+  // replacing doesn't allocate
+  cache.insert(1, rc::make(os_allocator, 11).unwrap(), 2).unwrap();
+  EXPECT_EQ(*cache.get(1).unwrap().handle, 11);
+
+  handle.fail = false;
+
+  // a value over the budget removes the outdated one
+  cache.insert(1, rc::make(os_allocator, 12).unwrap(), 2000).unwrap();
+  EXPECT_EQ(cache.get(1), None);
+}
+
+TEST(ClockCacheTest, EvictedValuesStayAlive)
+{
+  ClockCache<std::string_view, int, Hash<std::string_view>, 1> cache{os_allocator, 1};
+
+  cache.insert("a", rc::make(os_allocator, 1).unwrap(), 1).unwrap();
+
+  Rc<int *> a = cache.get("a").unwrap();
+
+  cache.insert("b", rc::make(os_allocator, 2).unwrap(), 1).unwrap();
+
+  EXPECT_EQ(cache.get("a"), None);
+  EXPECT_EQ(*a.handle, 1);
+}
+
+TEST(ClockCacheTest, Threads)
+{
+  constexpr int NUM_THREADS = 4;
+  constexpr int NUM_KEYS    = 512;
+
+  ClockCache<int, int> cache{os_allocator, 256 * 16};
+
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < NUM_THREADS; t++)
+  {
+    threads.emplace_back([&cache] {
+      for (int key = 0; key < NUM_KEYS; key++)
+      {
+        Option<Rc<int *>> value = cache.get(key);
+
+        if (value.is_some())
+        {
+          EXPECT_EQ(*value.value().handle, key);
+        }
+        else
+        {
+          cache.insert(int{key}, rc::make(os_allocator, int{key}).unwrap(), 16).unwrap();
+        }
+      }
+    });
+  }
+
+  for (std::thread &thread : threads)
+  {
+    thread.join();
+  }
+
+  CacheStats stats = cache.stats();
+
+  EXPECT_EQ(stats.hits + stats.misses, NUM_THREADS * NUM_KEYS);
+  EXPECT_LE(stats.bytes, 256 * 16);
+}
@@ -0,0 +1,95 @@
+#include "stx/concurrent_hash_map.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(ConcurrentHashMapTest, Basic)
+{
+  ConcurrentHashMap<int, int> map{os_allocator};
+
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.get(1), None);
+
+  for (int i = 0; i < 1000; i++)
+  {
+    map.insert_or_assign(int{i}, i * 2).unwrap();
+  }
+
+  EXPECT_EQ(map.size(), 1000);
+  EXPECT_EQ(map.get(10), Some(20));
+  EXPECT_TRUE(map.contains(999));
+
+  map.insert_or_assign(10, -1).unwrap();
+  EXPECT_EQ(map.get(10), Some(-1));
+  EXPECT_EQ(map.size(), 1000);
+
+  EXPECT_EQ(map.erase(10), Some(-1));
+  EXPECT_EQ(map.erase(10), None);
+  EXPECT_FALSE(map.contains(10));
+
+  map.compute(11, [](Option<int> value) -> Option<int> { return Some(std::move(value).unwrap() + 1); }).unwrap();
+  EXPECT_EQ(map.get(11), Some(23));
+
+  map.compute(11, [](Option<int>) -> Option<int> { return None; }).unwrap();
+  EXPECT_FALSE(map.contains(11));
+
+  map.compute(5000, [](Option<int> value) -> Option<int> {
+       EXPECT_EQ(value, None);
+       return Some(7);
+     })
+      .unwrap();
+  EXPECT_EQ(map.get(5000), Some(7));
+
+  map.clear();
+  EXPECT_EQ(map.size(), 0);
+}
+
+TEST(ConcurrentHashMapTest, AllocFailure)
+{
+  ConcurrentHashMap<int, int, Hash<int>, 4> map{noop_allocator};
+
+  EXPECT_EQ(map.insert_or_assign(1, 1).unwrap_err(), AllocError::NoMemory);
+  EXPECT_EQ(map.compute(1, [](Option<int>) -> Option<int> { return Some(1); }).unwrap_err(), AllocError::NoMemory);
+  EXPECT_EQ(map.size(), 0);
+}
+
+TEST(ConcurrentHashMapTest, Threads)
+{
+  constexpr int NUM_THREADS = 4;
+  constexpr int NUM_KEYS    = 256;
+  constexpr int NUM_ROUNDS  = 100;
+
+  ConcurrentHashMap<int, int> map{os_allocator};
+
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < NUM_THREADS; t++)
+  {
+    threads.emplace_back([&map] {
+      for (int round = 0; round < NUM_ROUNDS; round++)
+      {
+        for (int key = 0; key < NUM_KEYS; key++)
+        {
+          map.compute(int{key}, [](Option<int> value) -> Option<int> { return Some(std::move(value).unwrap_or(0) + 1); }).unwrap();
+        }
+      }
+    });
+  }
+
+  for (std::thread &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(map.size(), NUM_KEYS);
+
+  for (int key = 0; key < NUM_KEYS; key++)
+  {
+    EXPECT_EQ(map.get(key), Some(NUM_THREADS * NUM_ROUNDS));
+  }
+}
@@ -0,0 +1,72 @@
+#include "stx/eytzinger.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(EytzingerTest, LowerBound)
+{
+  for (int n : {0, 1, 2, 3, 7, 8, 100, 1023, 1024, 5000})
+  {
+    std::vector<int> sorted;
+
+    for (int i = 0; i < n; i++)
+    {
+      sorted.push_back(i * 2);
+    }
+
+    EytzingerVec<int> layout = eytzinger::make<int>(os_allocator, Span<int const>{sorted}).unwrap();
+
+    EXPECT_EQ(layout.size(), static_cast<size_t>(n));
+
+    for (int value = -1; value <= n * 2; value++)
+    {
+      auto expected = std::lower_bound(sorted.begin(), sorted.end(), value);
+
+      Option<Ref<int const>> bound = layout.lower_bound(value);
+
+      if (expected == sorted.end())
+      {
+        EXPECT_EQ(bound, None);
+      }
+      else
+      {
+        EXPECT_EQ(bound.value().get(), *expected);
+      }
+
+      EXPECT_EQ(layout.contains(value), value >= 0 && value < n * 2 && value % 2 == 0);
+    }
+  }
+}
+
+TEST(EytzingerTest, Layout)
+{
+  int const sorted[] = {1, 2, 3, 4, 5, 6, 7};
+
+  EytzingerVec<int> layout = eytzinger::make<int>(os_allocator, Span<int const>{sorted}).unwrap();
+
+  int const expected[] = {4, 2, 6, 1, 3, 5, 7};
+
+  EXPECT_TRUE(layout.span().equals(Span<int const>{expected}));
+}
+
+TEST(EytzingerTest, NodesPerCacheLine)
+{
+  // whole levels of the subtree even if the cache line fits more nodes
+  struct Node12
+  {
+    uint32_t a, b, c;
+  };
+
+  struct Node24
+  {
+    uint64_t a, b, c;
+  };
+
+  EXPECT_EQ(EytzingerVec<uint32_t>::NODES_PER_CACHE_LINE, 16);
+  EXPECT_EQ(EytzingerVec<Node12>::NODES_PER_CACHE_LINE, 4);
+  EXPECT_EQ(EytzingerVec<Node24>::NODES_PER_CACHE_LINE, 2);
+}
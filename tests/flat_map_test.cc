@@ -0,0 +1,67 @@
+#include "stx/flat_map.h"
+
+#include "stx/rc.h"
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(FlatMapTest, InsertGetRemove)
+{
+  FlatMap<int, int> map{os_allocator};
+
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_EQ(map.get(1), None);
+
+  for (int key : {5, 1, 9, 3, 7})
+  {
+    map.insert(int{key}, key * 10).unwrap();
+  }
+
+  EXPECT_EQ(map.size(), 5);
+  EXPECT_TRUE(map.keys().is_sorted());
+  EXPECT_EQ(map.get(9).value().get(), 90);
+  EXPECT_EQ(map.values()[0], 10);
+  EXPECT_EQ(map.values()[4], 90);
+
+  map.insert(3, 300).unwrap();
+  EXPECT_EQ(map.size(), 5);
+  EXPECT_EQ(map.get(3).value().get(), 300);
+
+  EXPECT_EQ(map.remove(5), Some(50));
+  EXPECT_EQ(map.remove(5), None);
+  EXPECT_FALSE(map.contains(5));
+  EXPECT_EQ(map.size(), 4);
+  EXPECT_EQ(map.find(7), Some<size_t>(2));
+  EXPECT_EQ(map.find(2), None);
+
+  map.clear();
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(FlatMapTest, Lifetime)
+{
+  FlatMap<int, Rc<int *>> map{os_allocator};
+
+  for (int i = 100; i > 0; i--)
+  {
+    map.insert(int{i}, rc::make(os_allocator, int{i}).unwrap()).unwrap();
+  }
+
+  EXPECT_EQ(map.size(), 100);
+
+  for (int i = 1; i <= 100; i++)
+  {
+    EXPECT_EQ(*map.get(i).value().get(), i);
+  }
+
+  EXPECT_EQ(*map.remove(50).unwrap(), 50);
+  EXPECT_EQ(*map.values()[49], 51);
+}
+
+TEST(FlatMapTest, AllocationFailure)
+{
+  FlatMap<int, int> map{noop_allocator};
+
+  EXPECT_EQ(map.insert(1, 1), Err(AllocError::NoMemory));
+  EXPECT_TRUE(map.is_empty());
+}
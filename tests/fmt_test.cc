@@ -0,0 +1,75 @@
+#include "stx/fmt.h"
+
+#include <cinttypes>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+namespace
+{
+
+template <typename... Args>
+std::string format(Args const &...args)
+{
+  char         buffer[256];
+  size_t const size = fmt::format_to(buffer, args...);
+  EXPECT_EQ(size, fmt::formatted_size(args...));
+  return std::string{buffer, size};
+}
+
+}        // namespace
+
+TEST(FmtTest, Integers)
+{
+  EXPECT_EQ(format(0), "0");
+  EXPECT_EQ(format(7), "7");
+  EXPECT_EQ(format(42), "42");
+  EXPECT_EQ(format(-305), "-305");
+  EXPECT_EQ(format(int8_t{-128}), "-128");
+  EXPECT_EQ(format(uint8_t{255}), "255");
+  EXPECT_EQ(format(std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+  EXPECT_EQ(format(std::numeric_limits<uint64_t>::max()), "18446744073709551615");
+
+  for (uint64_t value : {uint64_t{9}, uint64_t{10}, uint64_t{99}, uint64_t{100}, uint64_t{1000001}, uint64_t{123456789012}})
+  {
+    EXPECT_EQ(format(value), std::to_string(value));
+  }
+}
+
+TEST(FmtTest, Floats)
+{
+  EXPECT_EQ(format(0.5), "0.5");
+  EXPECT_EQ(format(-2.25f), "-2.25");
+  EXPECT_EQ(format(0.1), "0.1");
+  EXPECT_EQ(format(1e100), "1e+100");
+  EXPECT_EQ(format(std::numeric_limits<double>::lowest()), "-1.7976931348623157e+308");
+  EXPECT_EQ(format(std::numeric_limits<double>::infinity()), "inf");
+}
+
+TEST(FmtTest, Others)
+{
+  EXPECT_EQ(format(fmt::hex(0x28e7u)), "28e7");
+  EXPECT_EQ(format(fmt::hex(0)), "0");
+  EXPECT_EQ(format(fmt::hex(int8_t{-1})), "ff");
+  EXPECT_EQ(format(fmt::hex(std::numeric_limits<uint64_t>::max())), "ffffffffffffffff");
+  EXPECT_EQ(format(reinterpret_cast<int *>(0x1000)), "0x1000");
+  EXPECT_EQ(format(true, ' ', false), "true false");
+  EXPECT_EQ(format("task ", std::string{"decode"}, std::string_view{" took "}, 12, "ms"), "task decode took 12ms");
+  EXPECT_EQ(format(), "");
+}
+
+TEST(FmtTest, Truncation)
+{
+  char buffer[8];
+
+  EXPECT_EQ(fmt::format_to(buffer, "id=", 123456789), 8);
+  EXPECT_EQ(std::string_view(buffer, 8), "id=12345");
+
+  EXPECT_EQ(fmt::format_to(Span<char>{buffer, 0}, "abc"), 0);
+  EXPECT_EQ(fmt::format_to_n(buffer, 2, 'a', 'b', 'c'), 2);
+  EXPECT_EQ(fmt::formatted_size("id=", 123456789), 12);
+}
@@ -0,0 +1,98 @@
+#include "stx/fs.h"
+
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+namespace
+{
+
+std::string write_temp_file(char const *name, std::string const &contents)
+{
+  std::string path = testing::TempDir() + name;
+
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  EXPECT_NE(file, nullptr);
+  EXPECT_EQ(std::fwrite(contents.data(), 1, contents.size(), file), contents.size());
+  std::fclose(file);
+
+  return path;
+}
+
+}        // namespace
+
+TEST(FsTest, MapReadOnly)
+{
+  std::string contents;
+
+  for (int i = 0; i < 1000; i++)
+  {
+    contents += "record " + std::to_string(i) + "\n";
+  }
+
+  std::string path = write_temp_file("stx_fs_map_readonly", contents);
+
+  MappedFile file = fs::map_readonly(path.c_str(), MemoryAdvice::Sequential).unwrap();
+
+  EXPECT_EQ(file.size(), contents.size());
+  EXPECT_EQ(file.view(), contents);
+  EXPECT_EQ(file.span().size(), contents.size());
+  EXPECT_EQ(file.span()[7], static_cast<uint8_t>('0'));
+  EXPECT_TRUE(file.advise(MemoryAdvice::Random).is_ok());
+
+  // the string takes over the mapping
+  uint8_t const *data = file.data();
+  String         str  = std::move(file).to_string();
+
+  EXPECT_EQ(static_cast<void const *>(str.data()), static_cast<void const *>(data));
+  EXPECT_EQ(str.view(), contents);
+
+  std::remove(path.c_str());
+}
+
+TEST(FsTest, NullTerminated)
+{
+  // a file ending at a page boundary is still followed by a null-terminator
+  for (size_t size : {size_t{4096}, size_t{16384}, size_t{65536}})
+  {
+    std::string contents(size, 'x');
+    std::string path = write_temp_file("stx_fs_null_terminated", contents);
+
+    MappedFile file = fs::map_readonly(path.c_str()).unwrap();
+
+    EXPECT_EQ(file.view(), contents);
+    EXPECT_EQ(file.data()[size], 0);
+
+    std::remove(path.c_str());
+  }
+}
+
+TEST(FsTest, SmallAndEmpty)
+{
+  std::string path = write_temp_file("stx_fs_small", "abc");
+
+  EXPECT_EQ(fs::map_readonly(path.c_str()).unwrap().to_string(), "abc");
+
+  std::remove(path.c_str());
+
+  path = write_temp_file("stx_fs_empty", "");
+
+  MappedFile empty = fs::map_readonly(path.c_str()).unwrap();
+
+  EXPECT_TRUE(empty.is_empty());
+  EXPECT_TRUE(empty.span().is_empty());
+  EXPECT_TRUE(empty.advise(MemoryAdvice::WillNeed).is_ok());
+
+  std::remove(path.c_str());
+}
+
+TEST(FsTest, Errors)
+{
+  std::string missing = testing::TempDir() + "stx_fs_missing/file";
+
+  EXPECT_EQ(fs::map_readonly(missing.c_str()).unwrap_err(), IoError::NotFound);
+  EXPECT_EQ(fs::map_readonly(testing::TempDir().c_str()).unwrap_err(), IoError::NotRegularFile);
+}
@@ -0,0 +1,154 @@
+#include "stx/hash_map.h"
+
+#include <string>
+#include <string_view>
+
+#include "stx/rc.h"
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(HashMapTest, InsertGetRemove)
+{
+  HashMap<int, int> map{os_allocator};
+
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(map.get(1), None);
+
+  map.insert(1, 10).unwrap();
+  map.insert(2, 20).unwrap();
+  map.insert(3, 30).unwrap();
+
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_TRUE(map.contains(2));
+  EXPECT_EQ(map.get(2).value().get(), 20);
+
+  // assigns the value of the existing entry
+  map.insert(2, 200).unwrap();
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.get(2).value().get(), 200);
+
+  EXPECT_EQ(map.remove(2), Some(200));
+  EXPECT_EQ(map.remove(2), None);
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.size(), 2);
+
+  map.clear();
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(1));
+}
+
+TEST(HashMapTest, Growth)
+{
+  HashMap<uint64_t, uint64_t> map{os_allocator};
+
+  for (uint64_t i = 0; i < 10000; i++)
+  {
+    map.insert(uint64_t{i}, i * 2).unwrap();
+  }
+
+  EXPECT_EQ(map.size(), 10000);
+
+  for (uint64_t i = 0; i < 10000; i++)
+  {
+    EXPECT_EQ(map.get(i).value().get(), i * 2);
+  }
+
+  // leaves deleted slots that must be purged or reused by the insertions
+  for (uint64_t i = 0; i < 10000; i += 2)
+  {
+    EXPECT_TRUE(map.remove(i).is_some());
+  }
+
+  size_t const capacity = map.capacity();
+
+  for (uint64_t i = 0; i < 10000; i += 2)
+  {
+    map.insert(uint64_t{i}, i * 3).unwrap();
+  }
+
+  EXPECT_EQ(map.capacity(), capacity);
+
+  for (uint64_t i = 0; i < 10000; i++)
+  {
+    EXPECT_EQ(map.get(i).value().get(), i % 2 == 0 ? i * 3 : i * 2);
+  }
+
+  size_t num_iterated = 0;
+  uint64_t sum        = 0;
+
+  for (HashMapEntry<uint64_t, uint64_t> const &entry : map)
+  {
+    num_iterated++;
+    sum += entry.key;
+  }
+
+  EXPECT_EQ(num_iterated, 10000);
+  EXPECT_EQ(sum, 9999ULL * 10000 / 2);
+}
+
+TEST(HashMapTest, Reserve)
+{
+  HashMap<int, int> map{os_allocator};
+
+  map.reserve(100).unwrap();
+
+  size_t const capacity = map.capacity();
+
+  EXPECT_GE(capacity, 100);
+
+  for (int i = 0; i < 100; i++)
+  {
+    map.insert(int{i}, int{i}).unwrap();
+  }
+
+  EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(HashMapTest, Lifetime)
+{
+  {
+    HashMap<std::string_view, Rc<int *>> map{os_allocator};
+
+    static std::string const keys[] = {"a", "b", "c", "d"};
+
+    for (int i = 0; i < 100; i++)
+    {
+      map.insert(std::string_view{keys[i % 4]}, rc::make(os_allocator, int{i}).unwrap()).unwrap();
+    }
+
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(*map.get("a").value().get(), 96);
+    EXPECT_EQ(*map.get("d").value().get(), 99);
+
+    EXPECT_EQ(*map.remove("a").unwrap(), 96);
+    EXPECT_EQ(map.get("a"), None);
+  }
+}
+
+TEST(HashMapTest, AllocationFailure)
+{
+  HashMap<int, int> map{noop_allocator};
+
+  EXPECT_EQ(map.insert(1, 1), Err(AllocError::NoMemory));
+  EXPECT_EQ(map.reserve(10), Err(AllocError::NoMemory));
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(HashSetTest, InsertContainsRemove)
+{
+  HashSet<std::string_view> set{os_allocator};
+
+  set.insert("hello").unwrap();
+  set.insert("world").unwrap();
+  set.insert("hello").unwrap();
+
+  EXPECT_EQ(set.size(), 2);
+  EXPECT_TRUE(set.contains("hello"));
+  EXPECT_FALSE(set.contains("stx"));
+
+  EXPECT_TRUE(set.remove("hello"));
+  EXPECT_FALSE(set.remove("hello"));
+  EXPECT_EQ(set.size(), 1);
+}
@@ -0,0 +1,183 @@
+#include "stx/hash.h"
+
+#include <string>
+#include <string_view>
+
+#include "stx/c_string_view.h"
+#include "stx/hash_map.h"
+#include "stx/string.h"
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+namespace
+{
+
+struct Point
+{
+  uint32_t x = 0;
+  uint32_t y = 0;
+
+  bool operator==(Point const &other) const
+  {
+    return x == other.x && y == other.y;
+  }
+};
+
+constexpr HashValue LOG_KEY = hash::string("log");
+
+// padding-free but holds a view, so it must be hashed by what it refers to
+struct Tag
+{
+  std::string_view name;
+
+  bool operator==(Tag const &other) const
+  {
+    return name == other.name;
+  }
+};
+
+}        // namespace
+
+template <>
+struct stx::is_bytewise_hashable<Point> : std::true_type
+{};
+
+template <>
+struct stx::Hash<Tag, void>
+{
+  HashValue operator()(Tag const &tag) const
+  {
+    return hash::string(tag.name);
+  }
+};
+
+TEST(HashTest, Bytes)
+{
+  std::string str(300, 'a');
+
+  // every length up to a few 48-byte blocks takes a different path
+  for (size_t size = 0; size < str.size(); size++)
+  {
+    EXPECT_EQ(hash::bytes(str.data(), size), hash::string(std::string_view{str.data(), size}));
+    EXPECT_NE(hash::bytes(str.data(), size), hash::bytes(str.data(), size + 1));
+    EXPECT_NE(hash::bytes(str.data(), size), hash::bytes(str.data(), size, 1));
+  }
+
+  std::string other = str;
+  other[150]        = 'b';
+
+  EXPECT_NE(hash::string(str), hash::string(other));
+}
+
+TEST(HashTest, ConstantEvaluation)
+{
+  static_assert(hash::string("log") == LOG_KEY);
+  static_assert(hash::string("log") != hash::string("logs"));
+  static_assert(hash::integer(1) != hash::integer(2));
+  static_assert(Hasher{}.write_str("a").write_integer(1).finish() != Hasher{}.write_integer(1).write_str("a").finish());
+
+  std::string log = "log";
+
+  EXPECT_EQ(hash::string(log), LOG_KEY);
+  EXPECT_EQ(Hash<std::string_view>{}(log), LOG_KEY);
+
+  std::string long_key(100, 'k');
+  EXPECT_EQ(hash::bytes(long_key.data(), long_key.size()), hash::string(long_key));
+}
+
+TEST(HashTest, Integer)
+{
+  EXPECT_NE(hash::integer(0), hash::integer(1));
+  EXPECT_NE(Hash<int>{}(1), Hash<int>{}(2));
+
+  // adjacent keys differ in the high bits too, which select the hash map groups
+  EXPECT_NE(hash::integer(1) >> 57, hash::integer(2) >> 57);
+}
+
+TEST(HashTest, Span)
+{
+  uint8_t bytes[]        = {1, 2, 3, 4, 5};
+  float   floats[]       = {1.0F, 2.0F};
+  float   zeros[]        = {0.0F, 0.0F};
+  float   signed_zeros[] = {-0.0F, 0.0F};
+
+  EXPECT_EQ(Hash<Span<uint8_t>>{}(bytes), hash::bytes(bytes, sizeof(bytes)));
+  EXPECT_EQ(Hash<Span<uint8_t>>{}(bytes), Hash<Span<uint8_t const>>{}(bytes));
+  EXPECT_NE(Hash<Span<uint8_t>>{}(Span<uint8_t>{bytes}.slice(0, 4)), Hash<Span<uint8_t>>{}(bytes));
+
+  // floats are hashed element-wise rather than as bytes, so equal spans hash
+  // equal even if their bytes differ
+  EXPECT_EQ(Hash<Span<float>>{}(zeros), Hash<Span<float>>{}(signed_zeros));
+  EXPECT_NE(Hash<Span<float>>{}(floats), Hash<Span<float>>{}(Span<float>{floats}.slice(0, 1)));
+}
+
+TEST(HashTest, Struct)
+{
+  EXPECT_EQ(Hash<Point>{}(Point{1, 2}), Hash<Point>{}(Point{1, 2}));
+  EXPECT_NE(Hash<Point>{}(Point{1, 2}), Hash<Point>{}(Point{2, 1}));
+
+  HashMap<Point, int> map{os_allocator};
+
+  map.insert(Point{1, 2}, 12).unwrap();
+  map.insert(Point{2, 1}, 21).unwrap();
+
+  EXPECT_EQ(map.get(Point{1, 2}).value().get(), 12);
+  EXPECT_EQ(map.get(Point{2, 1}).value().get(), 21);
+  EXPECT_FALSE(map.contains(Point{2, 2}));
+}
+
+TEST(HashTest, Views)
+{
+  char first[]  = "key";
+  char second[] = "key";
+
+  // the byte hash is opt-in, views are hashed by their contents
+  static_assert(std::has_unique_object_representations_v<CStringView>);
+  static_assert(!is_bytewise_hashable<CStringView>::value);
+  static_assert(!is_bytewise_hashable<Tag>::value);
+
+  EXPECT_EQ(Hash<CStringView>{}(CStringView{first, 3}), Hash<CStringView>{}(CStringView{second, 3}));
+  EXPECT_EQ(Hash<CStringView>{}(CStringView{first, 3}), hash::string("key"));
+
+  HashMap<CStringView, int> views{os_allocator};
+
+  views.insert(CStringView{first, 3}, 1).unwrap();
+
+  EXPECT_EQ(views.get(CStringView{second, 3}).value().get(), 1);
+
+  Tag tags[] = {{std::string_view{first, 3}}, {std::string_view{second, 3}}};
+
+  EXPECT_EQ(Hash<Span<Tag>>{}(Span<Tag>{tags}.slice(0, 1)), Hash<Span<Tag>>{}(Span<Tag>{tags}.slice(1, 1)));
+}
+
+TEST(HashTest, String)
+{
+  String str = string::make(os_allocator, "image decoder").unwrap();
+
+  EXPECT_EQ(Hash<String>{}(str), hash::string("image decoder"));
+
+  HashMap<String, int> map{os_allocator};
+
+  map.insert(std::move(str), 1).unwrap();
+  map.insert(string::make(os_allocator, "thumbnail").unwrap(), 2).unwrap();
+
+  EXPECT_EQ(map.get(string::make(os_allocator, "image decoder").unwrap()).value().get(), 1);
+  EXPECT_EQ(map.get(string::make(os_allocator, "thumbnail").unwrap()).value().get(), 2);
+}
+
+TEST(HashTest, Hasher)
+{
+  HashValue ab_c = Hasher{}.write_str("ab").write_str("c").finish();
+  HashValue abc  = Hasher{}.write_str("abc").finish();
+  HashValue c_ab = Hasher{}.write_str("c").write_str("ab").finish();
+
+  EXPECT_NE(ab_c, abc);
+  EXPECT_NE(ab_c, c_ab);
+  EXPECT_EQ(ab_c, Hasher{}.write_str("ab").write_str("c").finish());
+  EXPECT_NE(Hasher{}.write_integer(1).finish(), Hasher{1}.write_integer(1).finish());
+
+  Point point{3, 4};
+  EXPECT_EQ(Hasher{}.write(point).finish(), Hasher{}.write_integer(Hash<Point>{}(point)).finish());
+  EXPECT_EQ(Hasher{}.write_bytes("abc", 3).finish(), Hasher{}.write_str("abc").finish());
+}
@@ -0,0 +1,236 @@
+#include "stx/intrusive_list.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+struct Node
+{
+  int             value = 0;
+  SListHook<Node> slist_hook;
+  ListHook<Node>  list_hook;
+};
+
+TEST(IntrusiveSListTest, Basic)
+{
+  Node nodes[4]{{0, {}, {}}, {1, {}, {}}, {2, {}, {}}, {3, {}, {}}};
+
+  IntrusiveSList<Node, &Node::slist_hook> list;
+
+  EXPECT_TRUE(list.is_empty());
+  EXPECT_EQ(list.pop_front(), None);
+
+  list.push_back(nodes[1]);
+  list.push_back(nodes[2]);
+  list.push_front(nodes[0]);
+
+  int expected = 0;
+  for (Node &node : list)
+  {
+    EXPECT_EQ(node.value, expected++);
+  }
+  EXPECT_EQ(expected, 3);
+
+  EXPECT_EQ(list.back().value().get().value, 2);
+
+  IntrusiveSList<Node, &Node::slist_hook> other;
+  other.push_back(nodes[3]);
+  list.append(std::move(other));
+
+  EXPECT_TRUE(other.is_empty());
+
+  for (int i = 0; i < 4; i++)
+  {
+    EXPECT_EQ(list.pop_front().value().get().value, i);
+  }
+
+  EXPECT_TRUE(list.is_empty());
+  EXPECT_EQ(list.back(), None);
+}
+
+TEST(IntrusiveListTest, Basic)
+{
+  Node nodes[5]{{0, {}, {}}, {1, {}, {}}, {2, {}, {}}, {3, {}, {}}, {4, {}, {}}};
+
+  IntrusiveList<Node, &Node::list_hook> list;
+
+  list.push_back(nodes[1]);
+  list.push_back(nodes[3]);
+  list.push_front(nodes[0]);
+  list.insert_before(nodes[3], nodes[2]);
+  list.push_back(nodes[4]);
+
+  int expected = 0;
+  for (Node &node : list)
+  {
+    EXPECT_EQ(node.value, expected++);
+  }
+  EXPECT_EQ(expected, 5);
+
+  list.remove(nodes[2]);
+  list.remove(nodes[0]);
+  list.remove(nodes[4]);
+
+  EXPECT_EQ(list.front().value().get().value, 1);
+  EXPECT_EQ(list.back().value().get().value, 3);
+  EXPECT_EQ(list.pop_back().value().get().value, 3);
+  EXPECT_EQ(list.pop_front().value().get().value, 1);
+  EXPECT_TRUE(list.is_empty());
+  EXPECT_EQ(list.pop_back(), None);
+}
+
+TEST(TreiberStackTest, Basic)
+{
+  Node nodes[3]{{0, {}, {}}, {1, {}, {}}, {2, {}, {}}};
+
+  TreiberStack<Node, &Node::slist_hook> stack;
+
+  EXPECT_EQ(stack.pop(), None);
+
+  for (Node &node : nodes)
+  {
+    stack.push(node);
+  }
+
+  EXPECT_EQ(stack.pop().value().get().value, 2);
+
+  IntrusiveSList<Node, &Node::slist_hook> all = stack.pop_all();
+
+  EXPECT_TRUE(stack.is_empty());
+  EXPECT_EQ(all.pop_front().value().get().value, 0);
+  EXPECT_EQ(all.pop_front().value().get().value, 1);
+  EXPECT_TRUE(all.is_empty());
+}
+
+TEST(TreiberStackTest, Threads)
+{
+  constexpr int NUM_PRODUCERS = 4;
+  constexpr int NUM_CONSUMERS = 2;
+  constexpr int NUM_ITEMS     = 1000;
+  constexpr int TOTAL         = NUM_PRODUCERS * NUM_ITEMS;
+
+  std::vector<Node> nodes;
+  nodes.resize(TOTAL);
+
+  TreiberStack<Node, &Node::slist_hook> stack;
+
+  std::vector<std::thread> threads;
+
+  for (int p = 0; p < NUM_PRODUCERS; p++)
+  {
+    threads.emplace_back([&nodes, &stack, p] {
+      for (int i = 0; i < NUM_ITEMS; i++)
+      {
+        stack.push(nodes[p * NUM_ITEMS + i]);
+      }
+    });
+  }
+
+  // the consumers run on different threads, one at a time. one pops nodes
+  // individually and the other takes them all at once.
+  std::mutex       consumer_lock;
+  std::vector<int> times_popped(TOTAL, 0);
+  int              popped = 0;
+
+  for (int c = 0; c < NUM_CONSUMERS; c++)
+  {
+    threads.emplace_back([&, c] {
+      while (true)
+      {
+        std::lock_guard<std::mutex> guard{consumer_lock};
+
+        if (popped == TOTAL)
+        {
+          return;
+        }
+
+        if (c == 0)
+        {
+          Option<Ref<Node>> node = stack.pop();
+
+          if (node.is_some())
+          {
+            times_popped[&node.value().get() - nodes.data()]++;
+            popped++;
+          }
+        }
+        else
+        {
+          IntrusiveSList<Node, &Node::slist_hook> all = stack.pop_all();
+
+          for (Node &node : all)
+          {
+            times_popped[&node - nodes.data()]++;
+            popped++;
+          }
+        }
+      }
+    });
+  }
+
+  for (std::thread &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_TRUE(stack.is_empty());
+
+  for (int count : times_popped)
+  {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+TEST(MpscQueueTest, Threads)
+{
+  constexpr int NUM_PRODUCERS = 4;
+  constexpr int NUM_ITEMS     = 1000;
+
+  std::vector<Node> nodes;
+  nodes.resize(NUM_PRODUCERS * NUM_ITEMS);
+
+  MpscQueue<Node, &Node::slist_hook> queue;
+
+  std::vector<std::thread> producers;
+
+  for (int p = 0; p < NUM_PRODUCERS; p++)
+  {
+    producers.emplace_back([&nodes, &queue, p] {
+      for (int i = 0; i < NUM_ITEMS; i++)
+      {
+        Node &node = nodes[p * NUM_ITEMS + i];
+        node.value = i;
+        queue.push(node);
+      }
+    });
+  }
+
+  // items of each producer are popped in the order they were pushed
+  int last[NUM_PRODUCERS]{-1, -1, -1, -1};
+  int popped = 0;
+
+  while (popped < NUM_PRODUCERS * NUM_ITEMS)
+  {
+    Option<Ref<Node>> node = queue.pop();
+
+    if (node.is_some())
+    {
+      Node     &n        = node.value().get();
+      int const producer = static_cast<int>(&n - nodes.data()) / NUM_ITEMS;
+      EXPECT_EQ(n.value, last[producer] + 1);
+      last[producer] = n.value;
+      popped++;
+    }
+  }
+
+  for (std::thread &producer : producers)
+  {
+    producer.join();
+  }
+
+  EXPECT_TRUE(queue.is_empty());
+}
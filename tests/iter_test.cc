@@ -0,0 +1,103 @@
+#include "stx/iter.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(IterTest, FilterMapTakeCollect)
+{
+  int       x[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  Span<int> s   = x;
+
+  Vec<int> squares = s.iter()
+                         .filter([](int a) { return a % 2 == 0; })
+                         .map([](int a) { return a * a; })
+                         .take(3)
+                         .collect(os_allocator)
+                         .unwrap();
+
+  EXPECT_EQ(squares.size(), 3);
+  EXPECT_EQ(squares[0], 4);
+  EXPECT_EQ(squares[1], 16);
+  EXPECT_EQ(squares[2], 36);
+
+  EXPECT_EQ(s.iter().take(0).count(), 0);
+  EXPECT_EQ(s.iter().take(20).count(), 10);
+  EXPECT_EQ(s.iter().fold(0, [](int acc, int a) { return acc + a; }), 55);
+
+  // the items are references to the elements
+  s.iter().filter([](int a) { return a > 5; }).for_each([](int &a) { a = 0; });
+  EXPECT_EQ(s.iter().fold(0, [](int acc, int a) { return acc + a; }), 15);
+}
+
+TEST(IterTest, EnumerateZip)
+{
+  int       x[] = {10, 20, 30};
+  float     y[] = {0.5f, 1.5f};
+  Span<int> s   = x;
+
+  size_t count = 0;
+
+  s.iter().enumerate().for_each([&count](std::pair<size_t, int &> item) {
+    EXPECT_EQ(item.second, static_cast<int>((item.first + 1) * 10));
+    count++;
+  });
+
+  EXPECT_EQ(count, 3);
+
+  Vec<float> products = s.iter()
+                            .zip(Span<float>{y})
+                            .map([](std::pair<int &, float &> item) { return static_cast<float>(item.first) * item.second; })
+                            .collect(os_allocator)
+                            .unwrap();
+
+  EXPECT_EQ(products.size(), 2);
+  EXPECT_EQ(products[0], 5.0f);
+  EXPECT_EQ(products[1], 30.0f);
+
+  Vec<std::pair<size_t, int>> enumerated = s.iter().map([](int a) { return a + 1; }).enumerate().collect(os_allocator).unwrap();
+
+  EXPECT_EQ(enumerated[2].first, 2);
+  EXPECT_EQ(enumerated[2].second, 31);
+}
+
+TEST(IterTest, ChunksWindows)
+{
+  int       x[] = {1, 2, 3, 4, 5, 6, 7};
+  Span<int> s   = x;
+
+  Vec<int> chunk_sums = s.chunks(3).map([](Span<int> chunk) { return chunk.iter().fold(0, [](int acc, int a) { return acc + a; }); }).collect(os_allocator).unwrap();
+
+  EXPECT_EQ(chunk_sums.size(), 3);
+  EXPECT_EQ(chunk_sums[0], 6);
+  EXPECT_EQ(chunk_sums[1], 15);
+  EXPECT_EQ(chunk_sums[2], 7);
+
+  EXPECT_EQ(s.windows(3).count(), 5);
+  EXPECT_EQ(s.windows(7).count(), 1);
+  EXPECT_EQ(s.windows(8).count(), 0);
+
+  EXPECT_TRUE(s.windows(2).map([](Span<int> w) { return w[0] < w[1]; }).fold(true, [](bool acc, bool b) { return acc && b; }));
+}
+
+TEST(IterTest, Vec)
+{
+  Vec<int> vec{os_allocator};
+
+  for (int i = 0; i < 100; i++)
+  {
+    vec.push(int{i}).unwrap();
+  }
+
+  EXPECT_EQ(vec.iter().filter([](int a) { return a % 10 == 0; }).count(), 10);
+}
+
+TEST(IterTest, CollectAllocationFailure)
+{
+  int       x[] = {1, 2, 3};
+  Span<int> s   = x;
+
+  EXPECT_EQ(s.iter().collect(noop_allocator).unwrap_err(), AllocError::NoMemory);
+}
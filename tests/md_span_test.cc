@@ -0,0 +1,157 @@
+#include "stx/md_span.h"
+
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(StridedSpanTest, Basic)
+{
+  int x[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  StridedSpan<int> evens{x, 5, 2};
+
+  EXPECT_EQ(evens.size(), 5);
+  EXPECT_EQ(evens[0], 0);
+  EXPECT_EQ(evens[4], 8);
+  EXPECT_EQ(evens.at(5), None);
+  EXPECT_FALSE(evens.is_contiguous());
+  EXPECT_EQ(evens.as_span(), None);
+
+  int sum = 0;
+
+  for (int value : evens)
+  {
+    sum += value;
+  }
+
+  EXPECT_EQ(sum, 20);
+
+  EXPECT_EQ(evens.slice(1, 2)[0], 2);
+  EXPECT_EQ(evens.slice(1, 2).size(), 2);
+  EXPECT_EQ(evens.step_by(2).size(), 3);
+  EXPECT_EQ(evens.step_by(2)[2], 8);
+
+  evens.fill(-1);
+  EXPECT_EQ(x[2], -1);
+  EXPECT_EQ(x[3], 3);
+
+  StridedSpan<int> all{Span<int>{x}};
+
+  EXPECT_TRUE(all.is_contiguous());
+  EXPECT_EQ(all.as_span().unwrap().size(), 10);
+}
+
+TEST(MdSpanTest, Indexing)
+{
+  std::vector<int> buffer(3 * 4);
+  std::iota(buffer.begin(), buffer.end(), 0);
+
+  MdSpan<int, 2> matrix{Span<int>{buffer}, {3, 4}};
+
+  EXPECT_EQ(matrix.size(), 12);
+  EXPECT_EQ(matrix.extent(0), 3);
+  EXPECT_EQ(matrix.extent(1), 4);
+  EXPECT_EQ(matrix.stride(0), 4);
+  EXPECT_EQ(matrix.stride(1), 1);
+  EXPECT_TRUE(matrix.is_contiguous());
+
+  EXPECT_EQ(matrix(0, 0), 0);
+  EXPECT_EQ(matrix(1, 2), 6);
+  EXPECT_EQ(matrix(2, 3), 11);
+
+  Span<int> row = matrix.row(1).span();
+
+  EXPECT_EQ(row.size(), 4);
+  EXPECT_EQ(row[0], 4);
+
+  StridedSpan<int> column = matrix.column(2);
+
+  EXPECT_EQ(column.size(), 3);
+  EXPECT_EQ(column[0], 2);
+  EXPECT_EQ(column[2], 10);
+
+  // the end of the last column would be past the buffer as a pointer
+  std::vector<int> last_column;
+
+  for (int value : matrix.column(3))
+  {
+    last_column.push_back(value);
+  }
+
+  EXPECT_EQ(last_column, (std::vector<int>{3, 7, 11}));
+  EXPECT_EQ(matrix.column(3).slice(3).begin(), matrix.column(3).slice(3).end());
+  EXPECT_TRUE(matrix.slice(1, 4, 0).is_empty());
+
+  MdSpan<int, 2> block = matrix.slice(1, 1, 2);
+
+  EXPECT_EQ(block.extent(1), 2);
+  EXPECT_FALSE(block.is_contiguous());
+  EXPECT_EQ(block.flatten(), None);
+  EXPECT_EQ(block(2, 1), 10);
+
+  MdSpan<int, 3> cube{buffer.data(), {2, 3, 2}};
+
+  EXPECT_EQ(cube(1, 2, 1), 11);
+  EXPECT_EQ(cube.row(1)(0, 1), 7);
+}
+
+TEST(MdSpanTest, Tiles)
+{
+  std::vector<int> buffer(5 * 7, 0);
+
+  MdSpan<int, 2> matrix{buffer.data(), {5, 7}};
+
+  auto tiles = matrix.tiles({2, 3});
+
+  EXPECT_EQ(tiles.size(), 9);
+
+  size_t num_tiles    = 0;
+  size_t num_elements = 0;
+
+  for (MdSpan<int, 2> tile : tiles)
+  {
+    EXPECT_LE(tile.extent(0), 2);
+    EXPECT_LE(tile.extent(1), 3);
+
+    for (size_t r = 0; r < tile.extent(0); r++)
+    {
+      tile.row(r).span().for_each([](int &x) { x++; });
+    }
+
+    num_tiles++;
+    num_elements += tile.size();
+  }
+
+  EXPECT_EQ(num_tiles, 9);
+  EXPECT_EQ(num_elements, 35);
+
+  // every element is covered exactly once
+  EXPECT_TRUE(Span<int>{buffer}.all_equals(1));
+
+  MdSpan<int, 2> empty{buffer.data(), {0, 7}};
+
+  EXPECT_EQ(empty.tiles({2, 2}).begin(), empty.tiles({2, 2}).end());
+}
+
+TEST(MdSpanTest, Transmute)
+{
+  uint32_t buffer[2 * 3] = {};
+
+  MdSpan<uint32_t, 2> matrix{buffer, {2, 3}};
+
+  MdSpan<uint8_t, 2> bytes = matrix.as_u8();
+
+  EXPECT_EQ(bytes.extent(0), 2);
+  EXPECT_EQ(bytes.extent(1), 12);
+  EXPECT_EQ(bytes.stride(0), 12);
+
+  bytes(1, 4) = 0xFF;
+  EXPECT_NE(buffer[4], 0);
+
+  MdSpan<uint16_t const, 2> halves = matrix.as_const().transmute<uint16_t const>();
+
+  EXPECT_EQ(halves.extent(1), 6);
+}
@@ -0,0 +1,130 @@
+#include "stx/mmap_vec.h"
+
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+namespace
+{
+
+struct Record
+{
+  uint64_t id    = 0;
+  uint32_t value = 0;
+  uint32_t flags = 0;
+};
+
+}        // namespace
+
+TEST(MmapVecTest, PushAndReopen)
+{
+  std::string path = testing::TempDir() + "stx_mmap_vec_push";
+  std::remove(path.c_str());
+
+  {
+    MmapVec<Record> vec = fs::map_vec<Record>(path.c_str()).unwrap();
+
+    EXPECT_TRUE(vec.is_empty());
+    EXPECT_GT(vec.capacity(), 0);
+
+    // grows past several pages
+    for (uint64_t i = 0; i < 10000; i++)
+    {
+      vec.push(Record{i, static_cast<uint32_t>(i * 2), 0}).unwrap();
+    }
+
+    EXPECT_EQ(vec.size(), 10000);
+    EXPECT_GE(vec.capacity(), 10000);
+    EXPECT_EQ(vec[9999].value, 19998);
+    EXPECT_EQ(vec.pop().unwrap().id, 9999);
+    EXPECT_TRUE(vec.flush().is_ok());
+  }
+
+  MmapVec<Record> vec = fs::map_vec<Record>(path.c_str()).unwrap();
+
+  EXPECT_EQ(vec.size(), 9999);
+
+  for (uint64_t i = 0; i < vec.size(); i++)
+  {
+    EXPECT_EQ(vec[i].id, i);
+  }
+
+  vec.push(Record{42, 0, 1}).unwrap();
+  EXPECT_EQ(vec.size(), 10000);
+  EXPECT_EQ(vec[9999].flags, 1);
+
+  std::remove(path.c_str());
+}
+
+TEST(MmapVecTest, Modify)
+{
+  std::string path = testing::TempDir() + "stx_mmap_vec_modify";
+  std::remove(path.c_str());
+
+  MmapVec<uint32_t> vec = fs::map_vec<uint32_t>(path.c_str()).unwrap();
+
+  uint32_t values[] = {1, 2, 3, 4, 5, 6};
+
+  vec.extend(values).unwrap();
+  EXPECT_EQ(vec.size(), 6);
+
+  vec.erase(vec.span().slice(1, 2));
+  EXPECT_EQ(vec.size(), 4);
+  EXPECT_EQ(vec[0], 1);
+  EXPECT_EQ(vec[1], 4);
+  EXPECT_EQ(vec[3], 6);
+
+  vec.resize(8, 7).unwrap();
+  EXPECT_EQ(vec.size(), 8);
+  EXPECT_EQ(vec[7], 7);
+
+  vec.resize(2).unwrap();
+  EXPECT_EQ(vec.size(), 2);
+
+  vec.reserve(100000).unwrap();
+  EXPECT_GE(vec.capacity(), 100000);
+  EXPECT_EQ(vec[1], 4);
+
+  vec.clear();
+  EXPECT_TRUE(vec.is_empty());
+  EXPECT_EQ(vec.pop(), None);
+
+  vec.push(9).unwrap();
+
+  MmapVec<uint32_t> moved = std::move(vec);
+  EXPECT_EQ(moved.size(), 1);
+  EXPECT_EQ(moved[0], 9);
+  EXPECT_EQ(vec.size(), 0);
+
+  // the moved-from MmapVec has no mapping but stays usable
+  vec.clear();
+  vec.erase(vec.span());
+  EXPECT_EQ(vec.pop(), None);
+  EXPECT_TRUE(vec.resize(0).is_ok());
+  EXPECT_TRUE(vec.is_empty());
+
+  std::remove(path.c_str());
+}
+
+TEST(MmapVecTest, InvalidFormat)
+{
+  std::string path = testing::TempDir() + "stx_mmap_vec_invalid";
+  std::remove(path.c_str());
+
+  fs::map_vec<uint32_t>(path.c_str()).unwrap().push(1).unwrap();
+
+  // a different element type
+  EXPECT_EQ(fs::map_vec<uint64_t>(path.c_str()).unwrap_err(), IoError::InvalidFormat);
+  EXPECT_EQ(fs::map_vec<uint32_t>(path.c_str()).unwrap().size(), 1);
+
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  std::fputs("not an MmapVec", file);
+  std::fclose(file);
+
+  EXPECT_EQ(fs::map_vec<uint32_t>(path.c_str()).unwrap_err(), IoError::InvalidFormat);
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,114 @@
+#include "stx/parse.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+namespace
+{
+
+template <typename T>
+Result<T, ParseError> int_(std::string_view str, uint32_t base = 10)
+{
+  return parse::int_<T>(Span<char const>{str.data(), str.size()}, base);
+}
+
+template <typename T>
+Result<T, ParseError> float_(std::string_view str)
+{
+  return parse::float_<T>(Span<char const>{str.data(), str.size()});
+}
+
+}        // namespace
+
+TEST(ParseTest, Int)
+{
+  EXPECT_EQ(int_<int>("0").unwrap(), 0);
+  EXPECT_EQ(int_<int>("42").unwrap(), 42);
+  EXPECT_EQ(int_<int>("-42").unwrap(), -42);
+  EXPECT_EQ(int_<int>("+42").unwrap(), 42);
+  EXPECT_EQ(int_<int>("000000000000000000042").unwrap(), 42);
+  EXPECT_EQ(int_<uint64_t>("1234567890123456789").unwrap(), 1234567890123456789ULL);
+  EXPECT_EQ(int_<uint64_t>("18446744073709551615").unwrap(), std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(int_<int64_t>("-9223372036854775808").unwrap(), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(int_<int64_t>("9223372036854775807").unwrap(), std::numeric_limits<int64_t>::max());
+  EXPECT_EQ(int_<int8_t>("-128").unwrap(), -128);
+  EXPECT_EQ(int_<uint8_t>("255").unwrap(), 255);
+
+  EXPECT_EQ(int_<uint64_t>("18446744073709551616").unwrap_err(), ParseError::OutOfRange);
+  EXPECT_EQ(int_<int64_t>("9223372036854775808").unwrap_err(), ParseError::OutOfRange);
+  EXPECT_EQ(int_<int8_t>("128").unwrap_err(), ParseError::OutOfRange);
+  EXPECT_EQ(int_<int8_t>("12345678").unwrap_err(), ParseError::OutOfRange);
+  EXPECT_EQ(int_<uint32_t>("99999999999999999999999").unwrap_err(), ParseError::OutOfRange);
+  EXPECT_EQ(int_<uint32_t>("99999999999999999999x99").unwrap_err(), ParseError::InvalidInput);
+
+  EXPECT_EQ(int_<int>("").unwrap_err(), ParseError::Empty);
+  EXPECT_EQ(int_<int>("-").unwrap_err(), ParseError::Empty);
+  EXPECT_EQ(int_<unsigned>("-1").unwrap_err(), ParseError::InvalidInput);
+  EXPECT_EQ(int_<int>(" 1").unwrap_err(), ParseError::InvalidInput);
+  EXPECT_EQ(int_<int>("1 ").unwrap_err(), ParseError::InvalidInput);
+  EXPECT_EQ(int_<int>("12345678a").unwrap_err(), ParseError::InvalidInput);
+  EXPECT_EQ(int_<int>("--1").unwrap_err(), ParseError::InvalidInput);
+
+  for (uint64_t value = 1; value < std::numeric_limits<uint64_t>::max() / 7; value = value * 7 + 3)
+  {
+    EXPECT_EQ(int_<uint64_t>(std::to_string(value)).unwrap(), value);
+  }
+}
+
+TEST(ParseTest, IntBase)
+{
+  EXPECT_EQ(int_<uint32_t>("ff", 16).unwrap(), 0xFF);
+  EXPECT_EQ(int_<uint32_t>("DeadBeef", 16).unwrap(), 0xDEADBEEF);
+  EXPECT_EQ(int_<uint64_t>("ffffffffffffffff", 16).unwrap(), std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(int_<int>("-101", 2).unwrap(), -5);
+  EXPECT_EQ(int_<int>("z", 36).unwrap(), 35);
+
+  EXPECT_EQ(int_<uint32_t>("100000000", 16).unwrap_err(), ParseError::OutOfRange);
+  EXPECT_EQ(int_<uint32_t>("0xff", 16).unwrap_err(), ParseError::InvalidInput);
+  EXPECT_EQ(int_<int>("2", 2).unwrap_err(), ParseError::InvalidInput);
+
+  // unsupported bases
+  EXPECT_EQ(int_<int>("zz", 40).unwrap_err(), ParseError::InvalidInput);
+  EXPECT_EQ(int_<int>("000", 1).unwrap_err(), ParseError::InvalidInput);
+  EXPECT_EQ(int_<int>("0", 0).unwrap_err(), ParseError::InvalidInput);
+}
+
+TEST(ParseTest, Float)
+{
+  EXPECT_EQ(float_<double>("0").unwrap(), 0.0);
+  EXPECT_EQ(float_<double>("1.5").unwrap(), 1.5);
+  EXPECT_EQ(float_<double>("+1.5").unwrap(), 1.5);
+  EXPECT_EQ(float_<double>("-12.5e-3").unwrap(), -12.5e-3);
+  EXPECT_EQ(float_<double>("0.1").unwrap(), 0.1);
+  EXPECT_EQ(float_<double>("1.7976931348623157e308").unwrap(), std::numeric_limits<double>::max());
+  EXPECT_EQ(float_<float>("3.4028235e38").unwrap(), std::numeric_limits<float>::max());
+  EXPECT_TRUE(std::isinf(float_<double>("inf").unwrap()));
+  EXPECT_TRUE(std::isnan(float_<double>("nan").unwrap()));
+
+  EXPECT_EQ(float_<double>("1e400").unwrap_err(), ParseError::OutOfRange);
+  EXPECT_EQ(float_<double>("-1e400").unwrap_err(), ParseError::OutOfRange);
+  EXPECT_EQ(float_<double>("0.00001e314").unwrap_err(), ParseError::OutOfRange);
+  EXPECT_EQ(float_<float>("1e39").unwrap_err(), ParseError::OutOfRange);
+
+  // underflow rounds to a zero of the same sign, denormals are kept
+  EXPECT_EQ(float_<double>("4.9e-324").unwrap(), std::numeric_limits<double>::denorm_min());
+  EXPECT_EQ(float_<double>("1e-400").unwrap(), 0.0);
+  EXPECT_FALSE(std::signbit(float_<double>("1e-400").unwrap()));
+  EXPECT_TRUE(std::signbit(float_<double>("-1e-400").unwrap()));
+  EXPECT_EQ(float_<double>("100000e-330").unwrap(), 0.0);
+  EXPECT_EQ(float_<double>("0.0000001e-320").unwrap(), 0.0);
+  EXPECT_EQ(float_<double>("1e-310").unwrap(), 1e-310);
+  EXPECT_EQ(float_<float>("1e-40").unwrap(), 1e-40f);
+  EXPECT_EQ(float_<float>("1e-50").unwrap(), 0.0f);
+  EXPECT_EQ(float_<double>("").unwrap_err(), ParseError::Empty);
+  EXPECT_EQ(float_<double>("+").unwrap_err(), ParseError::Empty);
+  EXPECT_EQ(float_<double>("+-1").unwrap_err(), ParseError::InvalidInput);
+  EXPECT_EQ(float_<double>("1.5 ").unwrap_err(), ParseError::InvalidInput);
+  EXPECT_EQ(float_<double>("abc").unwrap_err(), ParseError::InvalidInput);
+}
@@ -0,0 +1,170 @@
+#include "stx/persistent.h"
+
+#include <string_view>
+
+#include "stx/rc.h"
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(PersistentVecTest, PushSetPop)
+{
+  PersistentVec<int> empty{os_allocator};
+
+  EXPECT_TRUE(empty.is_empty());
+  EXPECT_EQ(empty.get(0), None);
+
+  PersistentVec<int> vec = empty.share();
+
+  for (int i = 0; i < 2000; i++)
+  {
+    vec = vec.push(int{i}).unwrap();
+  }
+
+  EXPECT_EQ(vec.size(), 2000);
+  EXPECT_EQ(vec.shift_, 10);
+
+  for (int i = 0; i < 2000; i++)
+  {
+    EXPECT_EQ(vec.get(i).value().get(), i);
+  }
+
+  EXPECT_EQ(vec.get(2000), None);
+
+  PersistentVec<int> snapshot = vec.share();
+  PersistentVec<int> updated  = vec.set(1234, -1).unwrap();
+
+  EXPECT_EQ(updated.get(1234).value().get(), -1);
+  EXPECT_EQ(snapshot.get(1234).value().get(), 1234);
+  EXPECT_EQ(vec.get(1234).value().get(), 1234);
+
+  // untouched leaves are shared
+  EXPECT_EQ(&updated.get(0).value().get(), &snapshot.get(0).value().get());
+  EXPECT_NE(&updated.get(1234).value().get(), &snapshot.get(1234).value().get());
+
+  PersistentVec<int> popped = vec.share();
+
+  while (popped.size() > 10)
+  {
+    popped = popped.pop().unwrap();
+  }
+
+  EXPECT_EQ(popped.size(), 10);
+  EXPECT_EQ(popped.shift_, 0);
+  EXPECT_EQ(popped.get(9).value().get(), 9);
+  EXPECT_EQ(popped.get(10), None);
+  EXPECT_EQ(vec.size(), 2000);
+  EXPECT_EQ(vec.get(1999).value().get(), 1999);
+
+  int sum = 0;
+  popped.for_each([&sum](int x) { sum += x; });
+  EXPECT_EQ(sum, 45);
+
+  EXPECT_TRUE(empty.is_empty());
+  EXPECT_TRUE(empty.pop().unwrap().is_empty());
+}
+
+TEST(PersistentVecTest, AllocFailure)
+{
+  PersistentVec<int> vec{noop_allocator};
+
+  EXPECT_EQ(vec.push(1).unwrap_err(), AllocError::NoMemory);
+  EXPECT_TRUE(vec.is_empty());
+}
+
+TEST(PersistentMapTest, InsertGetRemove)
+{
+  PersistentMap<int, int> empty{os_allocator};
+  PersistentMap<int, int> map = empty.share();
+
+  for (int i = 0; i < 1000; i++)
+  {
+    map = map.insert(int{i}, i * 10).unwrap();
+  }
+
+  EXPECT_EQ(map.size(), 1000);
+  EXPECT_TRUE(empty.is_empty());
+
+  for (int i = 0; i < 1000; i++)
+  {
+    EXPECT_EQ(map.get(i).value().get(), i * 10);
+  }
+
+  EXPECT_FALSE(map.contains(1000));
+
+  PersistentMap<int, int> snapshot = map.share();
+
+  map = map.insert(4, -4).unwrap();
+  EXPECT_EQ(map.size(), 1000);
+  EXPECT_EQ(map.get(4).value().get(), -4);
+  EXPECT_EQ(snapshot.get(4).value().get(), 40);
+
+  for (int i = 0; i < 1000; i += 2)
+  {
+    map = map.remove(i).unwrap();
+  }
+
+  EXPECT_EQ(map.size(), 500);
+  EXPECT_EQ(map.remove(0).unwrap().size(), 500);
+
+  for (int i = 0; i < 1000; i++)
+  {
+    EXPECT_EQ(map.contains(i), i % 2 == 1);
+    EXPECT_TRUE(snapshot.contains(i));
+  }
+
+  int count = 0;
+  map.for_each([&count](int key, int value) {
+    EXPECT_EQ(value, key * 10);
+    count++;
+  });
+  EXPECT_EQ(count, 500);
+
+  for (int i = 1; i < 1000; i += 2)
+  {
+    map = map.remove(i).unwrap();
+  }
+
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_EQ(map.root_, None);
+  EXPECT_EQ(snapshot.size(), 1000);
+}
+
+struct CollidingHash
+{
+  HashValue operator()(std::string_view) const
+  {
+    return 42;
+  }
+};
+
+TEST(PersistentMapTest, Collisions)
+{
+  PersistentMap<std::string_view, int, CollidingHash> map{os_allocator};
+
+  map = map.insert("a", 1).unwrap();
+  map = map.insert("b", 2).unwrap();
+  map = map.insert("c", 3).unwrap();
+  map = map.insert("b", 20).unwrap();
+
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.get("a").value().get(), 1);
+  EXPECT_EQ(map.get("b").value().get(), 20);
+  EXPECT_EQ(map.get("c").value().get(), 3);
+  EXPECT_EQ(map.get("d"), None);
+
+  map = map.remove("b").unwrap();
+  map = map.remove("d").unwrap();
+
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_FALSE(map.contains("b"));
+  EXPECT_EQ(map.get("c").value().get(), 3);
+}
+
+TEST(PersistentMapTest, AllocFailure)
+{
+  PersistentMap<int, int> map{noop_allocator};
+
+  EXPECT_EQ(map.insert(1, 1).unwrap_err(), AllocError::NoMemory);
+  EXPECT_TRUE(map.is_empty());
+}
@@ -130,6 +130,30 @@ TEST(ReportTest, FormatInt32)
   EXPECT_EQ(query >> b, to_string(b));
 }
 
+TEST(ReportTest, FormatInt64)
+{
+  int64_t a = std::numeric_limits<int64_t>::min();
+  EXPECT_EQ(query >> a, to_string(a));
+
+  uint64_t b = std::numeric_limits<uint64_t>::max();
+  EXPECT_EQ(query >> b, to_string(b));
+}
+
+TEST(ReportTest, FormatFloat)
+{
+  EXPECT_EQ(query >> 0.25, "0.25");
+  EXPECT_EQ(query >> -1.5f, "-1.5");
+}
+
+TEST(ReportTest, Truncation)
+{
+  char small_buffer[4];
+  auto small_query = ReportQuery{ReportQuery::Buffer{small_buffer, std::size(small_buffer)}};
+
+  EXPECT_EQ(small_query >> uint32_t{123456}, "1234");
+  EXPECT_EQ(ReportQuery{} >> uint32_t{123456}, "");
+}
+
 TEST(ReportTest, FormatEnum)
 {
   using namespace std::string_view_literals;
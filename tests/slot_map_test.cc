@@ -0,0 +1,102 @@
+#include "stx/slot_map.h"
+
+#include "stx/rc.h"
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(SlotMapTest, InsertGetRemove)
+{
+  SlotMap<int> map{os_allocator};
+
+  SlotKey a = map.insert(1).unwrap();
+  SlotKey b = map.insert(2).unwrap();
+  SlotKey c = map.insert(3).unwrap();
+
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.get(a).value().get(), 1);
+  EXPECT_EQ(map.get(b).value().get(), 2);
+  EXPECT_EQ(map.get(c).value().get(), 3);
+
+  EXPECT_EQ(map.remove(a), Some(1));
+  EXPECT_EQ(map.remove(a), None);
+  EXPECT_FALSE(map.contains(a));
+  EXPECT_EQ(map.get(a), None);
+
+  // the last element was moved into the removed element's position
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.get(b).value().get(), 2);
+  EXPECT_EQ(map.get(c).value().get(), 3);
+
+  for (size_t i = 0; i < map.size(); i++)
+  {
+    EXPECT_EQ(map.get(map.keys()[i]).value().get(), map.span()[i]);
+  }
+}
+
+TEST(SlotMapTest, Generations)
+{
+  SlotMap<int> map{os_allocator};
+
+  SlotKey a = map.insert(1).unwrap();
+  map.remove(a).unwrap();
+
+  // reuses the slot, but the stale key must not alias the new element
+  SlotKey b = map.insert(2).unwrap();
+
+  EXPECT_EQ(a.index, b.index);
+  EXPECT_NE(a, b);
+  EXPECT_FALSE(map.contains(a));
+  EXPECT_EQ(map.get(b).value().get(), 2);
+}
+
+TEST(SlotMapTest, RemoveAt)
+{
+  SlotMap<Rc<int *>> map{os_allocator};
+
+  SlotKey keys[100];
+
+  for (int i = 0; i < 100; i++)
+  {
+    keys[i] = map.insert(rc::make(os_allocator, int{i}).unwrap()).unwrap();
+  }
+
+  // remove the even elements while iterating
+  for (size_t i = 0; i < map.size();)
+  {
+    if (*map.span()[i] % 2 == 0)
+    {
+      map.remove_at(i);
+    }
+    else
+    {
+      i++;
+    }
+  }
+
+  EXPECT_EQ(map.size(), 50);
+
+  for (int i = 0; i < 100; i++)
+  {
+    if (i % 2 == 0)
+    {
+      EXPECT_FALSE(map.contains(keys[i]));
+    }
+    else
+    {
+      EXPECT_EQ(*map.get(keys[i]).value().get(), i);
+    }
+  }
+
+  map.clear();
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(keys[1]));
+}
+
+TEST(SlotMapTest, AllocationFailure)
+{
+  SlotMap<int> map{noop_allocator};
+
+  EXPECT_EQ(map.insert(1), Err(AllocError::NoMemory));
+  EXPECT_TRUE(map.is_empty());
+}
@@ -0,0 +1,109 @@
+#include "stx/soa_vec.h"
+
+#include "stx/rc.h"
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(SoaVecTest, PushAndSpan)
+{
+  SoaVec<int, float, Rc<int *>> vec{os_allocator};
+
+  EXPECT_TRUE(vec.is_empty());
+
+  for (int i = 0; i < 100; i++)
+  {
+    vec.push(int{i}, i * 0.5f, rc::make(os_allocator, int{i * 2}).unwrap()).unwrap();
+  }
+
+  EXPECT_EQ(vec.size(), 100);
+  EXPECT_GE(vec.capacity(), 100);
+  EXPECT_EQ(vec.span<0>().size(), 100);
+  EXPECT_EQ(vec.span<1>().size(), 100);
+  EXPECT_EQ(vec.span<2>().size(), 100);
+
+  for (int i = 0; i < 100; i++)
+  {
+    EXPECT_EQ(vec.span<0>()[i], i);
+    EXPECT_EQ(vec.span<1>()[i], i * 0.5f);
+    EXPECT_EQ(*vec.span<2>()[i], i * 2);
+  }
+}
+
+TEST(SoaVecTest, Erase)
+{
+  SoaVec<int, Rc<int *>> vec{os_allocator};
+
+  for (int i = 0; i < 10; i++)
+  {
+    vec.push(int{i}, rc::make(os_allocator, int{i}).unwrap()).unwrap();
+  }
+
+  vec.erase(2, 5);
+
+  EXPECT_EQ(vec.size(), 5);
+
+  int expected[] = {0, 1, 7, 8, 9};
+
+  for (size_t i = 0; i < 5; i++)
+  {
+    EXPECT_EQ(vec.span<0>()[i], expected[i]);
+    EXPECT_EQ(*vec.span<1>()[i], expected[i]);
+  }
+
+  vec.clear();
+
+  EXPECT_TRUE(vec.is_empty());
+}
+
+TEST(SoaVecTest, Partition)
+{
+  SoaVec<int, Rc<int *>> vec{os_allocator};
+
+  for (int i = 0; i < 10; i++)
+  {
+    vec.push(int{i}, rc::make(os_allocator, int{i}).unwrap()).unwrap();
+  }
+
+  size_t num_even = vec.partition<0>([](int x) { return x % 2 == 0; });
+
+  EXPECT_EQ(num_even, 5);
+
+  int expected[] = {0, 2, 4, 6, 8, 1, 3, 5, 7, 9};
+
+  for (size_t i = 0; i < 10; i++)
+  {
+    EXPECT_EQ(vec.span<0>()[i], expected[i]);
+    EXPECT_EQ(*vec.span<1>()[i], expected[i]);
+  }
+}
+
+TEST(SoaVecTest, Sort)
+{
+  SoaVec<int, Rc<int *>> vec{os_allocator};
+
+  int values[] = {5, 3, 9, 1, 7, 2, 8, 0, 6, 4};
+
+  for (int value : values)
+  {
+    vec.push(int{value}, rc::make(os_allocator, int{value}).unwrap()).unwrap();
+  }
+
+  vec.sort<0>(0, 5, [](int a, int b) { return a < b; });
+
+  int partially_sorted[] = {1, 3, 5, 7, 9, 2, 8, 0, 6, 4};
+
+  for (size_t i = 0; i < 10; i++)
+  {
+    EXPECT_EQ(vec.span<0>()[i], partially_sorted[i]);
+    EXPECT_EQ(*vec.span<1>()[i], partially_sorted[i]);
+  }
+
+  vec.sort<1>([](Rc<int *> const &a, Rc<int *> const &b) { return *a > *b; });
+
+  for (size_t i = 0; i < 10; i++)
+  {
+    EXPECT_EQ(vec.span<0>()[i], 9 - static_cast<int>(i));
+    EXPECT_EQ(*vec.span<1>()[i], 9 - static_cast<int>(i));
+  }
+}
@@ -206,6 +206,57 @@ TEST(SpanTest, Algorithms)
   }
 }
 
+TEST(SpanTest, Search)
+{
+  int       x[] = {1, 2, 2, 2, 5, 8, 8, 13};
+  Span<int> s   = x;
+  Span<int> e{};
+
+  EXPECT_EQ(e.lower_bound(1), 0);
+  EXPECT_EQ(e.upper_bound(1), 0);
+  EXPECT_TRUE(e.binary_search(1).is_empty());
+
+  EXPECT_EQ(s.lower_bound(0), 0);
+  EXPECT_EQ(s.lower_bound(1), 0);
+  EXPECT_EQ(s.lower_bound(2), 1);
+  EXPECT_EQ(s.lower_bound(3), 4);
+  EXPECT_EQ(s.lower_bound(13), 7);
+  EXPECT_EQ(s.lower_bound(14), 8);
+
+  EXPECT_EQ(s.upper_bound(2), 4);
+  EXPECT_EQ(s.upper_bound(13), 8);
+  EXPECT_EQ(s.upper_bound(0), 0);
+
+  EXPECT_EQ(s.equal_range(2).size(), 3);
+  EXPECT_EQ(s.equal_range(2).data(), x + 1);
+  EXPECT_EQ(s.equal_range(8).size(), 2);
+  EXPECT_TRUE(s.equal_range(7).is_empty());
+
+  EXPECT_EQ(s.binary_search(5).data(), x + 4);
+  EXPECT_TRUE(s.binary_search(6).is_empty());
+
+  for (int i = 0; i < 15; i++)
+  {
+    EXPECT_EQ(s.lower_bound(i), static_cast<size_t>(std::lower_bound(s.begin(), s.end(), i) - s.begin()));
+    EXPECT_EQ(s.upper_bound(i), static_cast<size_t>(std::upper_bound(s.begin(), s.end(), i) - s.begin()));
+  }
+
+  int       y[] = {13, 8, 2, 1};
+  Span<int> r   = y;
+
+  EXPECT_EQ(r.lower_bound(8, [](int a, int b) { return a > b; }), 1);
+
+  int a[]    = {1, 4, 9};
+  int b[]    = {2, 3, 10, 11};
+  int out[7] = {};
+
+  Span<int>{a}.merge(Span<int const>{b}, Span<int>{out});
+
+  EXPECT_TRUE(Span<int>{out}.is_sorted());
+  EXPECT_EQ(out[0], 1);
+  EXPECT_EQ(out[6], 11);
+}
+
 TEST(SpanTest, Last)
 {
   int data[] = {1, 2, 3, 4, 5};
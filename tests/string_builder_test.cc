@@ -0,0 +1,55 @@
+#include "stx/string_builder.h"
+
+#include <cstdint>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(StringBuilderTest, Append)
+{
+  StringBuilder builder{os_allocator};
+
+  EXPECT_TRUE(builder.is_empty());
+  EXPECT_EQ(builder.build().unwrap(), "");
+
+  builder.append("task ").append_int(42).append(' ').append_int(-7).append(" took ").append_float(1.5).append("ms");
+
+  EXPECT_EQ(builder.view(), "task 42 -7 took 1.5ms");
+
+  String short_str = builder.build().unwrap();
+  EXPECT_EQ(short_str, "task 42 -7 took 1.5ms");
+  EXPECT_TRUE(short_str.is_inline());
+  EXPECT_TRUE(builder.is_empty());
+
+  builder.append_int(std::numeric_limits<int64_t>::min()).append(',').append_int(std::numeric_limits<uint64_t>::max());
+  builder.append(',').append_float(0.1).append(',').append_float(-1e300).append(',').append_float(0.1f);
+  builder.append_fmt(" x=", 12, '/', fmt::hex(255));
+
+  String long_str = builder.build().unwrap();
+  EXPECT_EQ(long_str, "-9223372036854775808,18446744073709551615,0.1,-1e+300,0.1 x=12/ff");
+  EXPECT_FALSE(long_str.is_inline());
+  EXPECT_EQ(long_str.c_str()[long_str.size()], '\0');
+  EXPECT_TRUE(builder.is_empty());
+
+  for (int i = 0; i < 1000; i++)
+  {
+    builder.append_int(i % 10);
+  }
+
+  String digits = builder.build().unwrap();
+  EXPECT_EQ(digits.size(), 1000);
+  EXPECT_EQ(digits[999], '9');
+}
+
+TEST(StringBuilderTest, AllocFailure)
+{
+  StringBuilder builder{noop_allocator};
+
+  builder.append("hello").append_int(1);
+
+  EXPECT_TRUE(builder.has_error());
+  EXPECT_EQ(builder.build().unwrap_err(), AllocError::NoMemory);
+  EXPECT_FALSE(builder.has_error());
+}
@@ -0,0 +1,86 @@
+#include "stx/string_interner.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(StringInternerTest, Intern)
+{
+  StringInterner interner = string::make_interner(os_allocator).unwrap();
+
+  std::string context = "image decoder";
+
+  Rc<std::string_view> a = interner.intern(context).unwrap();
+  Rc<std::string_view> b = interner.intern(std::string{"image decoder"}).unwrap();
+  Rc<std::string_view> c = interner.intern("thumbnail").unwrap();
+
+  EXPECT_EQ(a.handle, "image decoder");
+  EXPECT_EQ(a.handle.data(), b.handle.data());
+  EXPECT_NE(a.handle.data(), context.data());
+  EXPECT_NE(a.handle.data(), c.handle.data());
+  EXPECT_EQ(interner.size(), 2);
+
+  Symbol s1 = interner.intern_symbol("thumbnail").unwrap();
+  Symbol s2 = interner.intern_symbol("resize").unwrap();
+
+  EXPECT_EQ(s1, interner.intern_symbol("thumbnail").unwrap());
+  EXPECT_NE(s1, s2);
+  EXPECT_EQ(interner.resolve(s1).data(), c.handle.data());
+  EXPECT_EQ(interner.resolve(s2), "resize");
+  EXPECT_EQ(interner.intern("").unwrap().handle, "");
+
+  // larger than a chunk
+  std::string large(10000, 'x');
+  EXPECT_EQ(interner.intern(large).unwrap().handle, large);
+  EXPECT_EQ(interner.size(), 5);
+
+  // the views outlive the interner
+  {
+    StringInterner moved{std::move(interner)};
+  }
+  EXPECT_EQ(a.handle, "image decoder");
+  EXPECT_EQ(c.handle, "thumbnail");
+
+  EXPECT_EQ(string::make_interner(noop_allocator).unwrap_err(), AllocError::NoMemory);
+}
+
+TEST(StringInternerTest, Concurrent)
+{
+  StringInterner interner = string::make_interner(os_allocator).unwrap();
+
+  constexpr int NUM_THREADS = 4;
+  constexpr int NUM_STRINGS = 2000;
+
+  std::vector<std::vector<Symbol>> symbols(NUM_THREADS);
+  std::vector<std::thread>         threads;
+
+  for (int t = 0; t < NUM_THREADS; t++)
+  {
+    threads.emplace_back([&, t, handle = interner.share()]() mutable {
+      for (int i = 0; i < NUM_STRINGS; i++)
+      {
+        symbols[t].push_back(handle.intern_symbol("label-" + std::to_string(i)).unwrap());
+      }
+    });
+  }
+
+  for (std::thread &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(interner.size(), NUM_STRINGS);
+
+  for (int i = 0; i < NUM_STRINGS; i++)
+  {
+    for (int t = 1; t < NUM_THREADS; t++)
+    {
+      EXPECT_EQ(symbols[t][i], symbols[0][i]);
+    }
+    EXPECT_EQ(interner.resolve(symbols[0][i]), "label-" + std::to_string(i));
+  }
+}
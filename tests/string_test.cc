@@ -46,3 +46,109 @@ TEST(StrTest, Init)
 
   EXPECT_EQ(a, a.copy(stx::os_allocator).unwrap());
 }
+
+TEST(StrTest, SmallStringOptimization)
+{
+  // short strings never touch the allocator
+  String a = string::make(noop_allocator, "short key").unwrap();
+  String b = string::make(noop_allocator, "exactly twenty-three ch").unwrap();
+
+  EXPECT_TRUE(a.is_inline());
+  EXPECT_TRUE(b.is_inline());
+  EXPECT_EQ(a, "short key");
+  EXPECT_EQ(b.size(), String::INLINE_CAPACITY);
+  EXPECT_EQ(b.c_str()[b.size()], '\0');
+
+  EXPECT_EQ(string::make(noop_allocator, "twenty-four characters!!").unwrap_err(), AllocError::NoMemory);
+  EXPECT_EQ(string::upper(noop_allocator, "abc").unwrap(), "ABC");
+  EXPECT_EQ(string::join(noop_allocator, "-", "a", "b", "c").unwrap(), "a-b-c");
+  EXPECT_EQ(a.copy(noop_allocator).unwrap(), "short key");
+
+  String long_str = string::make(os_allocator, "a string that is too long to be stored inline").unwrap();
+  EXPECT_FALSE(long_str.is_inline());
+  EXPECT_EQ(long_str.c_str()[long_str.size()], '\0');
+
+  String moved_long{std::move(long_str)};
+  EXPECT_EQ(moved_long, "a string that is too long to be stored inline");
+  EXPECT_TRUE(long_str.is_empty());
+  EXPECT_EQ(long_str.c_str()[0], '\0');
+
+  String moved_short{std::move(a)};
+  EXPECT_EQ(moved_short, "short key");
+  EXPECT_TRUE(a.is_empty());
+
+  moved_short = std::move(moved_long);
+  EXPECT_EQ(moved_short, "a string that is too long to be stored inline");
+
+  moved_short = std::move(b);
+  EXPECT_EQ(moved_short, "exactly twenty-three ch");
+
+  // empty memory can be null
+  String empty{ReadOnlyMemory{noop_allocator, nullptr}, 0};
+  EXPECT_TRUE(empty.is_empty());
+  EXPECT_EQ(empty.c_str()[0], '\0');
+
+  EXPECT_EQ("hello"_str, "hello");
+  EXPECT_EQ(string::make_static(std::string_view{"hello world", 5}), "hello");
+  EXPECT_EQ(string::make_static(std::string_view{"hello world", 5}).c_str()[5], '\0');
+}
+
+TEST(StrTest, Search)
+{
+  std::string_view text = "the quick brown fox jumps over the lazy dog, then the fox sleeps";
+
+  EXPECT_EQ(string::find(text, "the").unwrap(), 0);
+  EXPECT_EQ(string::find(text, "fox").unwrap(), 16);
+  EXPECT_EQ(string::find(text, "sleeps").unwrap(), text.size() - 6);
+  EXPECT_EQ(string::find(text, "s").unwrap(), 24);
+  EXPECT_EQ(string::find(text, "").unwrap(), 0);
+  EXPECT_TRUE(string::find(text, "cat").is_none());
+  EXPECT_TRUE(string::find("fox", "foxes").is_none());
+  EXPECT_TRUE(string::find("", "a").is_none());
+
+  // the first and last bytes match but the middle doesn't
+  EXPECT_TRUE(string::find("aXb aYb aZb aXb aYb aZb aXb aYb", "aQb").is_none());
+  EXPECT_EQ(string::find("aXb aYb aZb aXb aYb aZb aXb aYb aQb", "aQb").unwrap(), 32);
+
+  String str = string::make(os_allocator, text).unwrap();
+  EXPECT_EQ(str.find("lazy").unwrap(), 35);
+  EXPECT_TRUE(str.contains("jumps over"));
+  EXPECT_FALSE(str.contains("jumped"));
+
+  std::vector<std::string> pieces;
+  string::split("a,b,,c", ",", [&](std::string_view piece) { pieces.emplace_back(piece); });
+  EXPECT_EQ(pieces, (std::vector<std::string>{"a", "b", "", "c"}));
+
+  pieces.clear();
+  string::split("key => value => ", " => ", [&](std::string_view piece) { pieces.emplace_back(piece); });
+  EXPECT_EQ(pieces, (std::vector<std::string>{"key", "value", ""}));
+
+  pieces.clear();
+  string::split("abc", "", [&](std::string_view piece) { pieces.emplace_back(piece); });
+  EXPECT_EQ(pieces, (std::vector<std::string>{"abc"}));
+}
+
+TEST(StrTest, CaseMapping)
+{
+  EXPECT_EQ(string::upper(os_allocator, "Hello, World! 0123456789 [_] `~` {@}").unwrap(), "HELLO, WORLD! 0123456789 [_] `~` {@}");
+  EXPECT_EQ(string::lower(os_allocator, "Hello, World! 0123456789 [_] `~` {@}").unwrap(), "hello, world! 0123456789 [_] `~` {@}");
+
+  // non-ASCII bytes are unchanged
+  EXPECT_EQ(string::upper(os_allocator, "caf\xc3\xa9 au lait, s'il vous pla\xc3\xaet").unwrap(), "CAF\xc3\xa9 AU LAIT, S'IL VOUS PLA\xc3\xaeT");
+
+  EXPECT_TRUE(string::equal_ignore_case("Content-Type: Application/JSON", "content-type: application/json"));
+  EXPECT_FALSE(string::equal_ignore_case("Content-Type: Application/JSON", "content-type: application/jsox"));
+  EXPECT_FALSE(string::equal_ignore_case("abc", "abcd"));
+  EXPECT_FALSE(string::equal_ignore_case("[", "{"));
+  EXPECT_TRUE("Accept-Encoding"_str.equal_ignore_case("ACCEPT-ENCODING"));
+}
+
+TEST(StrTest, Format)
+{
+  EXPECT_EQ(string::format(os_allocator, "task ", 42, " took ", 1.5, "ms").unwrap(), "task 42 took 1.5ms");
+  EXPECT_EQ(string::format(os_allocator, "ip: 0x", fmt::hex(0xdeadbeefu)).unwrap(), "ip: 0xdeadbeef");
+  EXPECT_EQ(string::format(os_allocator).unwrap(), "");
+  EXPECT_EQ(string::format(noop_allocator, "a string that is too long to be stored inline").unwrap_err(), AllocError::NoMemory);
+
+  EXPECT_EQ(string::join(os_allocator, ", ", "x", 1, -2.5, 'c', true).unwrap(), "x, 1, -2.5, c, true");
+}
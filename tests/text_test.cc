@@ -0,0 +1,91 @@
+#include "stx/text.h"
+
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+namespace
+{
+
+Span<uint8_t const> bytes(std::string_view str)
+{
+  return Span<uint8_t const>{reinterpret_cast<uint8_t const *>(str.data()), str.size()};
+}
+
+}        // namespace
+
+TEST(TextTest, Next)
+{
+  std::string_view text = "a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80";
+  uint8_t const   *iter = bytes(text).data();
+
+  EXPECT_EQ(utf8_next(iter), U'a');
+  EXPECT_EQ(utf8_next(iter), U'é');
+  EXPECT_EQ(utf8_next(iter), U'€');
+  EXPECT_EQ(utf8_next(iter), U'\U0001F600');
+  EXPECT_EQ(iter, bytes(text).data() + text.size());
+}
+
+TEST(TextTest, Validate)
+{
+  EXPECT_TRUE(utf8_validate(bytes("")));
+  EXPECT_TRUE(utf8_validate(bytes("plain ascii text that is longer than sixteen bytes")));
+  EXPECT_TRUE(utf8_validate(bytes("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 \xf4\x8f\xbf\xbf \xed\x9f\xbf")));
+
+  // lone continuation byte
+  EXPECT_FALSE(utf8_validate(bytes("abc\x80")));
+  // overlong
+  EXPECT_FALSE(utf8_validate(bytes("\xc0\xaf")));
+  EXPECT_FALSE(utf8_validate(bytes("\xe0\x80\xaf")));
+  EXPECT_FALSE(utf8_validate(bytes("\xf0\x80\x80\xaf")));
+  // surrogate
+  EXPECT_FALSE(utf8_validate(bytes("\xed\xa0\x80")));
+  // beyond U+10FFFF
+  EXPECT_FALSE(utf8_validate(bytes("\xf4\x90\x80\x80")));
+  EXPECT_FALSE(utf8_validate(bytes("\xf5\x80\x80\x80")));
+  // truncated
+  EXPECT_FALSE(utf8_validate(bytes("\xe2\x82")));
+  EXPECT_FALSE(utf8_validate(bytes("\xe2\x82z")));
+
+  EXPECT_EQ(utf8_valid_up_to(bytes("sixteen ascii by\xc3\xa9 and then\xff")), 27);
+  EXPECT_EQ(utf8_valid_up_to(bytes("ok")), 2);
+}
+
+TEST(TextTest, Count)
+{
+  EXPECT_EQ(utf8_count(bytes("")), 0);
+  EXPECT_EQ(utf8_count(bytes("hello")), 5);
+  EXPECT_EQ(utf8_count(bytes("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80")), 17);
+}
+
+TEST(TextTest, Decode)
+{
+  std::string_view text = "0123456789abcdef caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 0123456789abcdefghij";
+
+  std::vector<uint32_t> expected;
+  for (char c : std::string_view{"0123456789abcdef caf"})
+  {
+    expected.push_back(static_cast<uint32_t>(c));
+  }
+  expected.insert(expected.end(), {U'é', U' ', U'€', U' ', U'\U0001F600', U' '});
+  for (char c : std::string_view{"0123456789abcdefghij"})
+  {
+    expected.push_back(static_cast<uint32_t>(c));
+  }
+
+  ASSERT_EQ(utf8_count(bytes(text)), expected.size());
+
+  std::vector<uint32_t> out(expected.size());
+  EXPECT_EQ(utf8_decode(bytes(text), Span<uint32_t>{out.data(), out.size()}).unwrap(), expected.size());
+  EXPECT_EQ(out, expected);
+
+  Vec<uint32_t> vec = utf8_decode(os_allocator, bytes(text)).unwrap();
+  EXPECT_EQ(std::vector<uint32_t>(vec.begin(), vec.end()), expected);
+
+  EXPECT_EQ(utf8_decode(os_allocator, bytes("0123456789abcdef\xed\xa0\x80")).unwrap_err(), Utf8Error::InvalidSequence);
+  EXPECT_EQ(utf8_decode(noop_allocator, bytes("abc")).unwrap_err(), Utf8Error::NoMemory);
+  EXPECT_TRUE(utf8_decode(os_allocator, bytes("")).unwrap().is_empty());
+}
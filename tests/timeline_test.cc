@@ -205,8 +205,6 @@ TEST(Timeline, Sample)
   EXPECT_FALSE(slot[2]->slot.query().pending_task.is_some());
   EXPECT_FALSE(slot[3]->slot.query().pending_task.is_some());
 
-  EXPECT_TRUE(timeline.starvation_timeline.span().is_sorted(
-      [](ScheduleTimeline::Task const &a, ScheduleTimeline::Task const &b) {
-        return a.priority < b.priority;
-      }));
+  EXPECT_TRUE(timeline.starvation_timeline.span<ScheduleTimeline::PRIORITY>().is_sorted(
+      [](TaskPriority a, TaskPriority b) { return a < b; }));
 }
@@ -0,0 +1,119 @@
+#include "stx/vec_deque.h"
+
+#include <string>
+
+#include "stx/rc.h"
+#include "gtest/gtest.h"
+
+using namespace stx;
+
+TEST(VecDequeTest, PushPop)
+{
+  VecDeque<int> deque{os_allocator};
+
+  EXPECT_TRUE(deque.is_empty());
+  EXPECT_EQ(deque.pop_front(), None);
+  EXPECT_EQ(deque.pop_back(), None);
+
+  deque.push_back(1).unwrap();
+  deque.push_back(2).unwrap();
+  deque.push_front(0).unwrap();
+  deque.push_front(-1).unwrap();
+
+  EXPECT_EQ(deque.size(), 4);
+  EXPECT_EQ(deque[0], -1);
+  EXPECT_EQ(deque[1], 0);
+  EXPECT_EQ(deque[2], 1);
+  EXPECT_EQ(deque[3], 2);
+
+  EXPECT_EQ(deque.pop_front(), Some(-1));
+  EXPECT_EQ(deque.pop_back(), Some(2));
+  EXPECT_EQ(deque.pop_front(), Some(0));
+  EXPECT_EQ(deque.pop_front(), Some(1));
+  EXPECT_EQ(deque.pop_front(), None);
+}
+
+TEST(VecDequeTest, Capacity)
+{
+  VecDeque<int> deque = vec::make_deque<int>(os_allocator, 5).unwrap();
+
+  EXPECT_EQ(deque.capacity(), 8);
+
+  for (int i = 0; i < 9; i++)
+  {
+    deque.push_back(int{i}).unwrap();
+  }
+
+  EXPECT_EQ(deque.capacity(), 16);
+
+  // the ring indices are masked, so the capacity must be a power of two
+  EXPECT_DEATH_IF_SUPPORTED((VecDeque<int>{Memory{os_allocator, nullptr}, 6}), ".*");
+  EXPECT_EQ((VecDeque<int>{Memory{os_allocator, nullptr}, 0}).capacity(), 0);
+}
+
+TEST(VecDequeTest, WrapAroundAndGrowth)
+{
+  VecDeque<int> deque{os_allocator};
+
+  for (int i = 0; i < 8; i++)
+  {
+    deque.push_back(int{i}).unwrap();
+  }
+
+  // move the head towards the end so the elements wrap around
+  for (int i = 0; i < 6; i++)
+  {
+    EXPECT_EQ(deque.pop_front(), Some(int{i}));
+    deque.push_back(int{i + 8}).unwrap();
+  }
+
+  EXPECT_EQ(deque.capacity(), 8);
+
+  auto [first, second] = deque.as_spans();
+  EXPECT_EQ(first.size() + second.size(), 8);
+  EXPECT_FALSE(second.is_empty());
+
+  deque.push_back(14).unwrap();
+
+  EXPECT_EQ(deque.capacity(), 16);
+
+  for (int i = 0; i < 9; i++)
+  {
+    EXPECT_EQ(deque[i], i + 6);
+  }
+}
+
+TEST(VecDequeTest, NonTrivial)
+{
+  VecDeque<std::string> deque{os_allocator};
+
+  for (int i = 0; i < 20; i++)
+  {
+    deque.push_front(std::to_string(i)).unwrap();
+    deque.push_back(std::to_string(i)).unwrap();
+  }
+
+  EXPECT_EQ(deque.size(), 40);
+  EXPECT_EQ(deque.front().unwrap().get(), "19");
+  EXPECT_EQ(deque.back().unwrap().get(), "19");
+  EXPECT_EQ(deque.pop_front().unwrap(), "19");
+  EXPECT_EQ(deque.pop_back().unwrap(), "19");
+
+  VecDeque<Rc<int *>> rcs{os_allocator};
+
+  for (int i = 0; i < 20; i++)
+  {
+    rcs.push_front(rc::make(os_allocator, int{i}).unwrap()).unwrap();
+  }
+
+  EXPECT_EQ(*rcs[0], 19);
+  EXPECT_EQ(*rcs[19], 0);
+}
+
+TEST(VecDequeTest, Noop)
+{
+  VecDeque<int> deque{noop_allocator};
+
+  EXPECT_TRUE(deque.push_back(1).is_err());
+  EXPECT_TRUE(deque.push_front(1).is_err());
+}
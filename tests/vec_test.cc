@@ -2,6 +2,7 @@
 
 #include "stx/vec.h"
 
+#include "stx/rc.h"
 #include "gtest/gtest.h"
 
 using stx::Vec;
@@ -338,4 +339,54 @@ TEST(VecTest, MakeInitList)
   stx::Vec<int> b{stx::os_allocator};
 
   EXPECT_EQ(b.pop(), stx::None);
-}
\ No newline at end of file
+}
+
+static_assert(stx::is_trivially_relocatable<int>);
+static_assert(stx::is_trivially_relocatable<stx::Rc<int *>>);
+static_assert(stx::is_trivially_relocatable<stx::Vec<Life>>);
+static_assert(!stx::is_trivially_relocatable<Life>);
+
+TEST(VecTest, EraseLifetime)
+{
+  int64_t const initial = Life::add(0);
+
+  {
+    Vec<Life> vec{stx::os_allocator};
+    vec.resize(10).unwrap();
+
+    vec.erase(vec.span().slice(2, 3));
+
+    EXPECT_EQ(vec.size(), 7);
+    EXPECT_EQ(Life::add(0) - initial, 7);
+
+    vec.erase(vec.span().slice(0, 1));
+
+    EXPECT_EQ(vec.size(), 6);
+    EXPECT_EQ(Life::add(0) - initial, 6);
+
+    EXPECT_TRUE(vec.pop().is_some());
+    EXPECT_EQ(Life::add(0) - initial, 5);
+  }
+
+  EXPECT_EQ(Life::add(0), initial);
+}
+
+TEST(VecTest, Relocation)
+{
+  Vec<stx::Rc<int *>> vec{stx::os_allocator};
+
+  for (int i = 0; i < 100; i++)
+  {
+    vec.push(stx::rc::make(stx::os_allocator, int{i}).unwrap()).unwrap();
+  }
+
+  vec.erase(vec.span().slice(10, 20));
+
+  EXPECT_EQ(vec.size(), 80);
+  EXPECT_EQ(*vec[9], 9);
+  EXPECT_EQ(*vec[10], 30);
+  EXPECT_EQ(*vec[79], 99);
+
+  EXPECT_EQ(*vec.pop().unwrap(), 99);
+  EXPECT_EQ(vec.size(), 79);
+}